@@ -0,0 +1,553 @@
+/**
+ * @file prt7_bench.cpp
+ * @brief Microbenchmarks y macrobenchmarks del decodificador PRT-7
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Mide el rotor, la lista de carga, el parser (por línea y por lotes) y el
+ * bucle de decodificación completo sobre flujos sintéticos generados con una semilla fija, de modo
+ * que dos ejecuciones con los mismos parámetros miden exactamente el mismo
+ * trabajo. Para cada prueba se reporta el mejor de varios intentos en
+ * ns/operación, operaciones/s y asignaciones/operación (contadas
+ * reemplazando operator new en este ejecutable).
+ *
+ * Uso: prt7_bench [--tramas N] [--map P] [--bulk P] [--repeticiones R]
+ *                 [--semilla S] [--binario] [--filtro TEXTO] [--json]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "ArenaDeTramas.h"
+#include "FormatoBinario.h"
+#include "AnalizadorPorLotes.h"
+#include "Bitacora.h"
+
+// ---------------------------------------------------------------------------
+// Conteo de asignaciones
+// ---------------------------------------------------------------------------
+
+namespace {
+
+/// Llamadas a operator new desde el inicio del programa
+std::atomic<long long> asignaciones(0);
+
+} // namespace
+
+void* operator new(size_t n) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t n) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Parámetros y flujo sintético
+// ---------------------------------------------------------------------------
+
+/**
+ * @struct ParametrosBench
+ * @brief Configuración de la ejecución
+ */
+struct ParametrosBench {
+    int tramas;              ///< Tramas del flujo sintético
+    double proporcionMap;    ///< Fracción de tramas MAP
+    double proporcionBulk;   ///< Fracción de tramas BULK
+    int repeticiones;        ///< Intentos por prueba (se reporta el mejor)
+    unsigned int semilla;    ///< Semilla del generador
+    bool binario;            ///< Generar tramas binarias en lugar de texto
+    const char* filtro;      ///< Solo las pruebas cuyo nombre contenga este texto
+    bool json;               ///< Salida JSON en lugar de tabla
+
+    ParametrosBench()
+        : tramas(1000000), proporcionMap(0.1), proporcionBulk(0.0), repeticiones(5),
+          semilla(12345), binario(false), filtro(nullptr), json(false) {}
+};
+
+/**
+ * @brief Generador congruencial lineal (reproducible en cualquier plataforma)
+ */
+class GeneradorSintetico {
+private:
+    unsigned long long estado;
+
+public:
+    explicit GeneradorSintetico(unsigned int semilla) : estado(semilla * 2654435761ULL + 1) {}
+
+    /// Entero pseudoaleatorio de 32 bits
+    unsigned int siguiente() {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<unsigned int>(estado >> 33);
+    }
+
+    /// Real pseudoaleatorio en [0, 1)
+    double real() { return siguiente() / 2147483648.0; }
+
+    /// Entero pseudoaleatorio en [minimo, maximo]
+    int rango(int minimo, int maximo) {
+        return minimo + static_cast<int>(siguiente() % static_cast<unsigned int>(maximo - minimo + 1));
+    }
+};
+
+/**
+ * @struct FlujoSintetico
+ * @brief Tramas generadas en memoria, listas para parsear
+ */
+struct FlujoSintetico {
+    char* datos;            ///< Bytes de todas las tramas
+    VistaLinea* lineas;     ///< Vista de cada trama dentro de 'datos'
+    int cantidad;           ///< Número de tramas
+    long long bytes;        ///< Bytes totales
+    char* captura;          ///< Las mismas tramas como una captura (texto terminado en '\n')
+    long long bytesCaptura; ///< Bytes de 'captura'
+
+    FlujoSintetico() : datos(nullptr), lineas(nullptr), cantidad(0), bytes(0), captura(nullptr), bytesCaptura(0) {}
+    ~FlujoSintetico() {
+        delete[] datos;
+        delete[] lineas;
+        delete[] captura;
+    }
+};
+
+/**
+ * @brief Genera el flujo sintético según los parámetros
+ */
+void generarFlujo(const ParametrosBench& p, FlujoSintetico* flujo) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    const int MAX_BULK = 32;
+
+    // Peor caso por trama: BULK de texto "B," + 32 caracteres
+    flujo->datos = new char[static_cast<size_t>(p.tramas) * (MAX_BULK + 8)];
+    flujo->lineas = new VistaLinea[p.tramas];
+    flujo->cantidad = p.tramas;
+
+    GeneradorSintetico generador(p.semilla);
+    char linea[MAX_BULK + 8];
+    char* escritura = flujo->datos;
+
+    for (int i = 0; i < p.tramas; ++i) {
+        double r = generador.real();
+        int n;
+
+        if (r < p.proporcionMap) {
+            n = sprintf(linea, "M,%d", generador.rango(-25, 25));
+        } else if (r < p.proporcionMap + p.proporcionBulk) {
+            int largo = generador.rango(1, MAX_BULK);
+            linea[0] = 'B';
+            linea[1] = ',';
+            for (int j = 0; j < largo; ++j) {
+                linea[2 + j] = alfabeto[generador.siguiente() % 27];
+            }
+            n = 2 + largo;
+        } else {
+            n = sprintf(linea, "L,%c", alfabeto[generador.siguiente() % 27]);
+        }
+
+        if (p.binario) {
+            n = codificarLineaBinaria(linea, n, reinterpret_cast<unsigned char*>(escritura));
+        } else {
+            memcpy(escritura, linea, n);
+        }
+
+        flujo->lineas[i].datos = escritura;
+        flujo->lineas[i].longitud = n;
+        escritura += n;
+    }
+
+    flujo->bytes = escritura - flujo->datos;
+
+    // Captura equivalente, tal como la leería una reproducción
+    flujo->captura = new char[flujo->bytes + flujo->cantidad];
+    char* destino = flujo->captura;
+    for (int i = 0; i < flujo->cantidad; ++i) {
+        memcpy(destino, flujo->lineas[i].datos, flujo->lineas[i].longitud);
+        destino += flujo->lineas[i].longitud;
+        if (!p.binario) {
+            *destino++ = '\n';
+        }
+    }
+    flujo->bytesCaptura = destino - flujo->captura;
+}
+
+// ---------------------------------------------------------------------------
+// Medición
+// ---------------------------------------------------------------------------
+
+/**
+ * @struct ResultadoBench
+ * @brief Mejor medición de una prueba
+ */
+struct ResultadoBench {
+    const char* nombre;           ///< Nombre de la prueba
+    const char* unidad;           ///< Qué cuenta como operación
+    long long operaciones;        ///< Operaciones por intento
+    double nsPorOperacion;        ///< Mejor tiempo por operación
+    double asignacionesPorOp;     ///< Llamadas a operator new por operación
+};
+
+/// Sumidero para que el compilador no elimine los cálculos medidos
+volatile unsigned int sumidero = 0;
+
+/**
+ * @brief Firma de una prueba: ejecuta el trabajo una vez y devuelve las operaciones realizadas
+ */
+typedef long long (*FuncionBench)(const FlujoSintetico& flujo);
+
+long long benchRotorRotar(const FlujoSintetico& flujo) {
+    RotorDeMapeo rotor;
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        rotor.rotar((i % 51) - 25);
+    }
+    sumidero += static_cast<unsigned int>(rotor.obtenerDesplazamiento());
+    return flujo.cantidad;
+}
+
+long long benchRotorGetMapeo(const FlujoSintetico& flujo) {
+    RotorDeMapeo rotor;
+    rotor.rotar(7);
+    unsigned int acumulado = 0;
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        acumulado += static_cast<unsigned char>(rotor.getMapeo(flujo.lineas[i].datos[flujo.lineas[i].longitud - 1]));
+    }
+    sumidero += acumulado;
+    return flujo.cantidad;
+}
+
+long long benchRotorMapearBloque(const FlujoSintetico& flujo) {
+    RotorDeMapeo rotor;
+    rotor.rotar(7);
+    const int TAM_BLOQUE = 4096;
+    char salida[TAM_BLOQUE];
+
+    for (long long i = 0; i < flujo.bytes; i += TAM_BLOQUE) {
+        long long n = flujo.bytes - i < TAM_BLOQUE ? flujo.bytes - i : TAM_BLOQUE;
+        rotor.mapearBloque(flujo.datos + i, salida, static_cast<size_t>(n));
+        sumidero += static_cast<unsigned char>(salida[0]);
+    }
+    return flujo.bytes;
+}
+
+long long benchListaInsertarAlFinal(const FlujoSintetico& flujo) {
+    ListaDeCarga lista;
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        lista.insertarAlFinal(flujo.lineas[i].datos[0]);
+    }
+    sumidero += static_cast<unsigned int>(lista.obtenerTamanio());
+    return flujo.cantidad;
+}
+
+long long benchListaInsertarBloque(const FlujoSintetico& flujo) {
+    ListaDeCarga lista;
+    const int TAM_BLOQUE = 64;
+    for (long long i = 0; i + TAM_BLOQUE <= flujo.bytes; i += TAM_BLOQUE) {
+        lista.insertarBloque(flujo.datos + i, TAM_BLOQUE);
+    }
+    sumidero += static_cast<unsigned int>(lista.obtenerTamanio());
+    return lista.obtenerTamanio();
+}
+
+long long benchRegistroParsear(const FlujoSintetico& flujo) {
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ArenaDeTramas arena;
+
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        arena.reiniciar();
+        TramaBase* trama = registro.parsear(flujo.lineas[i].datos, flujo.lineas[i].longitud, &arena);
+        if (trama) {
+            sumidero += static_cast<unsigned int>(trama->obtenerRotacion());
+            arena.destruir(trama);
+        }
+    }
+    return flujo.cantidad;
+}
+
+long long benchRegistroCaptura(const FlujoSintetico& flujo) {
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ArenaDeTramas arena;
+    VistaLinea linea;
+    long long tramas = 0;
+
+    // Delimitar y parsear línea por línea, como la reproducción
+    for (long long p = 0; p < flujo.bytesCaptura; ) {
+        p += delimitarTrama(flujo.captura + p, static_cast<size_t>(flujo.bytesCaptura - p), &linea);
+        if (linea.longitud == 0) continue;
+
+        arena.reiniciar();
+        TramaBase* trama = registro.parsear(linea.datos, linea.longitud, &arena);
+        if (trama) {
+            sumidero += static_cast<unsigned int>(trama->obtenerRotacion());
+            arena.destruir(trama);
+        }
+        tramas++;
+    }
+    return tramas;
+}
+
+long long benchAnalizadorPorLotes(const FlujoSintetico& flujo) {
+    AnalizadorPorLotes analizador;
+    const TramaCompacta* tramas = analizador.obtenerTramas();
+    unsigned int acumulado = 0;
+    long long total = 0;
+
+    for (long long p = 0; p < flujo.bytesCaptura; ) {
+        size_t consumidos;
+        int n = analizador.analizar(flujo.captura + p, static_cast<size_t>(flujo.bytesCaptura - p), &consumidos);
+        for (int i = 0; i < n; ++i) {
+            acumulado += static_cast<unsigned int>(tramas[i].valor);
+        }
+        p += static_cast<long long>(consumidos);
+        total += n;
+    }
+    sumidero += acumulado;
+    return total;
+}
+
+long long benchDecodificacionCompleta(const FlujoSintetico& flujo) {
+    ListaDeCarga carga;
+    RotorDeMapeo rotor;
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(&carga, &rotor, &registro, false);
+
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        procesador.procesarLinea(flujo.lineas[i].datos, flujo.lineas[i].longitud);
+    }
+    procesador.vaciarPendientes();
+
+    sumidero += static_cast<unsigned int>(carga.obtenerTamanio());
+    return flujo.cantidad;
+}
+
+long long benchDecodificacionBitacora(const FlujoSintetico& flujo) {
+    ListaDeCarga carga;
+    RotorDeMapeo rotor;
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(&carga, &rotor, &registro, false);
+
+    // Sin hilo escritor y con lugar para todo el flujo: solo el costo del
+    // productor, con el instante de llegada ya marcado como lo hace el puerto
+    Bitacora bitacora(BITACORA_TRAMA, flujo.cantidad);
+    procesador.establecerBitacora(&bitacora);
+    long long llegada = relojNs();
+
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        procesador.procesarLinea(flujo.lineas[i].datos, flujo.lineas[i].longitud, llegada);
+    }
+    procesador.vaciarPendientes();
+
+    sumidero += static_cast<unsigned int>(carga.obtenerTamanio() + bitacora.obtenerDescartados());
+    return flujo.cantidad;
+}
+
+/**
+ * @brief Ejecuta una prueba varias veces y se queda con el mejor intento
+ */
+ResultadoBench medir(const char* nombre, const char* unidad, FuncionBench funcion,
+                     const FlujoSintetico& flujo, int repeticiones) {
+    ResultadoBench resultado;
+    resultado.nombre = nombre;
+    resultado.unidad = unidad;
+    resultado.operaciones = 0;
+    resultado.nsPorOperacion = 0.0;
+    resultado.asignacionesPorOp = 0.0;
+
+    // Un intento de calentamiento (cachés, páginas, selección de kernel SIMD)
+    funcion(flujo);
+
+    for (int r = 0; r < repeticiones; ++r) {
+        long long antes = asignaciones.load(std::memory_order_relaxed);
+        std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+        long long operaciones = funcion(flujo);
+
+        std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+        long long asignadas = asignaciones.load(std::memory_order_relaxed) - antes;
+
+        double ns = std::chrono::duration<double, std::nano>(fin - inicio).count();
+        double nsPorOperacion = operaciones > 0 ? ns / operaciones : 0.0;
+        if (r == 0 || nsPorOperacion < resultado.nsPorOperacion) {
+            resultado.nsPorOperacion = nsPorOperacion;
+        }
+        resultado.operaciones = operaciones;
+        resultado.asignacionesPorOp = operaciones > 0 ? static_cast<double>(asignadas) / operaciones : 0.0;
+    }
+
+    return resultado;
+}
+
+// ---------------------------------------------------------------------------
+// Línea de comandos y reporte
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Imprime el uso de la herramienta
+ */
+void imprimirUso(const char* programa) {
+    printf("Uso: %s [opciones]\n", programa);
+    printf("\n");
+    printf("  --tramas N         Tramas del flujo sintético (1000000 por defecto)\n");
+    printf("  --map P            Fracción de tramas MAP, 0 a 1 (0.1 por defecto)\n");
+    printf("  --bulk P           Fracción de tramas BULK, 0 a 1 (0 por defecto)\n");
+    printf("  --repeticiones R   Intentos por prueba; se reporta el mejor (5 por defecto)\n");
+    printf("  --semilla S        Semilla del generador (12345 por defecto)\n");
+    printf("  --binario          Generar tramas binarias en lugar de texto\n");
+    printf("  --filtro TEXTO     Ejecutar solo las pruebas cuyo nombre contenga TEXTO\n");
+    printf("  --json             Salida JSON para seguimiento de regresiones\n");
+}
+
+/**
+ * @brief Interpreta los argumentos
+ * @return 0 para continuar, 1 si hubo error, 2 si se pidió la ayuda
+ */
+int parsearArgumentos(int argc, char* argv[], ParametrosBench* p) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool conValor = i + 1 < argc;
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--ayuda") == 0) return 2;
+        else if (strcmp(arg, "--binario") == 0) p->binario = true;
+        else if (strcmp(arg, "--json") == 0) p->json = true;
+        else if (strcmp(arg, "--tramas") == 0 && conValor) p->tramas = atoi(argv[++i]);
+        else if (strcmp(arg, "--map") == 0 && conValor) p->proporcionMap = atof(argv[++i]);
+        else if (strcmp(arg, "--bulk") == 0 && conValor) p->proporcionBulk = atof(argv[++i]);
+        else if (strcmp(arg, "--repeticiones") == 0 && conValor) p->repeticiones = atoi(argv[++i]);
+        else if (strcmp(arg, "--semilla") == 0 && conValor) p->semilla = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(arg, "--filtro") == 0 && conValor) p->filtro = argv[++i];
+        else {
+            fprintf(stderr, "Error: Opción desconocida o sin valor: %s\n", arg);
+            return 1;
+        }
+    }
+
+    if (p->tramas < 1 || p->repeticiones < 1 ||
+        p->proporcionMap < 0.0 || p->proporcionBulk < 0.0 ||
+        p->proporcionMap + p->proporcionBulk > 1.0) {
+        fprintf(stderr, "Error: Parámetros fuera de rango\n");
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Imprime los resultados como tabla
+ */
+void imprimirTabla(const ParametrosBench& p, const FlujoSintetico& flujo,
+                   const ResultadoBench* resultados, int cantidad) {
+    printf("Flujo sintético: %d tramas %s (MAP %.2f, BULK %.2f), %lld bytes, semilla %u, mejor de %d\n\n",
+           p.tramas, p.binario ? "binarias" : "de texto", p.proporcionMap, p.proporcionBulk,
+           flujo.bytes, p.semilla, p.repeticiones);
+    printf("%-28s %-10s %12s %16s %14s\n", "prueba", "unidad", "ns/op", "op/s", "asign/op");
+
+    for (int i = 0; i < cantidad; ++i) {
+        const ResultadoBench& r = resultados[i];
+        printf("%-28s %-10s %12.2f %16.0f %14.6f\n", r.nombre, r.unidad, r.nsPorOperacion,
+               r.nsPorOperacion > 0.0 ? 1e9 / r.nsPorOperacion : 0.0, r.asignacionesPorOp);
+    }
+}
+
+/**
+ * @brief Imprime los resultados como JSON
+ */
+void imprimirJson(const ParametrosBench& p, const FlujoSintetico& flujo,
+                  const ResultadoBench* resultados, int cantidad) {
+    printf("{\n");
+    printf("  \"parametros\": {\"tramas\": %d, \"map\": %.4f, \"bulk\": %.4f, \"binario\": %s, "
+           "\"semilla\": %u, \"repeticiones\": %d, \"bytes\": %lld},\n",
+           p.tramas, p.proporcionMap, p.proporcionBulk, p.binario ? "true" : "false",
+           p.semilla, p.repeticiones, flujo.bytes);
+    printf("  \"resultados\": [\n");
+
+    for (int i = 0; i < cantidad; ++i) {
+        const ResultadoBench& r = resultados[i];
+        printf("    {\"nombre\": \"%s\", \"unidad\": \"%s\", \"operaciones\": %lld, "
+               "\"ns_por_op\": %.3f, \"op_por_s\": %.0f, \"asignaciones_por_op\": %.6f}%s\n",
+               r.nombre, r.unidad, r.operaciones, r.nsPorOperacion,
+               r.nsPorOperacion > 0.0 ? 1e9 / r.nsPorOperacion : 0.0,
+               r.asignacionesPorOp, i + 1 < cantidad ? "," : "");
+    }
+
+    printf("  ]\n");
+    printf("}\n");
+}
+
+/**
+ * @struct PruebaRegistrada
+ * @brief Entrada de la tabla de pruebas
+ */
+struct PruebaRegistrada {
+    const char* nombre;
+    const char* unidad;
+    FuncionBench funcion;
+};
+
+const PruebaRegistrada PRUEBAS[] = {
+    {"rotor_rotar",               "rotacion", benchRotorRotar},
+    {"rotor_getMapeo",            "caracter", benchRotorGetMapeo},
+    {"rotor_mapearBloque",        "byte",     benchRotorMapearBloque},
+    {"lista_insertarAlFinal",     "caracter", benchListaInsertarAlFinal},
+    {"lista_insertarBloque",      "caracter", benchListaInsertarBloque},
+    {"registro_parsear",          "trama",    benchRegistroParsear},
+    {"registro_captura",          "trama",    benchRegistroCaptura},
+    {"analizador_lotes",          "trama",    benchAnalizadorPorLotes},
+    {"decodificacion_completa",   "trama",    benchDecodificacionCompleta},
+    {"decodificacion_bitacora",   "trama",    benchDecodificacionBitacora},
+};
+
+const int NUM_PRUEBAS = sizeof(PRUEBAS) / sizeof(PRUEBAS[0]);
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ParametrosBench parametros;
+    int resultado = parsearArgumentos(argc, argv, &parametros);
+    if (resultado != 0) {
+        imprimirUso(argv[0]);
+        return resultado == 2 ? 0 : 1;
+    }
+
+    FlujoSintetico flujo;
+    generarFlujo(parametros, &flujo);
+
+    ResultadoBench resultados[NUM_PRUEBAS];
+    int cantidad = 0;
+
+    for (int i = 0; i < NUM_PRUEBAS; ++i) {
+        if (parametros.filtro && !strstr(PRUEBAS[i].nombre, parametros.filtro)) {
+            continue;
+        }
+        resultados[cantidad++] = medir(PRUEBAS[i].nombre, PRUEBAS[i].unidad, PRUEBAS[i].funcion,
+                                       flujo, parametros.repeticiones);
+    }
+
+    if (parametros.json) {
+        imprimirJson(parametros, flujo, resultados, cantidad);
+    } else {
+        imprimirTabla(parametros, flujo, resultados, cantidad);
+    }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file prt7_convertir.cpp
+ * @brief Conversión de capturas PRT-7 entre el formato de texto y el binario
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ * 
+ * Uso: prt7_convertir --a-binario|--a-texto ENTRADA SALIDA
+ * 
+ * Las líneas inválidas se copian sin cambios al convertir a binario, de modo
+ * que el decodificador cuenta las mismas tramas inválidas en ambas
+ * versiones. Las tramas binarias que no pueden escribirse como una línea de
+ * texto (carga con '\r' o '\n') o que son inválidas se descartan y se
+ * cuentan.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "ArchivoMapeado.h"
+#include "FormatoBinario.h"
+
+namespace {
+
+/**
+ * @brief Imprime el uso de la herramienta
+ * @param programa Nombre del ejecutable (argv[0])
+ */
+void imprimirUso(const char* programa) {
+    printf("Uso: %s --a-binario|--a-texto ENTRADA SALIDA\n", programa);
+    printf("\n");
+    printf("  --a-binario   Convertir líneas L,X / M,N / B,TEXTO / S,I / R,I,N / FIN a tramas binarias\n");
+    printf("  --a-texto     Convertir tramas binarias a líneas de texto\n");
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 4 || (strcmp(argv[1], "--a-binario") != 0 && strcmp(argv[1], "--a-texto") != 0)) {
+        imprimirUso(argv[0]);
+        return argc == 2 && (strcmp(argv[1], "-h") == 0 || strcmp(argv[1], "--ayuda") == 0) ? 0 : 1;
+    }
+    
+    bool aBinario = strcmp(argv[1], "--a-binario") == 0;
+    
+    ArchivoMapeado entrada;
+    if (!entrada.abrir(argv[2])) {
+        return 1;
+    }
+    
+    FILE* salida = fopen(argv[3], "wb");
+    if (!salida) {
+        fprintf(stderr, "Error: No se pudo crear %s\n", argv[3]);
+        return 1;
+    }
+    
+    // Buffer de conversión; crece si aparece una línea más larga
+    int capacidad = 2 * MAX_TRAMA_BINARIA;
+    unsigned char* buffer = new unsigned char[capacidad];
+    
+    long long convertidas = 0;
+    long long copiadas = 0;
+    long long descartadas = 0;
+    unsigned long long bytesSalida = 0;
+    
+    const char* datos = entrada.obtenerDatos();
+    size_t tamanio = entrada.obtenerTamanio();
+    size_t posicion = 0;
+    VistaLinea trama;
+    
+    while (posicion < tamanio) {
+        posicion += delimitarTrama(datos + posicion, tamanio - posicion, &trama);
+        if (trama.longitud == 0) continue;
+        
+        // Peor caso: la trama más una cabecera BULK por cada tramo de carga
+        int necesario = trama.longitud + (trama.longitud / MAX_CARGA_BULK_BINARIA + 1) * MAX_TRAMA_BINARIA;
+        if (necesario > capacidad) {
+            delete[] buffer;
+            capacidad = necesario;
+            buffer = new unsigned char[capacidad];
+        }
+        
+        bool binaria = esTramaBinaria(static_cast<unsigned char>(trama.datos[0]));
+        int n = 0;
+        
+        if (aBinario) {
+            if (binaria) {
+                // Ya está en binario
+                memcpy(buffer, trama.datos, trama.longitud);
+                n = trama.longitud;
+                copiadas++;
+            } else {
+                n = codificarLineaBinaria(trama.datos, trama.longitud, buffer);
+                if (n > 0) {
+                    convertidas++;
+                } else {
+                    // Línea inválida: conservarla tal cual
+                    memcpy(buffer, trama.datos, trama.longitud);
+                    buffer[trama.longitud] = '\n';
+                    n = trama.longitud + 1;
+                    copiadas++;
+                }
+            }
+        } else {
+            if (binaria) {
+                n = decodificarTramaATexto(trama.datos, trama.longitud, reinterpret_cast<char*>(buffer));
+                if (n == 0) {
+                    descartadas++;
+                    continue;
+                }
+                convertidas++;
+            } else {
+                memcpy(buffer, trama.datos, trama.longitud);
+                n = trama.longitud;
+                copiadas++;
+            }
+            buffer[n++] = '\n';
+        }
+        
+        if (fwrite(buffer, 1, n, salida) != static_cast<size_t>(n)) {
+            fprintf(stderr, "Error: No se pudo escribir en %s\n", argv[3]);
+            delete[] buffer;
+            fclose(salida);
+            return 1;
+        }
+        bytesSalida += n;
+    }
+    
+    delete[] buffer;
+    fclose(salida);
+    
+    fprintf(stderr, "Tramas convertidas: %lld, copiadas sin cambios: %lld, descartadas: %lld\n",
+            convertidas, copiadas, descartadas);
+    fprintf(stderr, "Tamaño: %llu -> %llu bytes (%.1f%%)\n",
+            static_cast<unsigned long long>(tamanio), bytesSalida,
+            tamanio > 0 ? 100.0 * bytesSalida / tamanio : 0.0);
+    return 0;
+}
@@ -0,0 +1,449 @@
+/**
+ * @file prt7_generador.cpp
+ * @brief Generador de tráfico PRT-7 sobre un pseudo-terminal (sustituye al Arduino)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Abre un par pty, imprime el nombre del lado esclavo y emite tramas PRT-7
+ * por el lado maestro. El decodificador se conecta al esclavo sin cambios,
+ * igual que a /dev/ttyUSB0, lo que permite pruebas de carga y de duración
+ * sin hardware.
+ *
+ * Los mensajes son aleatorios y se codifican con el rotor real: cada
+ * carácter se envía ya cifrado con la rotación vigente, de modo que el
+ * decodificador debe reconstruir exactamente el texto original. Con
+ * --esperado se guarda ese texto para compararlo.
+ *
+ * Uso: prt7_generador [opciones]   (ver --ayuda)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <chrono>
+#include <thread>
+#include "RotorDeMapeo.h"
+#include "FormatoBinario.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <termios.h>
+#endif
+
+namespace {
+
+/// Caracteres con los que se generan los mensajes
+const char* const ALFABETO_MENSAJE = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+
+/// Líneas inválidas que se inyectan (formatos que el parser debe rechazar)
+const char* const LINEAS_INVALIDAS[] = {
+    "X,1", "L", "M,", "LA", "L;A", "Q,Q,Q", ",,", "M5", "#basura#"
+};
+const int NUM_LINEAS_INVALIDAS = sizeof(LINEAS_INVALIDAS) / sizeof(LINEAS_INVALIDAS[0]);
+
+/// Se pone en true con SIGINT/SIGTERM para terminar de forma ordenada
+volatile sig_atomic_t detener = 0;
+
+void manejarSenal(int) {
+    detener = 1;
+}
+
+/**
+ * @struct ParametrosGenerador
+ * @brief Configuración del tráfico
+ */
+struct ParametrosGenerador {
+    int longitud;            ///< Caracteres por mensaje
+    int mensajes;            ///< Mensajes a enviar (0 = hasta recibir SIGINT)
+    double tasa;             ///< Tramas por segundo (0 = saturar la línea)
+    int rafaga;              ///< Tramas por ráfaga (0 = sin ráfagas)
+    int pausaMs;             ///< Pausa entre ráfagas
+    double densidadMap;      ///< Probabilidad de una trama MAP antes de cada carácter
+    double proporcionBulk;   ///< Probabilidad de enviar un tramo del mensaje como BULK
+    double proporcionInvalidas; ///< Probabilidad de inyectar una línea inválida
+    bool binario;            ///< Tramas binarias en lugar de texto
+    int retardoMs;           ///< Espera inicial para conectar el decodificador
+    int lineasFinales;       ///< Líneas vacías al terminar (el decodificador cierra tras 10)
+    unsigned int semilla;    ///< Semilla del generador
+    const char* esperado;    ///< Archivo donde guardar el texto enviado (nullptr = no guardar)
+
+    ParametrosGenerador()
+        : longitud(64), mensajes(1), tasa(100.0), rafaga(0), pausaMs(0),
+          densidadMap(0.2), proporcionBulk(0.0), proporcionInvalidas(0.0), binario(false),
+          retardoMs(2000), lineasFinales(12), semilla(1), esperado(nullptr) {}
+};
+
+/**
+ * @brief Generador congruencial lineal reproducible
+ */
+class Aleatorio {
+private:
+    unsigned long long estado;
+
+public:
+    explicit Aleatorio(unsigned int semilla) : estado(semilla * 2654435761ULL + 1) {}
+
+    unsigned int siguiente() {
+        estado = estado * 6364136223846793005ULL + 1442695040888963407ULL;
+        return static_cast<unsigned int>(estado >> 33);
+    }
+
+    double real() { return siguiente() / 2147483648.0; }
+
+    int rango(int minimo, int maximo) {
+        return minimo + static_cast<int>(siguiente() % static_cast<unsigned int>(maximo - minimo + 1));
+    }
+};
+
+/**
+ * @class Codificador
+ * @brief Cifra caracteres con el rotor real para que el decodificador los recupere
+ *
+ * Para cada desplazamiento del rotor guarda qué byte de entrada produce
+ * cada carácter de salida (la inversa de RotorDeMapeo::getMapeo()).
+ */
+class Codificador {
+private:
+    char inversa[TAMANIO_ALFABETO][256];  ///< Entrada que produce cada salida
+    int desplazamiento;                   ///< Rotación vigente (0..25)
+
+public:
+    Codificador() : desplazamiento(0) {
+        RotorDeMapeo rotor;
+        for (int d = 0; d < TAMANIO_ALFABETO; ++d) {
+            bool asignado[256] = {false};
+            for (int x = 0; x < 256; ++x) {
+                unsigned char y = static_cast<unsigned char>(rotor.getMapeo(static_cast<char>(x)));
+                if (!asignado[y]) {
+                    inversa[d][y] = static_cast<char>(x);
+                    asignado[y] = true;
+                }
+            }
+            for (int y = 0; y < 256; ++y) {
+                if (!asignado[y]) inversa[d][y] = static_cast<char>(y);
+            }
+            rotor.rotar(1);
+        }
+    }
+
+    /// Aplica una rotación igual que RotorDeMapeo::rotar()
+    void rotar(int n) {
+        n %= TAMANIO_ALFABETO;
+        if (n < 0) n += TAMANIO_ALFABETO;
+        desplazamiento = (desplazamiento + n) % TAMANIO_ALFABETO;
+    }
+
+    /// Byte que hay que enviar para que se decodifique como 'c'
+    char cifrar(char c) const {
+        return inversa[desplazamiento][static_cast<unsigned char>(c)];
+    }
+};
+
+/**
+ * @class EmisorDeTramas
+ * @brief Escribe tramas en el pty respetando la tasa y las ráfagas
+ */
+class EmisorDeTramas {
+private:
+    int descriptor;
+    const ParametrosGenerador& p;
+    std::chrono::steady_clock::time_point proximaTrama;
+    std::chrono::steady_clock::duration periodo;
+    int enRafaga;
+
+public:
+    long long tramas;
+    long long invalidas;
+    long long bytes;
+
+    EmisorDeTramas(int fd, const ParametrosGenerador& parametros)
+        : descriptor(fd), p(parametros), proximaTrama(std::chrono::steady_clock::now()),
+          periodo(std::chrono::steady_clock::duration::zero()), enRafaga(0),
+          tramas(0), invalidas(0), bytes(0) {
+        if (p.tasa > 0.0) {
+            periodo = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(1.0 / p.tasa));
+        }
+    }
+
+    /**
+     * @brief Escribe todos los bytes (write() puede escribir menos)
+     * @return false si el pty se cerró
+     */
+    bool escribirTodo(const char* datos, int n) {
+#ifndef _WIN32
+        while (n > 0 && !detener) {
+            ssize_t escritos = write(descriptor, datos, n);
+            if (escritos < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            datos += escritos;
+            n -= static_cast<int>(escritos);
+        }
+        return true;
+#else
+        (void)datos;
+        (void)n;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Espera el turno de la siguiente trama y la envía
+     * @param trama Bytes de la trama (con su salto de línea si es de texto)
+     * @param n Número de bytes
+     * @return false si hay que terminar
+     */
+    bool enviar(const char* trama, int n) {
+        // Pausa entre ráfagas
+        if (p.rafaga > 0 && enRafaga >= p.rafaga) {
+            enRafaga = 0;
+            std::this_thread::sleep_for(std::chrono::milliseconds(p.pausaMs));
+            proximaTrama = std::chrono::steady_clock::now();
+        }
+
+        // Tasa constante (0 = tan rápido como acepte el pty)
+        if (p.tasa > 0.0) {
+            std::this_thread::sleep_until(proximaTrama);
+            proximaTrama += periodo;
+        }
+
+        if (!escribirTodo(trama, n)) return false;
+
+        enRafaga++;
+        tramas++;
+        bytes += n;
+        return !detener;
+    }
+};
+
+/**
+ * @brief Codifica una trama de texto (sin salto de línea) en el formato elegido
+ * @return Bytes escritos en 'destino'
+ */
+int prepararTrama(const ParametrosGenerador& p, const char* linea, int n, char* destino) {
+    if (p.binario) {
+        int escritos = codificarLineaBinaria(linea, n, reinterpret_cast<unsigned char*>(destino));
+        if (escritos > 0) return escritos;
+        // Línea inválida: se envía como texto también en modo binario
+    }
+    memcpy(destino, linea, n);
+    destino[n] = '\n';
+    return n + 1;
+}
+
+/**
+ * @brief Genera, cifra y envía un mensaje aleatorio
+ * @return false si hay que terminar
+ */
+bool enviarMensaje(const ParametrosGenerador& p, Aleatorio& azar, Codificador& codificador,
+                   EmisorDeTramas& emisor, FILE* esperado) {
+    char linea[64];
+    char trama[64 + MAX_TRAMA_BINARIA];
+
+    int i = 0;
+    while (i < p.longitud) {
+        // Línea inválida inyectada (no altera el mensaje)
+        if (azar.real() < p.proporcionInvalidas) {
+            const char* invalida = LINEAS_INVALIDAS[azar.siguiente() % NUM_LINEAS_INVALIDAS];
+            int n = prepararTrama(p, invalida, static_cast<int>(strlen(invalida)), trama);
+            if (!emisor.enviar(trama, n)) return false;
+            emisor.invalidas++;
+        }
+
+        // Rotación del rotor antes del siguiente carácter
+        if (azar.real() < p.densidadMap) {
+            int rotacion = azar.rango(-25, 25);
+            int n = prepararTrama(p, linea, sprintf(linea, "M,%d", rotacion), trama);
+            if (!emisor.enviar(trama, n)) return false;
+            codificador.rotar(rotacion);
+        }
+
+        // Uno o varios caracteres del mensaje
+        int cantidad = 1;
+        if (azar.real() < p.proporcionBulk) {
+            cantidad = azar.rango(2, 16);
+            if (cantidad > p.longitud - i) cantidad = p.longitud - i;
+        }
+
+        char claro[16];
+        for (int j = 0; j < cantidad; ++j) {
+            claro[j] = ALFABETO_MENSAJE[azar.siguiente() % 27];
+        }
+
+        int n;
+        if (cantidad == 1) {
+            linea[0] = 'L';
+            linea[1] = ',';
+            linea[2] = codificador.cifrar(claro[0]);
+            n = 3;
+        } else {
+            linea[0] = 'B';
+            linea[1] = ',';
+            for (int j = 0; j < cantidad; ++j) {
+                linea[2 + j] = codificador.cifrar(claro[j]);
+            }
+            n = 2 + cantidad;
+        }
+
+        n = prepararTrama(p, linea, n, trama);
+        if (!emisor.enviar(trama, n)) return false;
+
+        if (esperado) {
+            fwrite(claro, 1, cantidad, esperado);
+        }
+        i += cantidad;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Imprime el uso de la herramienta
+ */
+void imprimirUso(const char* programa) {
+    printf("Uso: %s [opciones]\n", programa);
+    printf("\n");
+    printf("Mensajes:\n");
+    printf("  --longitud N       Caracteres por mensaje (64 por defecto)\n");
+    printf("  --mensajes N       Mensajes a enviar; 0 = hasta Ctrl+C (1 por defecto)\n");
+    printf("  --map P            Probabilidad de una trama MAP antes de cada carácter (0.2)\n");
+    printf("  --bulk P           Probabilidad de enviar un tramo como BULK (0)\n");
+    printf("  --invalidas P      Probabilidad de inyectar una línea inválida (0)\n");
+    printf("  --binario          Enviar tramas binarias\n");
+    printf("  --semilla S        Semilla del generador (1 por defecto)\n");
+    printf("  --esperado ARCH    Guardar el texto enviado para compararlo\n");
+    printf("\n");
+    printf("Ritmo:\n");
+    printf("  --tasa N           Tramas por segundo; 0 = saturar la línea (100 por defecto)\n");
+    printf("  --rafaga N         Tramas por ráfaga (0 = sin ráfagas)\n");
+    printf("  --pausa MS         Pausa entre ráfagas (0 por defecto)\n");
+    printf("  --retardo MS       Espera antes de empezar, para conectar el decodificador (2000)\n");
+    printf("  --lineas-finales N Líneas vacías al terminar (12 por defecto)\n");
+}
+
+/**
+ * @brief Interpreta los argumentos
+ * @return 0 para continuar, 1 si hubo error, 2 si se pidió la ayuda
+ */
+int parsearArgumentos(int argc, char* argv[], ParametrosGenerador* p) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        bool conValor = i + 1 < argc;
+
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--ayuda") == 0) return 2;
+        else if (strcmp(arg, "--binario") == 0) p->binario = true;
+        else if (strcmp(arg, "--longitud") == 0 && conValor) p->longitud = atoi(argv[++i]);
+        else if (strcmp(arg, "--mensajes") == 0 && conValor) p->mensajes = atoi(argv[++i]);
+        else if (strcmp(arg, "--tasa") == 0 && conValor) p->tasa = atof(argv[++i]);
+        else if (strcmp(arg, "--rafaga") == 0 && conValor) p->rafaga = atoi(argv[++i]);
+        else if (strcmp(arg, "--pausa") == 0 && conValor) p->pausaMs = atoi(argv[++i]);
+        else if (strcmp(arg, "--map") == 0 && conValor) p->densidadMap = atof(argv[++i]);
+        else if (strcmp(arg, "--bulk") == 0 && conValor) p->proporcionBulk = atof(argv[++i]);
+        else if (strcmp(arg, "--invalidas") == 0 && conValor) p->proporcionInvalidas = atof(argv[++i]);
+        else if (strcmp(arg, "--retardo") == 0 && conValor) p->retardoMs = atoi(argv[++i]);
+        else if (strcmp(arg, "--lineas-finales") == 0 && conValor) p->lineasFinales = atoi(argv[++i]);
+        else if (strcmp(arg, "--semilla") == 0 && conValor) p->semilla = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        else if (strcmp(arg, "--esperado") == 0 && conValor) p->esperado = argv[++i];
+        else {
+            fprintf(stderr, "Error: Opción desconocida o sin valor: %s\n", arg);
+            return 1;
+        }
+    }
+
+    if (p->longitud < 1 || p->mensajes < 0 || p->tasa < 0.0 || p->rafaga < 0 || p->pausaMs < 0 ||
+        p->retardoMs < 0 || p->lineasFinales < 0 ||
+        p->densidadMap < 0.0 || p->densidadMap > 1.0 ||
+        p->proporcionBulk < 0.0 || p->proporcionBulk > 1.0 ||
+        p->proporcionInvalidas < 0.0 || p->proporcionInvalidas > 1.0) {
+        fprintf(stderr, "Error: Parámetros fuera de rango\n");
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    ParametrosGenerador parametros;
+    int resultado = parsearArgumentos(argc, argv, &parametros);
+    if (resultado != 0) {
+        imprimirUso(argv[0]);
+        return resultado == 2 ? 0 : 1;
+    }
+
+#ifdef _WIN32
+    fprintf(stderr, "Error: El generador necesita pseudo-terminales POSIX\n");
+    return 1;
+#else
+    // Crear el par pty
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        fprintf(stderr, "Error: No se pudo crear el pseudo-terminal: %s\n", strerror(errno));
+        return 1;
+    }
+    const char* nombreEsclavo = ptsname(maestro);
+
+    // Mantener el esclavo abierto en modo crudo: los bytes no se transforman
+    // y el pty sigue existiendo aunque el decodificador se reconecte
+    int esclavo = open(nombreEsclavo, O_RDWR | O_NOCTTY);
+    if (esclavo < 0) {
+        fprintf(stderr, "Error: No se pudo abrir %s: %s\n", nombreEsclavo, strerror(errno));
+        return 1;
+    }
+    struct termios tio;
+    tcgetattr(esclavo, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(esclavo, TCSANOW, &tio);
+
+    printf("%s\n", nombreEsclavo);
+    fflush(stdout);
+
+    signal(SIGINT, manejarSenal);
+    signal(SIGTERM, manejarSenal);
+
+    FILE* esperado = nullptr;
+    if (parametros.esperado) {
+        esperado = fopen(parametros.esperado, "wb");
+        if (!esperado) {
+            fprintf(stderr, "Error: No se pudo crear %s\n", parametros.esperado);
+            return 1;
+        }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(parametros.retardoMs));
+
+    Aleatorio azar(parametros.semilla);
+    Codificador codificador;
+    EmisorDeTramas emisor(maestro, parametros);
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+
+    for (int m = 0; !detener && (parametros.mensajes == 0 || m < parametros.mensajes); ++m) {
+        if (!enviarMensaje(parametros, azar, codificador, emisor, esperado)) break;
+    }
+
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    // Líneas vacías finales: el decodificador termina tras 10 consecutivas
+    for (int i = 0; i < parametros.lineasFinales; ++i) {
+        emisor.escribirTodo("\n", 1);
+    }
+
+    if (esperado) fclose(esperado);
+
+    fprintf(stderr, "Tramas enviadas: %lld (%lld inválidas), %lld bytes en %.3f s (%.0f tramas/s)\n",
+            emisor.tramas, emisor.invalidas, emisor.bytes, segundos,
+            segundos > 0.0 ? emisor.tramas / segundos : 0.0);
+
+    // Dar tiempo a que el decodificador lea lo pendiente antes de cerrar el pty
+    tcdrain(maestro);
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    close(esclavo);
+    close(maestro);
+    return 0;
+#endif
+}
@@ -0,0 +1,146 @@
+/**
+ * @file AnalizadorPorLotes.h
+ * @brief Parseo de un buffer completo de tramas en una sola pasada
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ANALIZADOR_POR_LOTES_H
+#define ANALIZADOR_POR_LOTES_H
+
+#include "RegistroDeTramas.h"
+#include "Metricas.h"
+#include <cstddef>
+
+/// Tramas que se analizan por llamada a AnalizadorPorLotes::analizar()
+const int CAPACIDAD_LOTE_TRAMAS = 4096;
+
+/**
+ * @enum TipoTramaCompacta
+ * @brief Tipo de una trama ya analizada
+ */
+enum TipoTramaCompacta {
+    COMPACTA_LOAD,       ///< valor = carácter de carga (0..255)
+    COMPACTA_MAP,        ///< valor = rotación
+    COMPACTA_BULK,       ///< valor = longitud de la carga; posicion = inicio de la carga
+    COMPACTA_SELECCION,  ///< valor = índice del rotor
+    COMPACTA_ROTOR,      ///< rotor = índice del rotor; valor = rotación
+    COMPACTA_FIN,        ///< Cierra el mensaje (ver TramaFin)
+    COMPACTA_INVALIDA    ///< rotor = motivo (ContadorMetrica); valor = longitud de la línea
+};
+
+/**
+ * @struct TramaCompacta
+ * @brief Resultado de analizar una trama: 12 bytes, sin punteros ni memoria propia
+ */
+struct TramaCompacta {
+    unsigned char tipo;      ///< TipoTramaCompacta
+    unsigned char rotor;     ///< Índice del rotor (ROTOR) o motivo del rechazo (INVALIDA)
+    unsigned short reservado;
+    int valor;               ///< Dato principal según el tipo
+    unsigned int posicion;   ///< Byte de la trama dentro del buffer (de la carga en BULK)
+};
+
+/**
+ * @class AnalizadorPorLotes
+ * @brief Convierte un buffer de tramas en un arreglo de TramaCompacta
+ * 
+ * RegistroDeTramas::parsear() trabaja línea por línea: alguien tiene que
+ * delimitar cada línea antes, y cada trama se construye como objeto en la
+ * arena para llamarla por métodos virtuales. Para capturas completas eso
+ * cuesta más que el propio efecto de la trama. El analizador recorre el
+ * buffer una sola vez, delimitando y clasificando a la vez, con un camino
+ * directo para la trama más común ("L,X" seguida de salto de línea), y
+ * escribe cada trama como un registro de 12 bytes.
+ * 
+ * Acepta lo mismo que un RegistroDeTramas recién construido (los tipos del
+ * protocolo en texto y en binario, y el delimitador de TramaFin), con los
+ * mismos valores: los enteros se convierten con enteroDesdeTexto(), que
+ * satura en lugar de desbordarse. Las líneas rechazadas no se imprimen:
+ * quedan en el arreglo con su posición y se cuentan por motivo. Las líneas
+ * vacías no producen ninguna trama.
+ */
+class AnalizadorPorLotes {
+private:
+    TramaCompacta* tramas;      ///< Tramas del último lote
+    char delimitador[LONGITUD_MAX_DELIMITADOR + 1]; ///< Línea de la trama FIN
+    int longitudDelimitador;    ///< Bytes de 'delimitador'
+    bool caminoDirecto;         ///< El delimitador no se confunde con una línea "L,X"
+    long long invalidas[NUM_CONTADORES_METRICA]; ///< Líneas rechazadas por motivo (acumulado)
+    
+    // No copiable: es dueño del arreglo
+    AnalizadorPorLotes(const AnalizadorPorLotes&);
+    AnalizadorPorLotes& operator=(const AnalizadorPorLotes&);
+    
+    /**
+     * @brief Analiza una línea de texto completa (sin salto de línea)
+     * @param linea Inicio de la línea
+     * @param longitud Bytes de la línea (mayor que 0)
+     * @param trama Registro de destino (posicion ya asignada)
+     */
+    void analizarTexto(const char* linea, int longitud, TramaCompacta* trama);
+    
+    /**
+     * @brief Analiza una trama binaria completa
+     * @param bytes Trama, empezando por la etiqueta
+     * @param longitud Bytes de la trama
+     * @param trama Registro de destino (posicion ya asignada)
+     */
+    void analizarBinaria(const unsigned char* bytes, int longitud, TramaCompacta* trama);
+    
+    /**
+     * @brief Marca una trama como rechazada y la cuenta
+     */
+    void rechazar(TramaCompacta* trama, ContadorMetrica motivo, int longitud) {
+        trama->tipo = COMPACTA_INVALIDA;
+        trama->rotor = static_cast<unsigned char>(motivo);
+        trama->valor = longitud;
+        invalidas[motivo]++;
+    }
+    
+public:
+    /**
+     * @brief Constructor
+     * @param delimitadorFin Línea que cierra un mensaje (como RegistroDeTramas::establecerDelimitador())
+     */
+    explicit AnalizadorPorLotes(const char* delimitadorFin = DELIMITADOR_FIN_DEFECTO);
+    
+    /**
+     * @brief Destructor - Libera el arreglo de tramas
+     */
+    ~AnalizadorPorLotes();
+    
+    /**
+     * @brief Analiza tramas del principio de un buffer
+     * 
+     * Se detiene al llenar CAPACIDAD_LOTE_TRAMAS tramas o al agotar el
+     * buffer. El buffer debe terminar en un límite de trama: una última
+     * línea sin salto de línea, o una trama binaria truncada, se toman tal
+     * como están (igual que delimitarTrama()).
+     * 
+     * @param datos Inicio del buffer (hasta 4 GB: las posiciones son de 32 bits)
+     * @param disponibles Bytes del buffer
+     * @param consumidos Variable donde se devuelven los bytes analizados
+     * @return Número de tramas escritas en obtenerTramas()
+     */
+    int analizar(const char* datos, size_t disponibles, size_t* consumidos);
+    
+    /**
+     * @brief Obtiene las tramas del último analizar()
+     * @return Arreglo de CAPACIDAD_LOTE_TRAMAS registros; posicion es relativa a 'datos'
+     */
+    const TramaCompacta* obtenerTramas() const { return tramas; }
+    
+    /**
+     * @brief Obtiene las líneas rechazadas por un motivo desde la construcción
+     * @param motivo CONTADOR_INVALIDA_CORTA, _SIN_COMA, _TIPO o _DATO
+     */
+    long long obtenerInvalidas(ContadorMetrica motivo) const { return invalidas[motivo]; }
+    
+    /**
+     * @brief Suma las líneas rechazadas a Metricas y reinicia los contadores
+     */
+    void publicarInvalidas();
+};
+
+#endif // ANALIZADOR_POR_LOTES_H
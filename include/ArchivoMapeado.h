@@ -0,0 +1,71 @@
+/**
+ * @file ArchivoMapeado.h
+ * @brief Acceso de solo lectura a un archivo completo mapeado en memoria
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ARCHIVO_MAPEADO_H
+#define ARCHIVO_MAPEADO_H
+
+#include <cstddef>
+
+/**
+ * @class ArchivoMapeado
+ * @brief Expone el contenido de un archivo como un bloque contiguo de bytes
+ * 
+ * En sistemas POSIX el archivo se proyecta con mmap(), de modo que las
+ * capturas de varios GB se recorren sin copiarlas a buffers intermedios:
+ * el núcleo carga las páginas bajo demanda. En Windows se lee completo a
+ * memoria como respaldo.
+ */
+class ArchivoMapeado {
+private:
+    const char* datos;   ///< Inicio del contenido (nullptr si no hay archivo)
+    size_t tamanio;      ///< Bytes del archivo
+    bool mapeado;        ///< true si 'datos' viene de mmap() (si no, de new[])
+    
+    // No copiable: es dueño de la proyección
+    ArchivoMapeado(const ArchivoMapeado&);
+    ArchivoMapeado& operator=(const ArchivoMapeado&);
+    
+public:
+    /**
+     * @brief Constructor - Sin archivo abierto
+     */
+    ArchivoMapeado();
+    
+    /**
+     * @brief Destructor - Libera la proyección
+     */
+    ~ArchivoMapeado();
+    
+    /**
+     * @brief Abre y proyecta un archivo completo
+     * 
+     * Los errores se imprimen en stderr.
+     * 
+     * @param ruta Ruta del archivo
+     * @return true si el archivo quedó disponible (un archivo vacío también es válido)
+     */
+    bool abrir(const char* ruta);
+    
+    /**
+     * @brief Libera la proyección actual
+     */
+    void cerrar();
+    
+    /**
+     * @brief Obtiene el contenido del archivo
+     * @return Puntero al primer byte (no terminado en '\0')
+     */
+    const char* obtenerDatos() const { return datos; }
+    
+    /**
+     * @brief Obtiene el tamaño del archivo
+     * @return Número de bytes
+     */
+    size_t obtenerTamanio() const { return tamanio; }
+};
+
+#endif // ARCHIVO_MAPEADO_H
@@ -0,0 +1,97 @@
+/**
+ * @file ArenaDeTramas.h
+ * @brief Arena de memoria para construir tramas sin usar el heap por línea
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ARENA_DE_TRAMAS_H
+#define ARENA_DE_TRAMAS_H
+
+#include <cstddef>  // Para size_t
+#include <new>      // Para placement new
+#include <utility>  // Para std::forward
+
+#include "TramaBase.h"
+
+/// Capacidad por defecto de la arena (bytes)
+const size_t CAPACIDAD_ARENA_DEFECTO = 1024;
+
+/**
+ * @class ArenaDeTramas
+ * @brief Reserva lineal de memoria para objetos TramaBase
+ * 
+ * La arena reserva un único bloque de memoria al construirse. Las tramas se
+ * construyen dentro de ese bloque con placement new, por lo que parsear una
+ * línea no hace ningún new/delete en estado estable. Los objetos se siguen
+ * usando a través de TramaBase* (polimorfismo intacto).
+ * 
+ * Uso típico por línea:
+ * 1. TramaBase* t = arena.crear<TramaLoad>('A');
+ * 2. t->procesar(...);
+ * 3. arena.destruir(t);
+ * 4. arena.reiniciar();
+ */
+class ArenaDeTramas {
+private:
+    unsigned char* memoria; ///< Bloque reservado una sola vez
+    size_t capacidad;       ///< Tamaño del bloque en bytes
+    size_t usado;           ///< Bytes ocupados desde el último reinicio
+    
+    // No copiable: es dueña de su bloque de memoria
+    ArenaDeTramas(const ArenaDeTramas&);
+    ArenaDeTramas& operator=(const ArenaDeTramas&);
+    
+public:
+    /**
+     * @brief Constructor - Reserva el bloque de la arena
+     * @param capacidadBytes Tamaño del bloque en bytes
+     */
+    explicit ArenaDeTramas(size_t capacidadBytes = CAPACIDAD_ARENA_DEFECTO);
+    
+    /**
+     * @brief Destructor - Libera el bloque de la arena
+     * 
+     * Las tramas construidas en la arena deben destruirse antes con destruir().
+     */
+    ~ArenaDeTramas();
+    
+    /**
+     * @brief Reserva memoria alineada dentro de la arena
+     * @param tam Número de bytes
+     * @return Puntero a la memoria, o nullptr si la arena está llena
+     */
+    void* reservar(size_t tam);
+    
+    /**
+     * @brief Construye un objeto dentro de la arena
+     * @param args Argumentos del constructor de T
+     * @return Puntero al objeto, o nullptr si la arena está llena
+     */
+    template <typename T, typename... Args>
+    T* crear(Args&&... args) {
+        void* p = reservar(sizeof(T));
+        return p ? new (p) T(std::forward<Args>(args)...) : nullptr;
+    }
+    
+    /**
+     * @brief Destruye una trama construida en la arena (sin liberar memoria)
+     * @param trama Trama a destruir (puede ser nullptr)
+     */
+    void destruir(TramaBase* trama) {
+        if (trama) trama->~TramaBase();
+    }
+    
+    /**
+     * @brief Marca toda la arena como libre para reutilizarla
+     */
+    void reiniciar() { usado = 0; }
+    
+    /**
+     * @brief Obtiene los bytes ocupados desde el último reinicio
+     * @return Bytes usados
+     */
+    size_t obtenerUsado() const { return usado; }
+};
+
+#endif // ARENA_DE_TRAMAS_H
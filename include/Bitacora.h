@@ -0,0 +1,204 @@
+/**
+ * @file Bitacora.h
+ * @brief Bitácora por niveles con registros binarios y formato en un hilo aparte
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef BITACORA_H
+#define BITACORA_H
+
+#include "ColaSPSC.h"
+#include "EscritorBuffer.h"
+#include "HistogramaLatencia.h"  // Para relojNs()
+#include "Metricas.h"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+/// Registros que caben en la cola de la bitácora por defecto
+const int CAPACIDAD_BITACORA_DEFECTO = 1 << 16;
+
+/// Bytes de la trama que se copian en cada registro
+const int BYTES_TEXTO_BITACORA = 12;
+
+/**
+ * @enum NivelBitacora
+ * @brief Cuánto se anota; cada nivel incluye los anteriores
+ */
+enum NivelBitacora {
+    BITACORA_APAGADA,    ///< Nada (sin costo en el camino de decodificación)
+    BITACORA_RESUMEN,    ///< Mensajes cerrados y totales de cada flujo
+    BITACORA_TRAMA,      ///< Además, cada trama recibida y cada línea rechazada
+    BITACORA_DEPURACION  ///< Además, lotes, volcados, puntos de control y pausas
+};
+
+/**
+ * @enum EventoBitacora
+ * @brief Qué describe un registro (y qué significan 'valor' y 'extra')
+ */
+enum EventoBitacora {
+    EVENTO_CARGA,        ///< Trama LOAD al lote: valor = pendientes en el lote
+    EVENTO_TRAMA,        ///< Otra trama aplicada: valor = desplazamiento del rotor, caracter = cabeza
+    EVENTO_INVALIDA,     ///< Línea rechazada por el parser
+    EVENTO_MENSAJE,      ///< Mensaje cerrado por FIN: valor = mensajes cerrados del sumidero
+    EVENTO_LOTE,         ///< Lote de LOAD decodificado: valor = caracteres
+    EVENTO_VOLCADO,      ///< Mensaje abierto entregado por exceder la ventana: valor = caracteres
+    EVENTO_PUNTO,        ///< Punto de control: valor = 1 si se guardó, extra = tramas procesadas
+    EVENTO_PAUSA,        ///< La fuente no tiene datos: valor = tramas procesadas
+    EVENTO_FIN_FLUJO     ///< Fin del flujo: valor = tramas procesadas, extra = inválidas
+};
+
+/**
+ * @struct RegistroBitacora
+ * @brief Evento anotado: 32 bytes sin punteros, formateados después por el hilo escritor
+ *
+ * En los eventos de trama, 'extra' es la longitud completa de la línea y
+ * 'texto' guarda sus primeros BYTES_TEXTO_BITACORA bytes.
+ */
+struct RegistroBitacora {
+    long long instanteNs;               ///< relojNs() del evento (llegada de la línea en las tramas)
+    int valor;                          ///< Dato principal según el evento
+    int extra;                          ///< Dato secundario según el evento
+    unsigned char evento;               ///< EventoBitacora
+    unsigned char flujo;                ///< Flujo que lo anotó (canal + 1 en -P, 0 con un solo flujo)
+    unsigned char longitudTexto;        ///< Bytes usados de 'texto'
+    char caracter;                      ///< Cabeza del rotor tras la trama (EVENTO_TRAMA)
+    char texto[BYTES_TEXTO_BITACORA];   ///< Principio de la trama
+};
+
+/**
+ * @class Bitacora
+ * @brief Anota eventos del decodificador sin formatear ni escribir en el hilo que los produce
+ *
+ * Imprimir cada trama con printf() en el hilo que lee el puerto cuesta
+ * microsegundos por trama: formatear, y a menudo un write() a una
+ * terminal. Aquí el productor solo llena un RegistroBitacora en una
+ * ColaSPSC: unas pocas copias, sin leer el reloj si la trama ya trae su
+ * instante de llegada (el puerto lo marca una vez por lectura). Un hilo
+ * propio los formatea en un EscritorBuffer y escribe por bloques. Si la
+ * cola está llena el registro se descarta y se cuenta
+ * (CONTADOR_REGISTROS_BITACORA_DESCARTADOS): la bitácora nunca frena la
+ * decodificación.
+ *
+ * La cola admite un solo productor a la vez: los procesadores que
+ * comparten bitácora deben correr en el mismo hilo (como los canales del
+ * multiplexor), o uno después de otro.
+ */
+class Bitacora {
+private:
+    NivelBitacora nivel;                ///< Nivel elegido
+    ColaSPSC<RegistroBitacora> cola;    ///< Registros pendientes de formatear
+    FILE* archivo;                      ///< Destino (stderr o un archivo propio)
+    bool archivoPropio;                 ///< 'archivo' se abrió aquí y se cierra aquí
+    long long inicioNs;                 ///< Origen de los instantes impresos
+    long long descartados;              ///< Registros perdidos por cola llena (solo el productor)
+    std::thread hilo;                   ///< Hilo escritor
+    bool enMarcha;                      ///< Hay un hilo que unir
+
+    // No copiable: es dueña del hilo y del archivo
+    Bitacora(const Bitacora&);
+    Bitacora& operator=(const Bitacora&);
+
+    /**
+     * @brief Bucle del hilo: formatear registros hasta que la cola se cierre y se vacíe
+     */
+    void ejecutar();
+
+    /**
+     * @brief Escribe un registro como una línea de texto
+     */
+    void formatear(const RegistroBitacora& registro, EscritorBuffer* escritor) const;
+
+public:
+    /**
+     * @brief Constructor - Aún no abre el destino ni arranca el hilo (ver iniciar())
+     * @param nivelBitacora Nivel de detalle
+     * @param capacidad Registros de la cola (se redondea a potencia de dos)
+     */
+    explicit Bitacora(NivelBitacora nivelBitacora, int capacidad = CAPACIDAD_BITACORA_DEFECTO);
+
+    /**
+     * @brief Destructor - Escribe los registros pendientes y cierra el destino
+     */
+    ~Bitacora();
+
+    /**
+     * @brief Abre el destino y arranca el hilo escritor
+     * @param ruta Archivo donde anexar la bitácora (nullptr o "-" = stderr)
+     * @return false si no se pudo abrir el archivo
+     */
+    bool iniciar(const char* ruta);
+
+    /**
+     * @brief Escribe los registros pendientes y detiene el hilo
+     *
+     * Después de detener() no deben anotarse más registros.
+     */
+    void detener();
+
+    /**
+     * @brief Indica si un nivel se anota
+     */
+    bool registra(NivelBitacora nivelEvento) const { return nivelEvento <= nivel; }
+
+    /**
+     * @brief Obtiene el nivel elegido
+     */
+    NivelBitacora obtenerNivel() const { return nivel; }
+
+    /**
+     * @brief Anota un evento (solo el hilo productor)
+     *
+     * El llamador comprueba el nivel antes con registra(); aquí ya no se
+     * comprueba.
+     *
+     * @param evento Tipo de evento
+     * @param flujo Flujo que lo produce
+     * @param valor Dato principal (ver EventoBitacora)
+     * @param extra Dato secundario
+     * @param texto Bytes de la trama (puede ser nullptr)
+     * @param longitud Bytes de 'texto' (se copian como mucho BYTES_TEXTO_BITACORA)
+     * @param caracter Cabeza del rotor (EVENTO_TRAMA)
+     * @param instanteNs Instante del evento según relojNs() (0 = leer el reloj);
+     *        para las tramas, el de llegada que ya marcó la fuente
+     */
+    void anotar(EventoBitacora evento, int flujo, int valor, int extra,
+                const char* texto = nullptr, int longitud = 0, char caracter = '\0',
+                long long instanteNs = 0) {
+        RegistroBitacora* registro = cola.reservar();
+        if (!registro) {
+            descartados++;
+            Metricas::sumar(CONTADOR_REGISTROS_BITACORA_DESCARTADOS);
+            return;
+        }
+
+        int copiar = longitud < BYTES_TEXTO_BITACORA ? longitud : BYTES_TEXTO_BITACORA;
+        registro->instanteNs = instanteNs != 0 ? instanteNs : relojNs();
+        registro->valor = valor;
+        registro->extra = extra;
+        registro->evento = static_cast<unsigned char>(evento);
+        registro->flujo = static_cast<unsigned char>(flujo);
+        registro->longitudTexto = static_cast<unsigned char>(copiar);
+        registro->caracter = caracter;
+        if (copiar > 0) {
+            memcpy(registro->texto, texto, copiar);
+        }
+        cola.publicar();
+    }
+
+    /**
+     * @brief Obtiene los registros perdidos por cola llena
+     */
+    long long obtenerDescartados() const { return descartados; }
+};
+
+/**
+ * @brief Convierte el nombre de un nivel (apagada, resumen, trama, depuracion)
+ * @param nombre Nombre del nivel
+ * @param nivel Variable donde se devuelve el nivel
+ * @return false si el nombre no es un nivel
+ */
+bool nivelBitacoraDesdeTexto(const char* nombre, NivelBitacora* nivel);
+
+#endif // BITACORA_H
@@ -0,0 +1,249 @@
+/**
+ * @file ColaSPSC.h
+ * @brief Cola circular acotada sin bloqueos para un productor y un consumidor
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef COLA_SPSC_H
+#define COLA_SPSC_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+/// Capacidad por defecto de una cola (elementos)
+const int CAPACIDAD_COLA_DEFECTO = 4096;
+
+/**
+ * @enum PoliticaDesborde
+ * @brief Qué hace el productor cuando la cola está llena
+ */
+enum PoliticaDesborde {
+    DESBORDE_BLOQUEAR,  ///< Esperar a que el consumidor libere espacio
+    DESBORDE_DESCARTAR  ///< Descartar el elemento y contarlo
+};
+
+/// Intentos en los que una espera solo cede el procesador antes de dormir
+const int INTENTOS_ANTES_DE_DORMIR = 64;
+
+/**
+ * @brief Espera progresiva para un productor frenado por su consumidor
+ * 
+ * Los primeros intentos solo ceden el procesador; después duerme períodos
+ * cortos para no consumir CPU. Sirve cuando el otro hilo está trabajando
+ * (una cola o un anillo llenos): el espacio llega pronto y sin aviso. Una
+ * cola vacía, que puede seguir así indefinidamente, se espera con
+ * ColaSPSC::esperarElementos().
+ * 
+ * @param intentos Contador de intentos consecutivos (se incrementa)
+ */
+inline void esperarCola(int& intentos) {
+    if (intentos < INTENTOS_ANTES_DE_DORMIR) {
+        std::this_thread::yield();
+    } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(intentos < 256 ? 50 : 500));
+    }
+    intentos++;
+}
+
+/**
+ * @class ColaSPSC
+ * @brief Anillo acotado de un solo productor y un solo consumidor
+ * 
+ * El productor solo escribe 'cola' y el consumidor solo escribe 'cabeza',
+ * por lo que basta con operaciones atómicas; el paso de elementos no toma
+ * ningún mutex. Los índices están separados por una línea de caché para
+ * evitar falso compartido. La capacidad se redondea a potencia de dos.
+ * 
+ * Un consumidor que encuentra la cola vacía cede el procesador unos
+ * intentos y después duerme en una variable de condición; el productor
+ * solo toma el mutex para despertarlo si anotó que duerme. Una cola
+ * inactiva no gasta CPU y el traspaso no espera a ningún temporizador.
+ * Con la cola llena el consumidor está trabajando: el productor espera
+ * con esperarCola().
+ * 
+ * @tparam T Tipo de los elementos (se copian por valor)
+ */
+template <typename T>
+class ColaSPSC {
+private:
+    T* elementos;          ///< Almacenamiento del anillo
+    size_t mascara;        ///< Capacidad - 1 (capacidad potencia de dos)
+    
+    // Relleno de una línea de caché entre los índices: sin alignas, para que
+    // la cola pueda crearse con new en C++11 sin alineación extendida
+    char relleno0[64];
+    std::atomic<size_t> cabeza;   ///< Siguiente posición a leer (consumidor)
+    char relleno1[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> cola;     ///< Siguiente posición a escribir (productor)
+    char relleno2[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<bool> cerrada;    ///< El productor terminó
+    
+    std::mutex mutexEspera;               ///< Protege la espera del consumidor dormido
+    std::condition_variable despertar;    ///< Avisa al consumidor dormido
+    std::atomic<bool> consumidorDormido;  ///< El consumidor espera elementos
+    
+    /**
+     * @brief Indica si hay un elemento o la cola se cerró (solo el consumidor)
+     */
+    bool hayNovedades() const {
+        return cola.load(std::memory_order_seq_cst) != cabeza.load(std::memory_order_relaxed) ||
+               cerrada.load(std::memory_order_seq_cst);
+    }
+    
+    /**
+     * @brief Despierta al consumidor si anotó que duerme
+     * 
+     * El índice ya se publicó con orden secuencial: o el consumidor lo ve
+     * al comprobar la cola antes de dormir, o aquí se ve su anotación.
+     */
+    void avisarConsumidor() {
+        if (consumidorDormido.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> bloqueo(mutexEspera);
+            despertar.notify_one();
+        }
+    }
+    
+    // No copiable: es dueña de su almacenamiento
+    ColaSPSC(const ColaSPSC&);
+    ColaSPSC& operator=(const ColaSPSC&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param capacidadMinima Número mínimo de elementos (se redondea a potencia de dos)
+     */
+    explicit ColaSPSC(size_t capacidadMinima)
+        : cabeza(0), cola(0), cerrada(false), consumidorDormido(false) {
+        size_t capacidad = 2;
+        while (capacidad < capacidadMinima) {
+            capacidad <<= 1;
+        }
+        elementos = new T[capacidad];
+        mascara = capacidad - 1;
+    }
+    
+    /**
+     * @brief Destructor - Libera el almacenamiento
+     */
+    ~ColaSPSC() {
+        delete[] elementos;
+    }
+    
+    /**
+     * @brief Intenta encolar un elemento (solo el productor)
+     * @param elemento Elemento a copiar en la cola
+     * @return false si la cola está llena
+     */
+    bool intentarEncolar(const T& elemento) {
+        size_t c = cola.load(std::memory_order_relaxed);
+        if (c - cabeza.load(std::memory_order_acquire) > mascara) {
+            return false;
+        }
+        elementos[c & mascara] = elemento;
+        cola.store(c + 1, std::memory_order_seq_cst);
+        avisarConsumidor();
+        return true;
+    }
+    
+    /**
+     * @brief Obtiene la siguiente posición libre para escribir en sitio (solo el productor)
+     * 
+     * Evita copiar elementos grandes: el productor llena la posición y luego
+     * llama a publicar().
+     * 
+     * @return Puntero a la posición libre, o nullptr si la cola está llena
+     */
+    T* reservar() {
+        size_t c = cola.load(std::memory_order_relaxed);
+        if (c - cabeza.load(std::memory_order_acquire) > mascara) {
+            return nullptr;
+        }
+        return &elementos[c & mascara];
+    }
+    
+    /**
+     * @brief Publica el elemento obtenido con reservar() (solo el productor)
+     */
+    void publicar() {
+        cola.store(cola.load(std::memory_order_relaxed) + 1, std::memory_order_seq_cst);
+        avisarConsumidor();
+    }
+    
+    /**
+     * @brief Obtiene el siguiente elemento sin sacarlo (solo el consumidor)
+     * @return Puntero al elemento, o nullptr si la cola está vacía
+     */
+    T* frente() {
+        size_t h = cabeza.load(std::memory_order_relaxed);
+        if (h == cola.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &elementos[h & mascara];
+    }
+    
+    /**
+     * @brief Libera el elemento obtenido con frente() (solo el consumidor)
+     */
+    void liberar() {
+        cabeza.store(cabeza.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+    
+    /**
+     * @brief Espera a que haya un elemento o la cola se cierre (solo el consumidor)
+     * 
+     * Cede el procesador unos intentos y después duerme hasta que el
+     * productor publique o cierre. Al volver, frente() devuelve un
+     * elemento, o la cola está cerrada y vacía.
+     */
+    void esperarElementos() {
+        for (int intentos = 0; intentos < INTENTOS_ANTES_DE_DORMIR; ++intentos) {
+            if (hayNovedades()) return;
+            std::this_thread::yield();
+        }
+        
+        std::unique_lock<std::mutex> bloqueo(mutexEspera);
+        consumidorDormido.store(true, std::memory_order_seq_cst);
+        while (!hayNovedades()) {
+            despertar.wait(bloqueo);
+        }
+        consumidorDormido.store(false, std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Indica que el productor no encolará más elementos
+     */
+    void cerrar() {
+        cerrada.store(true, std::memory_order_seq_cst);
+        avisarConsumidor();
+    }
+    
+    /**
+     * @brief Verifica si el productor terminó
+     * 
+     * Un consumidor debe seguir leyendo hasta que la cola esté cerrada y vacía.
+     * 
+     * @return true si se llamó a cerrar()
+     */
+    bool estaCerrada() const { return cerrada.load(std::memory_order_acquire); }
+    
+    /**
+     * @brief Obtiene el número aproximado de elementos en la cola
+     * @return Profundidad actual
+     */
+    size_t profundidad() const {
+        return cola.load(std::memory_order_acquire) - cabeza.load(std::memory_order_acquire);
+    }
+    
+    /**
+     * @brief Obtiene la capacidad real de la cola
+     * @return Número máximo de elementos
+     */
+    size_t capacidad() const { return mascara + 1; }
+};
+
+#endif // COLA_SPSC_H
@@ -0,0 +1,116 @@
+/**
+ * @file ControlDeParada.h
+ * @brief Parada ordenada por señal y plazo de inactividad de los flujos
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef CONTROL_DE_PARADA_H
+#define CONTROL_DE_PARADA_H
+
+#include "HistogramaLatencia.h"  // Para relojNs()
+#include <csignal>
+
+/// Tiempo sin datos tras el cual un flujo se da por terminado por defecto
+const int INACTIVIDAD_DEFECTO_MS = 5000;
+
+/**
+ * @class ControlDeParada
+ * @brief Petición de parada hecha por SIGTERM o SIGINT
+ *
+ * El manejador solo anota la señal; los bucles de lectura la consultan
+ * con solicitada() y terminan como al agotarse la fuente: decodifican el
+ * lote pendiente, guardan el punto de control y entregan los resultados.
+ *
+ * La señal llega a un hilo cualquiera del proceso, que puede no ser el que
+ * duerme esperando datos. Por eso la petición también escribe un byte en
+ * una tubería de aviso: quien espera con poll() o epoll vigila su extremo
+ * de lectura (obtenerDescriptorAviso()) y despierta enseguida. El byte no
+ * se consume, así que todos los hilos lo ven. La primera señal restaura
+ * la acción por defecto, así que una segunda termina el proceso de
+ * inmediato si el vaciado se atasca.
+ */
+class ControlDeParada {
+private:
+    /// Señal recibida (0 = ninguna; la pone el manejador)
+    static volatile sig_atomic_t senalRecibida;
+
+    /// Tubería de aviso: [0] lectura, [1] escritura (-1 si no se creó)
+    static int tuberiaAviso[2];
+
+public:
+    /**
+     * @brief Crea la tubería de aviso e instala el manejador de SIGTERM y SIGINT
+     */
+    static void instalar();
+
+    /**
+     * @brief Anota una petición de parada y la avisa por la tubería
+     *
+     * Seguro dentro de un manejador de señal (solo usa write()).
+     *
+     * @param senal Señal que la pide
+     */
+    static void solicitar(int senal);
+
+    /**
+     * @brief Indica si se pidió la parada
+     */
+    static bool solicitada() { return senalRecibida != 0; }
+
+    /**
+     * @brief Obtiene la señal que pidió la parada (0 si ninguna)
+     */
+    static int obtenerSenal() { return senalRecibida; }
+
+    /**
+     * @brief Obtiene el extremo de la tubería que se vuelve legible al pedir la parada
+     * @return Descriptor, o -1 si no hay tubería (antes de instalar() o en Windows)
+     */
+    static int obtenerDescriptorAviso() { return tuberiaAviso[0]; }
+};
+
+/**
+ * @class PlazoDeInactividad
+ * @brief Decide cuándo un flujo lleva demasiado tiempo sin datos
+ *
+ * Solo lee el reloj en las lecturas vacías: con datos basta con anotar
+ * su llegada, que la fuente ya marcó (o 0 si no la conoce, y entonces el
+ * silencio se cuenta desde la primera lectura vacía).
+ */
+class PlazoDeInactividad {
+private:
+    long long plazoNs;          ///< Silencio permitido (0 = sin límite)
+    long long ultimoDatoNs;     ///< Llegada del último dato, o inicio del silencio (0 = sin referencia)
+
+public:
+    /**
+     * @brief Constructor
+     * @param plazoMs Milisegundos sin datos permitidos (0 = esperar sin límite)
+     */
+    explicit PlazoDeInactividad(int plazoMs)
+        : plazoNs(plazoMs > 0 ? plazoMs * 1000000LL : 0), ultimoDatoNs(0) {}
+
+    /**
+     * @brief Anota que llegaron datos
+     * @param llegadaNs Instante de llegada según relojNs() (0 = desconocido)
+     */
+    void datos(long long llegadaNs) { ultimoDatoNs = llegadaNs; }
+
+    /**
+     * @brief Anota una lectura vacía y comprueba el plazo
+     * @return true si el silencio ya alcanzó el plazo
+     */
+    bool vencido() {
+        if (plazoNs == 0) return false;
+
+        long long ahora = relojNs();
+        if (ultimoDatoNs == 0) {
+            ultimoDatoNs = ahora;
+            return false;
+        }
+        return ahora - ultimoDatoNs >= plazoNs;
+    }
+};
+
+#endif // CONTROL_DE_PARADA_H
@@ -0,0 +1,176 @@
+/**
+ * @file DecodificadorParalelo.h
+ * @brief Decodificación paralela de capturas grabadas (modo fuera de línea)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef DECODIFICADOR_PARALELO_H
+#define DECODIFICADOR_PARALELO_H
+
+#include "AnalizadorPorLotes.h"
+#include "ArchivoMapeado.h"
+#include "RotorGenerico.h"
+#include <atomic>
+#include <cstdio>
+
+/**
+ * @struct TramoDeCaptura
+ * @brief Porción de la captura, cortada en límites de trama, que procesa un hilo
+ */
+struct TramoDeCaptura {
+    size_t inicio;              ///< Primer byte del tramo en la captura
+    size_t fin;                 ///< Byte siguiente al último del tramo
+    size_t finRecorrido;        ///< Fin de la trama que cruza 'fin' recorriendo desde 'inicio' (fase 0)
+    int rotacion;               ///< Suma de las rotaciones MAP del tramo (módulo 26)
+    long long caracteres;       ///< Caracteres que el tramo aporta al mensaje
+    long long tramas;           ///< Tramas válidas del tramo
+    long long invalidas;        ///< Líneas rechazadas por el parser
+    int desplazamientoInicial;  ///< Rotación vigente al empezar el tramo
+    long long posicionSalida;   ///< Posición del primer carácter del tramo en la salida
+};
+
+/**
+ * @class DecodificadorParalelo
+ * @brief Decodifica una captura completa usando todos los núcleos
+ * 
+ * Una trama MAP solo suma su rotación al desplazamiento del rotor (módulo
+ * el tamaño del alfabeto), así que el estado del rotor en cualquier línea es la suma de prefijos
+ * de las rotaciones anteriores. La decodificación se hace en tres fases:
+ * 
+ * 1. Análisis (en paralelo): cada tramo calcula su suma de rotaciones y
+ *    cuántos caracteres produce.
+ * 2. Escaneo exclusivo (secuencial, un elemento por tramo): rotación
+ *    inicial y posición de salida de cada tramo.
+ * 3. Decodificación (en paralelo): cada tramo arranca su propio rotor en
+ *    la rotación inicial y escribe en su posición de la salida.
+ * 
+ * El resultado es idéntico al de procesar la captura línea por línea con
+ * TramaBase::procesar().
+ * 
+ * Si la captura tiene tramas binarias, un '\n' no marca un límite seguro
+ * (puede ser un byte de un varint). Cada corte se elige entonces cerca del
+ * punto proporcional, donde empiezan varias tramas seguidas con forma
+ * válida, y una fase 0 en paralelo recorre cada tramo desde su corte
+ * hasta la trama que cruza su final. Un repaso secuencial encadena los
+ * tramos: si el fin real del anterior no coincide con el corte, recorre
+ * desde ambos a la vez hasta que se encuentran, lo que suele llevar unas
+ * pocas tramas; solo si no se encuentran recorre el tramo entero.
+ * 
+ * Con una cascada de rotores el estado depende del arrastre y de la
+ * selección, no solo de la suma de rotaciones: la captura se decodifica
+ * entonces en un único tramo. La salida se proyecta en memoria cuando es un
+ * archivo, de modo que los hilos escriben directamente en su lugar.
+ */
+class DecodificadorParalelo {
+private:
+    int numHilos;                       ///< Hilos de trabajo
+    TipoAlfabeto alfabeto;              ///< Alfabeto de los rotores
+    int tamanioAlfabeto;                ///< Módulo de las rotaciones
+    const char* cascada;                ///< Especificación de la cascada de rotores (nullptr si no hay)
+    bool secuencial;                    ///< La cascada impide la suma de prefijos: un solo tramo
+    
+    const char* datos;                  ///< Captura completa
+    char* salida;                       ///< Mensaje decodificado completo
+    TramoDeCaptura* tramos;             ///< Tramos de la captura
+    int numTramos;                      ///< Número de tramos
+    std::atomic<int> siguienteTramo;    ///< Próximo tramo sin asignar
+    
+    long long totalTramas;              ///< Tramas válidas de la captura
+    long long totalInvalidas;           ///< Líneas rechazadas de la captura
+    long long totalCaracteres;          ///< Longitud del mensaje
+    size_t bytesEntrada;                ///< Tamaño de la captura
+    size_t bytesRecorridosEnSerie;      ///< Bytes recorridos en el repaso secuencial de los cortes
+    double segundosAnalisis;            ///< Duración de las fases 1 y 2
+    double segundosDecodificacion;      ///< Duración de la fase 3
+    
+    /**
+     * @brief Corta la captura en tramos de tamaño similar, en límites de trama
+     * @param tamanio Bytes de la captura
+     */
+    void dividir(size_t tamanio);
+    
+    /**
+     * @brief Fase 0 para un tramo: recorre sus tramas desde el corte supuesto
+     * @param tramo Tramo a recorrer (anota finRecorrido)
+     */
+    void recorrerTramo(TramoDeCaptura* tramo);
+    
+    /**
+     * @brief Encadena los tramos recorridos en la fase 0 en los límites reales de trama
+     */
+    void resincronizar();
+    
+    /**
+     * @brief Fase 1 para un tramo: suma de rotaciones y caracteres
+     * @param tramo Tramo a analizar
+     */
+    void analizarTramo(TramoDeCaptura* tramo);
+    
+    /**
+     * @brief Fase 3 para un tramo: decodifica en su posición de salida
+     * @param tramo Tramo a decodificar
+     */
+    void decodificarTramo(const TramoDeCaptura* tramo);
+    
+    /**
+     * @brief Reparte los tramos entre los hilos y ejecuta una fase
+     * @param fase 0 (recorrido de los cortes), 1 (análisis) o 3 (decodificación)
+     */
+    void ejecutarFase(int fase);
+    
+    /**
+     * @brief Bucle de un hilo: toma tramos hasta agotarlos
+     * @param fase 0 (recorrido de los cortes), 1 (análisis) o 3 (decodificación)
+     */
+    void trabajador(int fase);
+    
+    // No copiable: contiene los tramos
+    DecodificadorParalelo(const DecodificadorParalelo&);
+    DecodificadorParalelo& operator=(const DecodificadorParalelo&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param hilos Hilos de trabajo (0 = uno por núcleo)
+     * @param tipoAlfabeto Alfabeto del rotor (A-Z por defecto)
+     * @param especificacionCascada Cascada de rotores (ver RotorDeMapeo::configurarCascada()),
+     *        ya validada, o nullptr
+     */
+    explicit DecodificadorParalelo(int hilos = 0, TipoAlfabeto tipoAlfabeto = ALFABETO_MAYUSCULAS,
+                                   const char* especificacionCascada = nullptr);
+    
+    /**
+     * @brief Destructor - Libera los tramos
+     */
+    ~DecodificadorParalelo();
+    
+    /**
+     * @brief Decodifica una captura de líneas "L,X" / "M,N" / "B,TEXTO" o tramas binarias
+     * 
+     * Los errores se imprimen en stderr.
+     * 
+     * @param entrada Captura proyectada en memoria
+     * @param rutaDestino Archivo de salida, o nullptr para escribir en stdout
+     * @return true si el mensaje se escribió completo
+     */
+    bool decodificar(const ArchivoMapeado& entrada, const char* rutaDestino);
+    
+    /**
+     * @brief Imprime tramas, caracteres, tiempos y rendimiento de la última decodificación
+     * @param destino Flujo donde se imprime (stderr si la salida va a stdout)
+     */
+    void imprimirResumen(FILE* destino) const;
+    
+    /**
+     * @brief Obtiene el número de tramos de la última decodificación
+     */
+    int obtenerNumTramos() const { return numTramos; }
+    
+    /**
+     * @brief Obtiene los bytes que el repaso de los cortes recorrió en un solo hilo
+     */
+    size_t obtenerBytesRecorridosEnSerie() const { return bytesRecorridosEnSerie; }
+};
+
+#endif // DECODIFICADOR_PARALELO_H
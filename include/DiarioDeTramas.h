@@ -0,0 +1,203 @@
+/**
+ * @file DiarioDeTramas.h
+ * @brief Diario de solo anexado con las tramas aplicadas desde el último punto de control
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Formato del archivo:
+ *
+ *   Cabecera (24 bytes): "PRT7DIAR", versión (u32), reservado (u32), generación (u64)
+ *   Bloques: bytes (u32), tramas (u32), suma FNV-1a de los registros (u32), registros
+ *   Registro: longitud de la trama como varint (FormatoBinario.h) y sus bytes
+ *
+ * Cada bloque se escribe con una sola llamada a write(). Tras una caída, la
+ * lectura se detiene en el primer bloque incompleto o con suma incorrecta:
+ * se recupera todo lo que llegó completo al archivo y nada más. Los enteros
+ * se guardan en el orden de bytes de la máquina.
+ */
+
+#ifndef DIARIO_DE_TRAMAS_H
+#define DIARIO_DE_TRAMAS_H
+
+#include "FormatoBinario.h"
+#include <cstring>
+
+class ProcesadorDeTramas;
+
+/// Tramas por bloque por defecto
+const int TRAMAS_POR_LOTE_DIARIO_DEFECTO = 64;
+
+/// Intervalo máximo entre sincronizaciones con el disco en el modo por lotes (ms)
+const int INTERVALO_SINCRONIZACION_DEFECTO_MS = 1000;
+
+/// Bytes del buffer de un bloque (un bloque se escribe antes si se llena)
+const int CAPACIDAD_BLOQUE_DIARIO = 64 * 1024;
+
+/**
+ * @enum PoliticaSincronizacion
+ * @brief Cuándo se escriben y sincronizan con el disco los bloques del diario
+ */
+enum PoliticaSincronizacion {
+    SINCRONIZAR_TRAMA,  ///< Un bloque por trama y fdatasync() tras cada uno (lo más seguro, lo más lento)
+    SINCRONIZAR_LOTE,   ///< Bloques de N tramas; fdatasync() como mucho una vez por intervalo
+    SINCRONIZAR_NUNCA   ///< Bloques de N tramas sin fdatasync(): resiste la caída del proceso, no la del sistema
+};
+
+/**
+ * @class DiarioDeTramas
+ * @brief Registro de solo anexado de las tramas válidas aplicadas al estado
+ *
+ * anotar() solo copia la trama al buffer del bloque en curso; la llamada al
+ * sistema ocurre una vez por bloque. La generación del diario debe coincidir
+ * con la del punto de control para que sus tramas se reapliquen: un diario
+ * de una generación anterior ya está incluido en el punto de control.
+ */
+class DiarioDeTramas {
+private:
+    int descriptor;                     ///< Archivo del diario (-1 si está cerrado)
+    PoliticaSincronizacion politica;    ///< Política de escritura
+    int tramasPorLote;                  ///< Tramas por bloque
+    int intervaloMs;                    ///< Intervalo máximo entre sincronizaciones
+
+    unsigned char* bloque;              ///< Cabecera y registros del bloque en curso
+    int bytesBloque;                    ///< Bytes usados de 'bloque' (incluida la cabecera)
+    int tramasBloque;                   ///< Tramas del bloque en curso
+
+    long long ultimaSincronizacionNs;   ///< Última llamada a fdatasync()
+    bool sucio;                         ///< Hay bloques escritos sin sincronizar
+    bool error;                         ///< Falló una escritura (se deja de anotar)
+
+    // No copiable: es dueño del descriptor y del buffer
+    DiarioDeTramas(const DiarioDeTramas&);
+    DiarioDeTramas& operator=(const DiarioDeTramas&);
+
+    /**
+     * @brief Escribe la cabecera de una generación en un archivo vacío
+     */
+    bool escribirCabecera(unsigned long long generacion);
+
+    /**
+     * @brief Anota una trama que no cabe en el bloque en curso
+     *
+     * Escribe el bloque en curso; si la trama tampoco cabe en un bloque
+     * vacío, la escribe en un bloque propio del tamaño necesario.
+     */
+    void anotarFueraDeBloque(const char* trama, int longitud);
+
+public:
+    /**
+     * @brief Constructor - Diario cerrado
+     * @param politicaSincronizacion Cuándo escribir y sincronizar
+     * @param tramasLote Tramas por bloque (SINCRONIZAR_TRAMA usa siempre 1)
+     * @param intervaloSincronizacionMs Intervalo máximo entre fdatasync() en SINCRONIZAR_LOTE
+     */
+    DiarioDeTramas(PoliticaSincronizacion politicaSincronizacion = SINCRONIZAR_LOTE,
+                   int tramasLote = TRAMAS_POR_LOTE_DIARIO_DEFECTO,
+                   int intervaloSincronizacionMs = INTERVALO_SINCRONIZACION_DEFECTO_MS);
+
+    /**
+     * @brief Destructor - Escribe el bloque pendiente y cierra el archivo
+     */
+    ~DiarioDeTramas();
+
+    /**
+     * @brief Abre (creándolo si hace falta) el archivo y lo vacía para una generación
+     * @param ruta Ruta del diario
+     * @param generacion Generación del punto de control vigente
+     * @return false si no se pudo abrir o escribir
+     */
+    bool abrir(const char* ruta, unsigned long long generacion);
+
+    /**
+     * @brief Anota una trama aplicada
+     * @param trama Bytes de la trama (línea de texto o trama binaria)
+     * @param longitud Número de bytes (mayor que 0)
+     */
+    void anotar(const char* trama, int longitud) {
+        if (bytesBloque + MAX_BYTES_VARINT + longitud > CAPACIDAD_BLOQUE_DIARIO) {
+            anotarFueraDeBloque(trama, longitud);
+            return;
+        }
+
+        bytesBloque += escribirVarint(static_cast<unsigned int>(longitud), bloque + bytesBloque);
+        memcpy(bloque + bytesBloque, trama, longitud);
+        bytesBloque += longitud;
+
+        if (++tramasBloque >= tramasPorLote) {
+            escribirBloque();
+        }
+    }
+
+    /**
+     * @brief Escribe el bloque en curso y sincroniza según la política
+     *
+     * Se llama solo al llenarse el bloque; conviene llamarla también cuando
+     * el flujo queda inactivo para no dejar tramas en memoria.
+     */
+    void escribirBloque();
+
+    /**
+     * @brief Escribe el bloque en curso y sincroniza siempre (salvo SINCRONIZAR_NUNCA)
+     */
+    void sincronizar();
+
+    /**
+     * @brief Descarta el contenido y empieza una generación nueva
+     *
+     * Se llama justo después de guardar un punto de control, que ya
+     * incluye todas las tramas anotadas.
+     *
+     * @param generacion Generación del punto de control recién guardado
+     * @return false si no se pudo truncar o escribir
+     */
+    bool reiniciar(unsigned long long generacion);
+
+    /**
+     * @brief Indica si el diario está abierto y sin errores de escritura
+     */
+    bool estaActivo() const { return descriptor >= 0 && !error; }
+
+    /**
+     * @brief Reaplica las tramas de un diario sobre un procesador
+     *
+     * Solo se reaplica un diario de la generación indicada; uno de otra
+     * generación (o inexistente) no aporta tramas.
+     *
+     * @param ruta Ruta del diario
+     * @param generacion Generación esperada
+     * @param procesador Procesador sobre el estado recuperado
+     * @param descartados Variable donde se devuelven los bytes finales ilegibles (puede ser nullptr)
+     * @return Número de tramas reaplicadas
+     */
+    static long long reproducir(const char* ruta, unsigned long long generacion,
+                                ProcesadorDeTramas* procesador, long long* descartados);
+};
+
+/**
+ * @brief Suma FNV-1a de 32 bits
+ * @param datos Bytes a sumar
+ * @param n Número de bytes
+ * @param suma Valor inicial (2166136261 para empezar)
+ * @return Suma acumulada
+ */
+unsigned int sumaFnv(const void* datos, size_t n, unsigned int suma = 2166136261u);
+
+/**
+ * @brief Lleva al disco los datos escritos en un descriptor (fdatasync/_commit)
+ * @return false si falló
+ */
+bool sincronizarDescriptor(int descriptor);
+
+/**
+ * @brief Escribe todos los bytes, reintentando escrituras parciales
+ * @return false si falló
+ */
+bool escribirCompleto(int descriptor, const void* datos, size_t n);
+
+/**
+ * @brief Recorta (o extiende con ceros) un archivo abierto
+ * @return false si falló
+ */
+bool truncarDescriptor(int descriptor, long long longitud);
+
+#endif // DIARIO_DE_TRAMAS_H
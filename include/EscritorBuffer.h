@@ -0,0 +1,72 @@
+/**
+ * @file EscritorBuffer.h
+ * @brief Escritura con buffer propio hacia un FILE*
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ESCRITOR_BUFFER_H
+#define ESCRITOR_BUFFER_H
+
+#include <cstdio>
+
+/// Tamaño por defecto del buffer del escritor (bytes)
+const int TAM_BUFFER_ESCRITOR = 65536;
+
+/**
+ * @class EscritorBuffer
+ * @brief Acumula bytes y los entrega al destino en pocas llamadas fwrite()
+ * 
+ * Escribir carácter por carácter con printf() cuesta una llamada de
+ * biblioteca (y a menudo un write()) por byte cuando la salida es una
+ * terminal. El escritor junta los bytes en su buffer y solo escribe
+ * cuando se llena o cuando se vacía explícitamente.
+ */
+class EscritorBuffer {
+private:
+    FILE* destino;      ///< Flujo de salida
+    char* buffer;       ///< Bytes pendientes de escribir
+    int capacidad;      ///< Tamaño del buffer
+    int usados;         ///< Bytes pendientes
+    
+    // No copiable: es dueño del buffer
+    EscritorBuffer(const EscritorBuffer&);
+    EscritorBuffer& operator=(const EscritorBuffer&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param flujo Destino de la escritura (por ejemplo, stdout)
+     * @param tamBuffer Tamaño del buffer en bytes
+     */
+    explicit EscritorBuffer(FILE* flujo, int tamBuffer = TAM_BUFFER_ESCRITOR);
+    
+    /**
+     * @brief Destructor - Escribe lo pendiente y libera el buffer
+     */
+    ~EscritorBuffer();
+    
+    /**
+     * @brief Agrega bytes al buffer (escribe antes si no caben)
+     * @param datos Bytes a escribir
+     * @param n Número de bytes
+     */
+    void escribir(const char* datos, int n);
+    
+    /**
+     * @brief Agrega texto con formato printf
+     * @param formato Formato printf (el resultado se trunca a 256 bytes)
+     */
+    void escribirFormato(const char* formato, ...)
+#ifdef __GNUC__
+        __attribute__((format(printf, 2, 3)))
+#endif
+        ;
+    
+    /**
+     * @brief Escribe lo pendiente en el destino y hace fflush()
+     */
+    void vaciar();
+};
+
+#endif // ESCRITOR_BUFFER_H
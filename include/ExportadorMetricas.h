@@ -0,0 +1,79 @@
+/**
+ * @file ExportadorMetricas.h
+ * @brief Escritura periódica de las métricas en formato de texto de Prometheus
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef EXPORTADOR_METRICAS_H
+#define EXPORTADOR_METRICAS_H
+
+#include <atomic>
+#include <thread>
+
+/// Intervalo por defecto entre escrituras del archivo de métricas (ms)
+const int INTERVALO_METRICAS_DEFECTO_MS = 5000;
+
+/**
+ * @class ExportadorMetricas
+ * @brief Hilo que vuelca Metricas a un archivo para el textfile collector de node_exporter
+ *
+ * Cada intervalo escribe todas las métricas en "<ruta>.tmp" y lo renombra
+ * sobre la ruta final, de modo que el recolector nunca lee un archivo a
+ * medio escribir. Además de los contadores publica tasas (tramas/s y
+ * bytes/s) calculadas sobre el último intervalo.
+ */
+class ExportadorMetricas {
+private:
+    char* ruta;                       ///< Archivo final
+    char* rutaTemporal;               ///< Archivo donde se escribe antes de renombrar
+    int intervaloMs;                  ///< Tiempo entre escrituras
+    std::atomic<bool> detenerHilo;    ///< Petición de parada
+    std::thread hilo;                 ///< Hilo escritor
+    bool enMarcha;                    ///< Hay un hilo que unir
+
+    unsigned long long tramasPrevias; ///< Tramas en la escritura anterior
+    unsigned long long bytesPrevios;  ///< Bytes en la escritura anterior
+    long long instantePrevioNs;       ///< Momento de la escritura anterior
+
+    // No copiable: es dueño del hilo y de las rutas
+    ExportadorMetricas(const ExportadorMetricas&);
+    ExportadorMetricas& operator=(const ExportadorMetricas&);
+
+    /**
+     * @brief Bucle del hilo: escribir y esperar el intervalo
+     */
+    void ejecutar();
+
+public:
+    /**
+     * @brief Constructor
+     * @param rutaArchivo Archivo de métricas (p. ej. .../textfile/prt7.prom)
+     * @param intervalo Milisegundos entre escrituras
+     */
+    ExportadorMetricas(const char* rutaArchivo, int intervalo = INTERVALO_METRICAS_DEFECTO_MS);
+
+    /**
+     * @brief Destructor - Detiene el hilo (con una última escritura)
+     */
+    ~ExportadorMetricas();
+
+    /**
+     * @brief Escribe el archivo una vez y arranca el hilo periódico
+     * @return false si el archivo no se pudo escribir
+     */
+    bool iniciar();
+
+    /**
+     * @brief Detiene el hilo y escribe los valores finales
+     */
+    void detener();
+
+    /**
+     * @brief Escribe las métricas actuales en el archivo
+     * @return true si se escribió y renombró correctamente
+     */
+    bool escribir();
+};
+
+#endif // EXPORTADOR_METRICAS_H
@@ -0,0 +1,155 @@
+/**
+ * @file FormatoBinario.h
+ * @brief Codificación binaria compacta de las tramas PRT-7 y delimitación de tramas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ * 
+ * Formato binario (cada trama empieza con una etiqueta de un byte >= 0x80):
+ * 
+ *   0xA1 C            LOAD: un byte de carga
+ *   0xA2 V...         MAP:  rotación como varint con codificación zigzag
+ *   0xA3 N... D[N]    BULK: longitud como varint seguida de N bytes de carga
+ *   0xA4 I...         SELECT: índice del rotor como varint
+ *   0xA5 I... V...    ROTOR: índice del rotor (varint) y rotación (varint zigzag)
+ *   0xA6              FIN: cierra el mensaje en curso (sin datos)
+ * 
+ * Los varint son LEB128 sin signo (7 bits por byte, el bit alto indica que
+ * sigue otro byte; máximo 5 bytes). Zigzag intercala los signos
+ * (0, -1, 1, -2, ...) para que las rotaciones pequeñas ocupen un byte:
+ * "M,-13\r\n" (7 bytes) pasa a ser A2 19 (2 bytes).
+ * 
+ * Las tramas de texto empiezan siempre con un byte ASCII, así que el primer
+ * byte de cada trama basta para distinguir ambos formatos y un mismo flujo
+ * puede mezclarlos. Las tramas binarias no llevan salto de línea: se
+ * delimitan por su longitud.
+ */
+
+#ifndef FORMATO_BINARIO_H
+#define FORMATO_BINARIO_H
+
+#include "FuenteDeLineas.h"
+#include <cstddef>
+
+/// Etiqueta de la trama LOAD binaria
+const unsigned char ETIQUETA_LOAD = 0xA1;
+
+/// Etiqueta de la trama MAP binaria
+const unsigned char ETIQUETA_MAP = 0xA2;
+
+/// Etiqueta de la trama BULK binaria
+const unsigned char ETIQUETA_BULK = 0xA3;
+
+/// Etiqueta de la trama SELECT binaria
+const unsigned char ETIQUETA_SELECCION = 0xA4;
+
+/// Etiqueta de la trama ROTOR binaria
+const unsigned char ETIQUETA_ROTOR = 0xA5;
+
+/// Etiqueta de la trama FIN binaria
+const unsigned char ETIQUETA_FIN = 0xA6;
+
+/// Bytes máximos de un varint de 32 bits
+const int MAX_BYTES_VARINT = 5;
+
+/// Carga máxima de una trama BULK binaria (cabe en el buffer de SerialPort)
+const int MAX_CARGA_BULK_BINARIA = 4096;
+
+/// Bytes máximos de una trama binaria codificada
+const int MAX_TRAMA_BINARIA = 1 + MAX_BYTES_VARINT + MAX_CARGA_BULK_BINARIA;
+
+/**
+ * @brief Indica si una trama que empieza con este byte es binaria
+ * @param primerByte Primer byte de la trama
+ * @return true para las etiquetas binarias (>= 0x80)
+ */
+inline bool esTramaBinaria(unsigned char primerByte) {
+    return primerByte >= 0x80;
+}
+
+/**
+ * @brief Codifica un entero con signo en zigzag
+ * @param valor Entero con signo
+ * @return Entero sin signo equivalente (0, -1, 1, -2 -> 0, 1, 2, 3)
+ */
+inline unsigned int codificarZigzag(int valor) {
+    return (static_cast<unsigned int>(valor) << 1) ^ static_cast<unsigned int>(valor >> 31);
+}
+
+/**
+ * @brief Decodifica un entero zigzag
+ * @param valor Entero sin signo en zigzag
+ * @return Entero con signo original
+ */
+inline int decodificarZigzag(unsigned int valor) {
+    return static_cast<int>((valor >> 1) ^ (0u - (valor & 1u)));
+}
+
+/**
+ * @brief Escribe un varint LEB128
+ * @param valor Valor a codificar
+ * @param destino Buffer de al menos MAX_BYTES_VARINT bytes
+ * @return Bytes escritos
+ */
+int escribirVarint(unsigned int valor, unsigned char* destino);
+
+/**
+ * @brief Lee un varint LEB128
+ * @param datos Bytes de entrada
+ * @param disponibles Bytes disponibles
+ * @param valor Variable donde se guarda el valor
+ * @return Bytes consumidos, 0 si el varint está incompleto, o -1 si supera
+ *         MAX_BYTES_VARINT bytes
+ */
+int leerVarint(const unsigned char* datos, size_t disponibles, unsigned int* valor);
+
+/**
+ * @brief Calcula la longitud de la trama binaria que empieza en 'datos'
+ * 
+ * Una etiqueta desconocida o un varint mal formado producen una trama
+ * corta que el registro rechazará como inválida, de modo que la lectura
+ * se resincroniza en lugar de detenerse.
+ * 
+ * @param datos Primer byte de la trama (una etiqueta >= 0x80)
+ * @param disponibles Bytes disponibles desde 'datos'
+ * @return Longitud total de la trama, o 0 si aún no está completa
+ */
+size_t longitudTramaBinaria(const char* datos, size_t disponibles);
+
+/**
+ * @brief Delimita la siguiente trama (línea de texto o trama binaria) de un bloque completo
+ * 
+ * Para texto, la trama termina en '\n' (se elimina un '\r' previo); para
+ * binario, según su longitud. Si el bloque termina a mitad de una trama,
+ * se entrega lo que haya.
+ * 
+ * @param datos Inicio del bloque
+ * @param disponibles Bytes del bloque (mayor que 0)
+ * @param trama Vista donde se devuelve la trama (longitud 0 = línea vacía)
+ * @return Bytes consumidos del bloque (al menos 1)
+ */
+size_t delimitarTrama(const char* datos, size_t disponibles, VistaLinea* trama);
+
+/**
+ * @brief Codifica una línea de texto ("L,X", "M,N", "B,TEXTO", "S,I", "R,I,N", "FIN") en binario
+ * 
+ * Las tramas BULK de más de MAX_CARGA_BULK_BINARIA bytes se dividen en
+ * varias tramas BULK consecutivas.
+ * 
+ * @param linea Línea de texto (sin salto de línea)
+ * @param longitud Bytes de la línea
+ * @param destino Buffer de salida de al menos longitud + MAX_TRAMA_BINARIA bytes
+ * @return Bytes escritos, o 0 si la línea no es una trama de texto válida
+ */
+int codificarLineaBinaria(const char* linea, int longitud, unsigned char* destino);
+
+/**
+ * @brief Convierte una trama binaria en su línea de texto equivalente
+ * @param trama Trama binaria completa
+ * @param longitud Bytes de la trama
+ * @param destino Buffer de salida de al menos longitud + 16 bytes
+ * @return Bytes escritos (sin salto de línea), o 0 si la trama es inválida
+ *         o su carga contiene '\r' o '\n' (no representable en texto)
+ */
+int decodificarTramaATexto(const char* trama, int longitud, char* destino);
+
+#endif // FORMATO_BINARIO_H
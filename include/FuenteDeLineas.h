@@ -0,0 +1,58 @@
+/**
+ * @file FuenteDeLineas.h
+ * @brief Interfaz común para las fuentes de tramas (puerto serial, capturas)
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef FUENTE_DE_LINEAS_H
+#define FUENTE_DE_LINEAS_H
+
+/**
+ * @struct VistaLinea
+ * @brief Referencia a una línea dentro de un buffer, sin copiarla
+ * 
+ * La línea no incluye el '\n' final ni un '\r' previo, y no está terminada
+ * en '\0'. Solo es válida hasta la siguiente lectura de la fuente que la
+ * produjo.
+ */
+struct VistaLinea {
+    const char* datos;  ///< Primer byte de la línea
+    int longitud;       ///< Número de bytes de la línea
+    long long llegadaNs; ///< Llegada de su último byte según relojNs() (0 = desconocida)
+};
+
+/**
+ * @class FuenteDeLineas
+ * @brief Origen de líneas de tramas para el bucle de decodificación
+ * 
+ * Permite que el mismo bucle procese el puerto serial en vivo o una
+ * captura grabada, sin saber de dónde vienen las líneas.
+ */
+class FuenteDeLineas {
+public:
+    /**
+     * @brief Destructor virtual
+     */
+    virtual ~FuenteDeLineas() {}
+    
+    /**
+     * @brief Lee la siguiente línea sin copiarla
+     * @param linea Vista donde se devuelve la línea (válida hasta la siguiente lectura)
+     * @return Longitud de la línea (0 si no llegó nada a tiempo), o -1 si
+     *         hay error o la fuente se agotó
+     */
+    virtual int leerLineaVista(VistaLinea& linea) = 0;
+    
+    /**
+     * @brief Indica si la fuente terminó de forma normal
+     * 
+     * Distingue el fin de una captura de un error de lectura cuando
+     * leerLineaVista() devuelve -1.
+     * 
+     * @return true si no quedan líneas por leer
+     */
+    virtual bool finDeFlujo() const { return false; }
+};
+
+#endif // FUENTE_DE_LINEAS_H
@@ -0,0 +1,63 @@
+/**
+ * @file FuenteReplay.h
+ * @brief Reproducción de capturas grabadas como fuente de tramas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef FUENTE_REPLAY_H
+#define FUENTE_REPLAY_H
+
+#include "FuenteDeLineas.h"
+#include "ArchivoMapeado.h"
+#include <cstddef>
+
+/**
+ * @class FuenteReplay
+ * @brief Entrega las tramas de una captura (texto o binaria) proyectada en memoria
+ * 
+ * Las líneas son vistas directamente sobre la proyección del archivo: no
+ * hay read() ni copias por línea, así que la reproducción avanza a la
+ * velocidad del disco (o de la caché de páginas). Las líneas vacías no
+ * contienen tramas y se omiten; al agotarse la captura leerLineaVista()
+ * devuelve -1 y finDeFlujo() pasa a ser true.
+ */
+class FuenteReplay : public FuenteDeLineas {
+private:
+    ArchivoMapeado archivo;  ///< Captura proyectada
+    size_t posicion;         ///< Primer byte aún no entregado
+    
+public:
+    /**
+     * @brief Constructor - Sin captura abierta
+     */
+    FuenteReplay();
+    
+    /**
+     * @brief Abre una captura y se posiciona al principio
+     * @param ruta Ruta del archivo
+     * @return true si la captura quedó disponible
+     */
+    bool abrir(const char* ruta);
+    
+    /**
+     * @brief Entrega la siguiente línea no vacía de la captura
+     * @param linea Vista dentro de la proyección (válida mientras la fuente exista)
+     * @return Longitud de la línea, o -1 al final de la captura
+     */
+    int leerLineaVista(VistaLinea& linea) override;
+    
+    /**
+     * @brief Indica si ya se entregó toda la captura
+     * @return true al final de la captura
+     */
+    bool finDeFlujo() const override { return posicion >= archivo.obtenerTamanio(); }
+    
+    /**
+     * @brief Obtiene el tamaño de la captura
+     * @return Número de bytes
+     */
+    size_t obtenerTamanio() const { return archivo.obtenerTamanio(); }
+};
+
+#endif // FUENTE_REPLAY_H
@@ -0,0 +1,105 @@
+/**
+ * @file HistogramaLatencia.h
+ * @brief Histograma log-lineal de latencias en nanosegundos
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef HISTOGRAMA_LATENCIA_H
+#define HISTOGRAMA_LATENCIA_H
+
+#include <chrono>
+
+/// Bits de subdivisión lineal de cada potencia de dos (32 subcubetas: error relativo < 3.2%)
+const int BITS_SUBCUBETA_LATENCIA = 5;
+
+/// Subcubetas por potencia de dos
+const int SUBCUBETAS_LATENCIA = 1 << BITS_SUBCUBETA_LATENCIA;
+
+/// Mayor potencia de dos representable (2^40 ns, unos 18 minutos); lo que la supera va a la última cubeta
+const int MAX_POTENCIA_LATENCIA = 40;
+
+/// Número total de cubetas del histograma
+const int NUM_CUBETAS_LATENCIA =
+    SUBCUBETAS_LATENCIA * (MAX_POTENCIA_LATENCIA - BITS_SUBCUBETA_LATENCIA + 2);
+
+/**
+ * @brief Instante actual en nanosegundos de un reloj monótono
+ */
+inline long long relojNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @class HistogramaLatencia
+ * @brief Cuenta latencias en cubetas de ancho proporcional al valor
+ *
+ * Los valores menores que SUBCUBETAS_LATENCIA se guardan exactos; a partir
+ * de ahí cada potencia de dos se divide en SUBCUBETAS_LATENCIA cubetas
+ * lineales. Registrar un valor cuesta un par de operaciones de bits y un
+ * incremento, sin reservar memoria, por lo que puede hacerse por trama.
+ *
+ * No es seguro para hilos: cada histograma lo escribe y lo lee un solo hilo.
+ */
+class HistogramaLatencia {
+private:
+    unsigned long long cubetas[NUM_CUBETAS_LATENCIA];  ///< Valores registrados por cubeta
+    unsigned long long cuenta;                         ///< Total de valores registrados
+    long long maximo;                                  ///< Mayor valor registrado (exacto)
+
+    /**
+     * @brief Cubeta que corresponde a un valor
+     */
+    static int indiceDe(long long valor);
+
+    /**
+     * @brief Mayor valor que cae en una cubeta
+     */
+    static long long limiteSuperior(int indice);
+
+public:
+    /**
+     * @brief Constructor - Histograma vacío
+     */
+    HistogramaLatencia();
+
+    /**
+     * @brief Registra una latencia
+     * @param nanosegundos Valor a registrar (los negativos cuentan como 0)
+     */
+    void registrar(long long nanosegundos) {
+        if (nanosegundos < 0) nanosegundos = 0;
+        cubetas[indiceDe(nanosegundos)]++;
+        cuenta++;
+        if (nanosegundos > maximo) maximo = nanosegundos;
+    }
+
+    /**
+     * @brief Valor por debajo del cual queda la fracción pedida de las muestras
+     *
+     * Devuelve el límite superior de la cubeta (nunca más que el máximo),
+     * de modo que el percentil informado no subestima la latencia real.
+     *
+     * @param percentil Percentil entre 0 y 100
+     * @return Latencia en nanosegundos (0 si no hay muestras)
+     */
+    long long obtenerPercentil(double percentil) const;
+
+    /**
+     * @brief Número de latencias registradas
+     */
+    unsigned long long obtenerCuenta() const { return cuenta; }
+
+    /**
+     * @brief Mayor latencia registrada, en nanosegundos
+     */
+    long long obtenerMaximo() const { return maximo; }
+
+    /**
+     * @brief Vacía el histograma
+     */
+    void reiniciar();
+};
+
+#endif // HISTOGRAMA_LATENCIA_H
@@ -0,0 +1,92 @@
+/**
+ * @file LatenciasDeTramas.h
+ * @brief Histogramas de latencia por etapa y por tipo de trama
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef LATENCIAS_DE_TRAMAS_H
+#define LATENCIAS_DE_TRAMAS_H
+
+#include "HistogramaLatencia.h"
+#include <csignal>
+#include <cstdio>
+
+/**
+ * @enum EtapaLatencia
+ * @brief Tramo del recorrido de una trama que se mide
+ */
+enum EtapaLatencia {
+    ETAPA_DECODIFICACION,  ///< Llegada del último byte -> efecto aplicado (carácter en ListaDeCarga)
+    ETAPA_SALIDA,          ///< Efecto aplicado -> salida emitida
+    ETAPA_TOTAL,           ///< Llegada del último byte -> salida emitida
+    NUM_ETAPAS_LATENCIA
+};
+
+/**
+ * @enum TipoLatencia
+ * @brief Familia de trama a la que se atribuye una latencia
+ */
+enum TipoLatencia {
+    LATENCIA_LOAD,
+    LATENCIA_MAP,
+    LATENCIA_BULK,
+    LATENCIA_OTRA,
+    NUM_TIPOS_LATENCIA
+};
+
+/**
+ * @brief Familia de una trama según su primer byte (texto o etiqueta binaria)
+ */
+TipoLatencia clasificarTrama(unsigned char tipo);
+
+/**
+ * @class LatenciasDeTramas
+ * @brief Matriz de histogramas etapa x tipo de trama
+ *
+ * La escribe el hilo que decodifica y también la imprime él mismo, tanto al
+ * terminar como cuando se pide un informe con la señal SIGUSR1: el
+ * manejador solo marca la petición (solicitarInforme()) y el bucle de
+ * decodificación la atiende en el siguiente punto de salida.
+ */
+class LatenciasDeTramas {
+private:
+    HistogramaLatencia histogramas[NUM_ETAPAS_LATENCIA][NUM_TIPOS_LATENCIA];
+
+    /// Petición pendiente de informe (la pone el manejador de señal)
+    static volatile sig_atomic_t informeSolicitado;
+
+public:
+    /**
+     * @brief Registra una latencia
+     * @param etapa Tramo medido
+     * @param tipo Familia de la trama
+     * @param nanosegundos Latencia
+     */
+    void registrar(EtapaLatencia etapa, TipoLatencia tipo, long long nanosegundos) {
+        histogramas[etapa][tipo].registrar(nanosegundos);
+    }
+
+    /**
+     * @brief Imprime n, p50, p90, p99, p99.9 y máximo (en microsegundos) de cada histograma no vacío
+     * @param destino Flujo de salida
+     */
+    void imprimir(FILE* destino) const;
+
+    /**
+     * @brief Marca un informe pendiente (seguro dentro de un manejador de señal)
+     */
+    static void solicitarInforme() { informeSolicitado = 1; }
+
+    /**
+     * @brief Consume una petición de informe pendiente
+     * @return true si había una petición
+     */
+    static bool tomarSolicitudInforme() {
+        if (!informeSolicitado) return false;
+        informeSolicitado = 0;
+        return true;
+    }
+};
+
+#endif // LATENCIAS_DE_TRAMAS_H
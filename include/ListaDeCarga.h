@@ -8,20 +8,85 @@
 #ifndef LISTA_DE_CARGA_H
 #define LISTA_DE_CARGA_H
 
+/// Caracteres que almacena cada nodo (el nodo completo ocupa 128 bytes en 64 bits)
+const int CAPACIDAD_NODO_CARGA = 108;
+
+/// Nodos que se reservan juntos en cada bloque del pool
+const int NODOS_POR_BLOQUE_POOL = 64;
+
 /**
  * @struct NodoCarga
- * @brief Nodo de la lista doblemente enlazada
+ * @brief Nodo de la lista doblemente enlazada desenrollada
+ * 
+ * Cada nodo guarda un bloque de caracteres consecutivos del mensaje en lugar
+ * de un solo carácter, de modo que el costo de los punteros se reparte entre
+ * CAPACIDAD_NODO_CARGA caracteres.
  */
 struct NodoCarga {
-    char dato;              ///< Carácter almacenado
     NodoCarga* siguiente;   ///< Puntero al siguiente nodo
     NodoCarga* previo;      ///< Puntero al nodo anterior
+    int cantidad;           ///< Caracteres ocupados en 'datos'
+    char datos[CAPACIDAD_NODO_CARGA]; ///< Caracteres almacenados
+};
+
+/**
+ * @class PoolDeNodosCarga
+ * @brief Reserva nodos de carga por bloques y recicla los nodos liberados
+ * 
+ * Los nodos se obtienen de bloques de NODOS_POR_BLOQUE_POOL nodos contiguos.
+ * Los nodos devueltos se encadenan en una lista libre (usando su puntero
+ * 'siguiente') y se reutilizan antes de reservar un bloque nuevo. La memoria
+ * de los bloques solo se libera al destruir el pool.
+ */
+class PoolDeNodosCarga {
+private:
+    /**
+     * @struct BloquePool
+     * @brief Bloque contiguo de nodos reservado con un solo new
+     */
+    struct BloquePool {
+        BloquePool* siguiente;                  ///< Siguiente bloque reservado
+        NodoCarga nodos[NODOS_POR_BLOQUE_POOL]; ///< Nodos del bloque
+    };
+    
+    BloquePool* bloques;    ///< Lista de bloques reservados
+    NodoCarga* libres;      ///< Lista de nodos disponibles
+    int bloquesReservados;  ///< Número de bloques reservados
+    
+    // No copiable: es dueño de la memoria de sus bloques
+    PoolDeNodosCarga(const PoolDeNodosCarga&);
+    PoolDeNodosCarga& operator=(const PoolDeNodosCarga&);
+    
+public:
+    /**
+     * @brief Constructor - Pool vacío (no reserva memoria hasta el primer uso)
+     */
+    PoolDeNodosCarga();
+    
+    /**
+     * @brief Destructor - Libera todos los bloques reservados
+     */
+    ~PoolDeNodosCarga();
+    
+    /**
+     * @brief Obtiene un nodo vacío con sus punteros en nullptr
+     * @return Puntero al nodo
+     */
+    NodoCarga* obtener();
+    
+    /**
+     * @brief Devuelve un nodo al pool para reutilizarlo
+     * @param nodo Nodo que ya no forma parte de ninguna lista
+     */
+    void devolver(NodoCarga* nodo);
     
     /**
-     * @brief Constructor del nodo
-     * @param c Carácter a almacenar
+     * @brief Obtiene los bytes reservados por el pool
+     * @return Memoria total de los bloques
      */
-    explicit NodoCarga(char c) : dato(c), siguiente(nullptr), previo(nullptr) {}
+    long memoriaReservada() const {
+        return static_cast<long>(bloquesReservados) * static_cast<long>(sizeof(BloquePool));
+    }
 };
 
 /**
@@ -35,12 +100,27 @@ struct NodoCarga {
  * - Inserción eficiente al final (O(1))
  * - Navegación bidireccional
  * - Preserva el orden de llegada de los datos
+ * - Lista desenrollada: cada nodo guarda hasta CAPACIDAD_NODO_CARGA
+ *   caracteres y los nodos provienen de un PoolDeNodosCarga
+ * - Se puede descartar el principio (lo ya entregado a un SumideroDeMensajes);
+ *   las posiciones absolutas (obtenerDescartados() + índice) no cambian
  */
 class ListaDeCarga {
 private:
     NodoCarga* cabeza;      ///< Puntero al primer nodo
     NodoCarga* cola;        ///< Puntero al último nodo
-    int tamanio;            ///< Número de elementos en la lista
+    int tamanio;            ///< Número de caracteres en la lista
+    long long descartados;  ///< Caracteres quitados del principio desde la creación
+    PoolDeNodosCarga pool;  ///< Origen de los nodos de la lista
+    
+    /**
+     * @brief Agrega un nodo vacío al final de la lista
+     */
+    void agregarNodo();
+    
+    // No copiable: los nodos pertenecen al pool de esta lista
+    ListaDeCarga(const ListaDeCarga&);
+    ListaDeCarga& operator=(const ListaDeCarga&);
     
 public:
     /**
@@ -62,6 +142,17 @@ public:
      */
     void insertarAlFinal(char dato);
     
+    /**
+     * @brief Inserta un bloque de caracteres al final de la lista
+     * 
+     * Equivale a llamar insertarAlFinal() para cada carácter del bloque,
+     * en el mismo orden, pero copia por tramos completos de nodo.
+     * 
+     * @param datos Caracteres a insertar
+     * @param n Número de caracteres
+     */
+    void insertarBloque(const char* datos, int n);
+    
     /**
      * @brief Imprime el mensaje completo almacenado en la lista
      * 
@@ -83,15 +174,80 @@ public:
     bool estaVacia() const { return tamanio == 0; }
     
     /**
-     * @brief Limpia toda la lista (elimina todos los nodos)
+     * @brief Limpia toda la lista
+     * 
+     * Los nodos se devuelven al pool y se reutilizan en inserciones
+     * posteriores, sin volver a reservar memoria.
      */
     void limpiar();
     
+    /**
+     * @brief Quita caracteres del principio de la lista
+     * 
+     * Los nodos que quedan vacíos vuelven al pool; el resto del primer nodo
+     * se desplaza a su inicio. Los índices de la lista pasan a contar desde
+     * el primer carácter que queda.
+     * 
+     * @param n Caracteres a quitar (todos si n >= obtenerTamanio())
+     */
+    void descartarPrincipio(int n);
+    
+    /**
+     * @brief Obtiene los caracteres quitados del principio desde la creación
+     * 
+     * Quien recuerda posiciones entre llamadas (por ejemplo, lo ya emitido)
+     * debe guardarlas como posición absoluta: índice + obtenerDescartados().
+     * 
+     * @return Caracteres descartados con limpiar() o descartarPrincipio()
+     */
+    long long obtenerDescartados() const { return descartados; }
+    
     /**
      * @brief Obtiene el mensaje como una cadena (aloca memoria nueva)
      * @return Puntero a cadena con el mensaje (el llamador debe liberar con delete[])
      */
     char* obtenerMensajeComoString() const;
+    
+    /**
+     * @brief Copia los caracteres a partir de una posición del mensaje
+     * 
+     * Recorre la lista desde la cola hacia atrás hasta el nodo que contiene
+     * 'posicion', por lo que el costo es proporcional a los caracteres
+     * copiados y no al tamaño del mensaje. Sirve para emitir solo lo
+     * decodificado desde la última vez.
+     * 
+     * @param posicion Índice del primer carácter a copiar
+     * @param destino Buffer de destino (no se termina en '\0')
+     * @param maxCaracteres Capacidad del buffer
+     * @return Número de caracteres copiados
+     */
+    int copiarDesde(int posicion, char* destino, int maxCaracteres) const;
+    
+    /**
+     * @brief Busca el nodo que contiene una posición, recorriendo desde la cola
+     * @param posicion Índice del carácter (0 <= posicion < obtenerTamanio())
+     * @param desplazamiento Variable donde se devuelve el índice dentro del nodo
+     * @return Nodo que contiene 'posicion'
+     */
+    const NodoCarga* buscarDesdeCola(int posicion, int* desplazamiento) const;
+    
+    /**
+     * @brief Obtiene el primer nodo para recorrer la lista hacia adelante
+     * @return Puntero al primer nodo, o nullptr si la lista está vacía
+     */
+    const NodoCarga* obtenerPrimerNodo() const { return cabeza; }
+    
+    /**
+     * @brief Obtiene el último nodo para recorrer la lista hacia atrás
+     * @return Puntero al último nodo, o nullptr si la lista está vacía
+     */
+    const NodoCarga* obtenerUltimoNodo() const { return cola; }
+    
+    /**
+     * @brief Obtiene la memoria reservada para los nodos de la lista
+     * @return Bytes reservados por el pool de nodos
+     */
+    long memoriaReservada() const { return pool.memoriaReservada(); }
 };
 
 #endif // LISTA_DE_CARGA_H
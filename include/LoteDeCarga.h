@@ -0,0 +1,88 @@
+/**
+ * @file LoteDeCarga.h
+ * @brief Acumulador de rachas de tramas LOAD para decodificación por bloques
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef LOTE_DE_CARGA_H
+#define LOTE_DE_CARGA_H
+
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/// Capacidad máxima de caracteres pendientes en un lote
+const int CAPACIDAD_LOTE = 4096;
+
+/**
+ * @class LoteDeCarga
+ * @brief Acumula los caracteres de una racha de tramas LOAD
+ * 
+ * Entre dos tramas MAP el rotor no cambia, así que todos los caracteres
+ * LOAD recibidos en ese intervalo se pueden decodificar de una sola vez con
+ * RotorDeMapeo::mapearBloque(). El lote debe vaciarse antes de procesar
+ * cualquier trama que modifique el rotor para conservar el orden y la
+ * rotación correctos.
+ */
+class LoteDeCarga {
+private:
+    char pendientes[CAPACIDAD_LOTE];     ///< Caracteres recibidos sin decodificar
+    char decodificados[CAPACIDAD_LOTE];  ///< Resultado del último vaciado
+    int cantidad;                        ///< Número de caracteres pendientes
+    
+public:
+    /**
+     * @brief Constructor - Inicializa un lote vacío
+     */
+    LoteDeCarga() : cantidad(0) {}
+    
+    /**
+     * @brief Agrega un carácter recibido en una trama LOAD
+     * @param c Carácter sin decodificar
+     * @return false si el lote ya estaba lleno (el carácter no se agrega)
+     */
+    bool agregar(char c) {
+        if (cantidad >= CAPACIDAD_LOTE) return false;
+        pendientes[cantidad++] = c;
+        return true;
+    }
+    
+    /**
+     * @brief Decodifica los caracteres pendientes y los inserta en la carga
+     * 
+     * Usa la rotación actual del rotor para todo el bloque y deja el lote
+     * vacío. Los caracteres decodificados quedan disponibles en
+     * obtenerDecodificados() hasta el siguiente vaciado.
+     * 
+     * @param carga Lista donde se insertan los caracteres decodificados
+     * @param rotor Rotor usado para decodificar
+     * @return Número de caracteres decodificados
+     */
+    int vaciar(ListaDeCarga* carga, const RotorDeMapeo* rotor);
+    
+    /**
+     * @brief Obtiene el número de caracteres pendientes
+     * @return Caracteres acumulados desde el último vaciado
+     */
+    int obtenerCantidad() const { return cantidad; }
+    
+    /**
+     * @brief Verifica si el lote está vacío
+     * @return true si no hay caracteres pendientes
+     */
+    bool estaVacio() const { return cantidad == 0; }
+    
+    /**
+     * @brief Verifica si el lote alcanzó su capacidad
+     * @return true si debe vaciarse antes de agregar más caracteres
+     */
+    bool estaLleno() const { return cantidad >= CAPACIDAD_LOTE; }
+    
+    /**
+     * @brief Obtiene los caracteres producidos por el último vaciado
+     * @return Puntero al bloque decodificado (no terminado en '\0')
+     */
+    const char* obtenerDecodificados() const { return decodificados; }
+};
+
+#endif // LOTE_DE_CARGA_H
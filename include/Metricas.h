@@ -0,0 +1,121 @@
+/**
+ * @file Metricas.h
+ * @brief Registro de métricas del decodificador con contadores por hilo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <atomic>
+
+/**
+ * @enum ContadorMetrica
+ * @brief Contadores monótonos (solo crecen)
+ */
+enum ContadorMetrica {
+    CONTADOR_LLAMADAS_LECTURA,     ///< Llamadas read()/ReadFile() al puerto
+    CONTADOR_LECTURAS_VACIAS,      ///< Lecturas que terminaron sin datos (timeout)
+    CONTADOR_BYTES_LEIDOS,         ///< Bytes recibidos del puerto o de la captura
+    CONTADOR_TRAMAS_LOAD,          ///< Tramas LOAD procesadas
+    CONTADOR_TRAMAS_MAP,           ///< Tramas MAP procesadas
+    CONTADOR_TRAMAS_BULK,          ///< Tramas BULK procesadas
+    CONTADOR_TRAMAS_OTRAS,         ///< Tramas válidas de otros tipos
+    CONTADOR_INVALIDA_CORTA,       ///< Rechazada: menos de 3 bytes
+    CONTADOR_INVALIDA_SIN_COMA,    ///< Rechazada: falta la coma tras el tipo
+    CONTADOR_INVALIDA_TIPO,        ///< Rechazada: tipo o etiqueta binaria desconocidos
+    CONTADOR_INVALIDA_DATO,        ///< Rechazada por la fábrica del tipo (dato mal formado)
+    CONTADOR_LINEAS_DESCARTADAS,   ///< Líneas perdidas por cola llena en el pipeline
+    CONTADOR_REGISTROS_BITACORA_DESCARTADOS, ///< Registros de la bitácora perdidos por cola llena
+    NUM_CONTADORES_METRICA
+};
+
+/**
+ * @enum IndicadorMetrica
+ * @brief Valores instantáneos (el último escrito gana)
+ */
+enum IndicadorMetrica {
+    INDICADOR_DESPLAZAMIENTO_ROTOR,  ///< Desplazamiento actual del rotor (0..25)
+    INDICADOR_COLA_LINEAS,           ///< Ocupación de la cola de líneas del pipeline
+    INDICADOR_COLA_SALIDA,           ///< Ocupación de la cola de salida del pipeline
+    NUM_INDICADORES_METRICA
+};
+
+/**
+ * @struct ContadoresDeHilo
+ * @brief Bloque de contadores que escribe un único hilo
+ *
+ * Solo su hilo dueño los incrementa (carga y almacenamiento relajados,
+ * sin instrucciones atómicas de lectura-modificación-escritura); el
+ * exportador los lee desde otro hilo. Los bloques de los hilos que
+ * terminan se conservan para que los totales nunca retrocedan.
+ */
+struct ContadoresDeHilo {
+    std::atomic<unsigned long long> valores[NUM_CONTADORES_METRICA];
+    ContadoresDeHilo* siguiente;  ///< Siguiente bloque de la lista global
+};
+
+/**
+ * @class Metricas
+ * @brief Punto de entrada global para alimentar y leer las métricas
+ *
+ * Las rutas calientes (lectura del puerto, parser, procesador) llaman a
+ * sumar() sin recibir ningún objeto: cada hilo obtiene su bloque de
+ * contadores la primera vez y a partir de ahí incrementar cuesta lo mismo
+ * que un contador local. totalDe() suma los bloques de todos los hilos.
+ */
+class Metricas {
+private:
+    /// Bloques de todos los hilos que han contado algo
+    static std::atomic<ContadoresDeHilo*> listaHilos;
+
+    /// Indicadores compartidos
+    static std::atomic<long long> indicadores[NUM_INDICADORES_METRICA];
+
+    /// Bloque del hilo actual (nullptr hasta su primera métrica)
+    static thread_local ContadoresDeHilo* contadoresDelHilo;
+
+    /**
+     * @brief Crea el bloque del hilo actual y lo agrega a la lista global
+     */
+    static ContadoresDeHilo* registrarHilo();
+
+public:
+    /**
+     * @brief Incrementa un contador del hilo actual
+     * @param contador Contador a incrementar
+     * @param cantidad Cantidad a sumar
+     */
+    static void sumar(ContadorMetrica contador, unsigned long long cantidad = 1) {
+        ContadoresDeHilo* bloque = contadoresDelHilo;
+        if (!bloque) {
+            bloque = registrarHilo();
+        }
+        
+        // Un único escritor por bloque: basta con carga y almacenamiento relajados
+        std::atomic<unsigned long long>& valor = bloque->valores[contador];
+        valor.store(valor.load(std::memory_order_relaxed) + cantidad, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Fija el valor de un indicador
+     */
+    static void fijar(IndicadorMetrica indicador, long long valor) {
+        indicadores[indicador].store(valor, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Suma de un contador sobre todos los hilos
+     */
+    static unsigned long long totalDe(ContadorMetrica contador);
+
+    /**
+     * @brief Valor actual de un indicador
+     */
+    static long long valorDe(IndicadorMetrica indicador) {
+        return indicadores[indicador].load(std::memory_order_relaxed);
+    }
+};
+
+#endif // METRICAS_H
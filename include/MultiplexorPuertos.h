@@ -0,0 +1,170 @@
+/**
+ * @file MultiplexorPuertos.h
+ * @brief Atención de varios puertos seriales desde un solo hilo con epoll
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef MULTIPLEXOR_PUERTOS_H
+#define MULTIPLEXOR_PUERTOS_H
+
+#include "SerialPort.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "ControlDeParada.h"
+
+/// Máximo de puertos que se pueden multiplexar
+const int MAX_PUERTOS_MULTIPLEXADOS = 256;
+
+/// Tiempo sin datos en ningún puerto tras el cual termina el modo multiplexado (ms)
+const int INACTIVIDAD_MULTIPLEXOR_MS = INACTIVIDAD_DEFECTO_MS;
+
+/**
+ * @struct CanalPuerto
+ * @brief Estado de decodificación independiente de un puerto
+ * 
+ * Cada puerto tiene su propio rotor y su propia lista de carga, de modo que
+ * las tramas MAP de un sensor no afectan a los demás.
+ */
+struct CanalPuerto {
+    char nombre[128];                 ///< Ruta del puerto
+    SerialPort* puerto;               ///< Puerto abierto (nullptr si falló)
+    ListaDeCarga carga;               ///< Mensaje decodificado de este puerto
+    RotorDeMapeo rotor;               ///< Rotor de este puerto
+    ProcesadorDeTramas procesador;    ///< Decodificación de las líneas del puerto
+    bool activo;                      ///< El puerto sigue abierto y registrado
+    bool pendiente;                   ///< Quedaron líneas completas en el buffer del puerto
+    unsigned int eventos;             ///< Eventos de epoll de la ronda actual (0 = ninguno)
+    
+    /**
+     * @brief Constructor
+     * @param nombrePuerto Ruta del puerto
+     * @param registro Registro de tipos de trama compartido
+     * @param alfabeto Alfabeto del rotor del puerto
+     * @param cascada Cascada de rotores ya validada, o nullptr
+     */
+    CanalPuerto(const char* nombrePuerto, const RegistroDeTramas* registro, TipoAlfabeto alfabeto,
+                const char* cascada);
+    
+    /**
+     * @brief Destructor - Cierra el puerto
+     */
+    ~CanalPuerto();
+    
+private:
+    // No copiable: es dueño del puerto
+    CanalPuerto(const CanalPuerto&);
+    CanalPuerto& operator=(const CanalPuerto&);
+};
+
+/**
+ * @class MultiplexorPuertos
+ * @brief Decodifica N puertos seriales en un solo hilo
+ * 
+ * Los puertos se abren en modo no bloqueante y se registran en una
+ * instancia de epoll. El hilo duerme en epoll_wait() hasta que algún puerto
+ * tiene datos (sin espera activa) y entonces procesa las líneas completas
+ * de ese puerto con su propio ProcesadorDeTramas.
+ * 
+ * Cada ronda atiende a lo sumo un lote de líneas por puerto, en orden, para
+ * que un puerto saturado no deje sin servicio a los demás. epoll es por
+ * nivel y vuelve a avisar de lo que quede en el descriptor; un puerto con
+ * líneas ya leídas en su buffer queda pendiente y la siguiente ronda no
+ * duerme en epoll_wait().
+ * 
+ * Disponible solo en Linux.
+ */
+class MultiplexorPuertos {
+private:
+    CanalPuerto* canales[MAX_PUERTOS_MULTIPLEXADOS]; ///< Un canal por puerto
+    int numCanales;                   ///< Número de canales creados
+    RegistroDeTramas registro;        ///< Registro compartido por todos los canales
+    int descriptorEpoll;              ///< Instancia de epoll (-1 si no existe)
+    bool desatendido;                 ///< Sin advertencias del parser; la parada se avisa en stderr
+    
+    /**
+     * @brief Procesa un lote de líneas de un canal (como mucho una lectura del puerto)
+     * 
+     * Anota en canal->pendiente si pueden quedar líneas completas en el
+     * buffer del puerto, que epoll ya no avisaría.
+     * 
+     * @param canal Canal con datos pendientes
+     * @return false si el puerto reportó un error y debe cerrarse
+     */
+    bool atenderCanal(CanalPuerto* canal);
+    
+    /**
+     * @brief Retira un canal de epoll y cierra su puerto
+     * @param canal Canal a cerrar
+     */
+    void cerrarCanal(CanalPuerto* canal);
+    
+    // No copiable: es dueño de los canales y de epoll
+    MultiplexorPuertos(const MultiplexorPuertos&);
+    MultiplexorPuertos& operator=(const MultiplexorPuertos&);
+    
+public:
+    /**
+     * @brief Constructor - Crea un canal por cada puerto de la lista
+     * @param listaPuertos Rutas separadas por comas (ej. "/dev/ttyUSB0,/dev/ttyUSB1")
+     * @param alfabeto Alfabeto de los rotores (A-Z por defecto)
+     * @param cascada Cascada de rotores de cada puerto (ver RotorDeMapeo::configurarCascada()),
+     *        ya validada, o nullptr
+     */
+    explicit MultiplexorPuertos(const char* listaPuertos, TipoAlfabeto alfabeto = ALFABETO_MAYUSCULAS,
+                                const char* cascada = nullptr);
+    
+    /**
+     * @brief Destructor - Cierra todos los puertos
+     */
+    ~MultiplexorPuertos();
+    
+    /**
+     * @brief Abre todos los puertos y los registra en epoll
+     * @param config Configuración serial común a todos los puertos
+     * @return Número de puertos abiertos correctamente
+     */
+    int abrir(const ConfiguracionSerial& config);
+    
+    /**
+     * @brief Atiende los puertos hasta que todos se cierran o dejan de enviar datos
+     * 
+     * También termina cuando se pide la parada (ControlDeParada): la señal
+     * interrumpe epoll_wait() y los canales se cierran en orden.
+     * 
+     * @param inactividadMs Tiempo máximo sin datos en ningún puerto (0 = sin límite)
+     */
+    void ejecutar(int inactividadMs = INACTIVIDAD_MULTIPLEXOR_MS);
+    
+    /**
+     * @brief Anota en una bitácora los eventos de todos los canales
+     * 
+     * Los canales se atienden en un solo hilo, así que comparten la cola
+     * de la bitácora; cada registro lleva el índice de su canal.
+     * 
+     * @param destino Bitácora ya iniciada (nullptr para desactivar)
+     */
+    void establecerBitacora(Bitacora* destino);
+    
+    /**
+     * @brief Activa el modo desatendido: sin una advertencia por línea rechazada
+     * 
+     * Las líneas inválidas se siguen contando en el resumen de cada puerto.
+     * El motivo de la parada (señal o inactividad) se avisa en stderr.
+     * 
+     * @param activar true para no imprimir advertencias del parser
+     */
+    void establecerDesatendido(bool activar) {
+        desatendido = activar;
+        registro.establecerAdvertencias(!activar);
+    }
+    
+    /**
+     * @brief Imprime el resultado por puerto y el resumen agregado
+     */
+    void imprimirResumen() const;
+};
+
+#endif // MULTIPLEXOR_PUERTOS_H
@@ -0,0 +1,135 @@
+/**
+ * @file Opciones.h
+ * @brief Opciones de línea de comandos del decodificador
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef OPCIONES_H
+#define OPCIONES_H
+
+#include "SerialPort.h"
+#include "ColaSPSC.h"
+#include "SalidaDeMensaje.h"
+#include "ExportadorMetricas.h"
+#include "RotorGenerico.h"
+#include "PuntoDeControl.h"
+#include "SumideroDeMensajes.h"
+#include "Bitacora.h"
+#include "ControlDeParada.h"
+
+/**
+ * @enum ResultadoOpciones
+ * @brief Resultado de interpretar la línea de comandos
+ */
+enum ResultadoOpciones {
+    OPCIONES_OK,     ///< Opciones válidas: continuar
+    OPCIONES_AYUDA,  ///< Se pidió la ayuda: terminar sin error
+    OPCIONES_ERROR   ///< Opción desconocida o valor inválido
+};
+
+/**
+ * @struct OpcionesDecodificador
+ * @brief Configuración del decodificador obtenida de la línea de comandos
+ */
+struct OpcionesDecodificador {
+    ConfiguracionSerial serial;  ///< Parámetros del puerto serial
+    const char* puertos;         ///< Lista de puertos para el modo multipuerto (nullptr si no se usa)
+    bool pipeline;               ///< Leer, decodificar y escribir en hilos separados
+    PoliticaDesborde desborde;   ///< Política de las colas del pipeline
+    int capacidadCola;           ///< Elementos por cola del pipeline
+    const char* captura;         ///< Captura a decodificar fuera de línea (nullptr si no se usa)
+    const char* destino;         ///< Archivo del mensaje decodificado (nullptr = stdout)
+    int hilos;                   ///< Hilos de la decodificación fuera de línea (0 = uno por núcleo)
+    const char* reproduccion;    ///< Captura a reproducir en lugar del puerto (nullptr si no se usa)
+    ModoSalida salida;           ///< Qué imprimir mientras llegan las tramas
+    bool salidaIndicada;         ///< El modo de salida vino de la línea de comandos
+    int intervaloProgreso;       ///< Milisegundos entre líneas de progreso
+    bool latencias;              ///< Medir la latencia de cada trama
+    const char* metricas;        ///< Archivo de métricas Prometheus (nullptr si no se usa)
+    int intervaloMetricas;       ///< Milisegundos entre escrituras del archivo de métricas
+    TipoAlfabeto alfabeto;       ///< Alfabeto del rotor
+    const char* rotores;         ///< Especificación de la cascada de rotores (nullptr = un rotor)
+    const char* estado;          ///< Prefijo de los archivos de estado (nullptr = sin puntos de control)
+    PoliticaSincronizacion sincronizacion;  ///< Cuándo sincronizar el diario con el disco
+    int loteDiario;              ///< Tramas por bloque del diario
+    int tramasPorPunto;          ///< Tramas entre puntos de control
+    const char* mensajes;        ///< Archivo de los mensajes cerrados por FIN ("-" = stdout, nullptr = sin segmentar)
+    int ventana;                 ///< Caracteres del mensaje abierto que se retienen en memoria
+    const char* delimitador;     ///< Línea que cierra un mensaje
+    NivelBitacora bitacora;      ///< Nivel de la bitácora asíncrona
+    const char* archivoBitacora; ///< Archivo de la bitácora (nullptr = stderr)
+    const char* puerto;          ///< Puerto serial (nullptr = preguntarlo)
+    bool desatendido;            ///< Sin banner, instrucciones ni preguntas (servicio)
+    int inactividad;             ///< Milisegundos sin datos tras los que se termina (0 = sin límite)
+    
+    /**
+     * @brief Constructor - Opciones por defecto (un puerto, modo interactivo)
+     */
+    OpcionesDecodificador()
+        : puertos(nullptr), pipeline(false), desborde(DESBORDE_BLOQUEAR), capacidadCola(CAPACIDAD_COLA_DEFECTO),
+          captura(nullptr), destino(nullptr), hilos(0), reproduccion(nullptr),
+          salida(SALIDA_DETALLADA), salidaIndicada(false),
+          intervaloProgreso(INTERVALO_PROGRESO_DEFECTO_MS), latencias(false),
+          metricas(nullptr), intervaloMetricas(INTERVALO_METRICAS_DEFECTO_MS),
+          alfabeto(ALFABETO_MAYUSCULAS), rotores(nullptr),
+          estado(nullptr), sincronizacion(SINCRONIZAR_LOTE),
+          loteDiario(TRAMAS_POR_LOTE_DIARIO_DEFECTO), tramasPorPunto(TRAMAS_POR_PUNTO_DEFECTO),
+          mensajes(nullptr), ventana(VENTANA_MENSAJE_DEFECTO), delimitador(DELIMITADOR_FIN_DEFECTO),
+          bitacora(BITACORA_APAGADA), archivoBitacora(nullptr),
+          puerto(nullptr), desatendido(false), inactividad(INACTIVIDAD_DEFECTO_MS) {}
+};
+
+/**
+ * @brief Interpreta los argumentos del programa
+ * 
+ * Opciones reconocidas:
+ * - -b, --baudios N: velocidad (estándar, hasta 4000000)
+ * - --bits N: bits de datos (5 a 8)
+ * - --paridad N|E|O: paridad
+ * - --parada 1|2: bits de parada
+ * - --flujo ninguno|hw|sw: control de flujo
+ * - --vmin N, --vtime N: política de lectura de termios
+ * - --crudo: configurar el puerto a partir de cfmakeraw()
+ * - -p, --puerto RUTA: puerto serial (sin preguntarlo)
+ * - -P, --puertos A,B,...: decodificar varios puertos a la vez con epoll
+ * - --pipeline: lectura, decodificación y salida en hilos separados
+ * - --desborde bloquear|descartar: política de las colas del pipeline
+ * - --capacidad-cola N: elementos por cola del pipeline
+ * - -d, --decodificar ARCHIVO: decodificar una captura en paralelo, sin puerto
+ * - -o, --destino ARCHIVO: archivo del mensaje decodificado
+ * - --hilos N: hilos de la decodificación fuera de línea
+ * - -r, --reproducir ARCHIVO: usar una captura grabada en lugar del puerto
+ * - -s, --salida detallada|silenciosa|incremental|periodica: modo de salida
+ * - --intervalo MS: período de las líneas de progreso
+ * - --alfabeto mayusculas|alfanumerico|imprimible|bytes: alfabeto del rotor
+ * - --rotores ESPEC: cascada de rotores (ver RotorDeMapeo::configurarCascada())
+ * - --estado BASE: puntos de control y diario de tramas para reanudar (ver PuntoDeControl)
+ * - --sincronizar trama|lote|nunca: cuándo llevar el diario al disco
+ * - --lote-diario N: tramas por bloque del diario
+ * - --punto-cada N: tramas entre puntos de control
+ * - --mensajes ARCHIVO: separar el flujo en mensajes por tramas FIN (ver SumideroDeMensajes)
+ * - --ventana N: caracteres del mensaje abierto que se retienen en memoria
+ * - --fin TEXTO: línea que cierra un mensaje
+ * - --bitacora apagada|resumen|trama|depuracion: nivel de la bitácora (ver Bitacora)
+ * - --archivo-bitacora ARCHIVO: destino de la bitácora
+ * - --inactividad MS: tiempo sin datos tras el que termina un flujo (0 = sin límite)
+ * - --desatendido: sin banner ni preguntas, para correr como servicio
+ * - -h, --ayuda: mostrar la ayuda
+ * 
+ * Los mensajes de error se imprimen en stderr.
+ * 
+ * @param argc Número de argumentos
+ * @param argv Argumentos del programa
+ * @param opciones Estructura donde se guardan las opciones
+ * @return Resultado de la interpretación
+ */
+ResultadoOpciones parsearOpciones(int argc, char* argv[], OpcionesDecodificador* opciones);
+
+/**
+ * @brief Imprime la ayuda de la línea de comandos
+ * @param programa Nombre del ejecutable (argv[0])
+ */
+void imprimirAyuda(const char* programa);
+
+#endif // OPCIONES_H
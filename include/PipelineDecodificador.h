@@ -0,0 +1,242 @@
+/**
+ * @file PipelineDecodificador.h
+ * @brief Decodificación en tres hilos: lectura, decodificación y salida
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef PIPELINE_DECODIFICADOR_H
+#define PIPELINE_DECODIFICADOR_H
+
+#include "FuenteDeLineas.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "ColaSPSC.h"
+#include "LatenciasDeTramas.h"
+#include <atomic>
+
+class PuntoDeControl;
+class SumideroDeMensajes;
+class Bitacora;
+
+/// Bytes de una línea que viajan dentro de la cola (las más largas van aparte)
+const int TAM_LINEA_PIPELINE = 256;
+
+/// Bytes máximos de un fragmento de salida entre el decodificador y la salida
+const int TAM_FRAGMENTO_SALIDA = 1024;
+
+/// Bytes iniciales del anillo de desborde para las líneas largas
+const int TAM_DESBORDE_PIPELINE = 1 << 20;
+
+/**
+ * @struct LineaPipeline
+ * @brief Copia de una línea leída de la fuente (longitud 0 = línea vacía)
+ * 
+ * Las líneas de hasta TAM_LINEA_PIPELINE bytes se copian en 'datos'. Las
+ * más largas (un BULK extenso, o uno binario de hasta MAX_TRAMA_BINARIA
+ * bytes) se copian contiguas al anillo de desborde del pipeline, que el
+ * decodificador libera hasta 'finLarga' al procesarla: la cola no crece
+ * por ellas, la línea llega entera y no se pide memoria por línea.
+ */
+struct LineaPipeline {
+    int longitud;                       ///< Bytes de la línea
+    long long llegadaNs;                ///< Llegada en la fuente (ver VistaLinea)
+    const char* larga;                  ///< Línea larga dentro del anillo de desborde (nullptr = está en 'datos')
+    size_t finLarga;                    ///< Posición lógica del anillo tras la línea larga
+    char datos[TAM_LINEA_PIPELINE];     ///< Contenido de una línea corta
+};
+
+/**
+ * @struct FragmentoSalida
+ * @brief Caracteres recién decodificados que la etapa de salida debe escribir
+ */
+struct FragmentoSalida {
+    int longitud;                       ///< Bytes válidos de 'datos'
+    char datos[TAM_FRAGMENTO_SALIDA];   ///< Caracteres decodificados
+};
+
+/**
+ * @class PipelineDecodificador
+ * @brief Separa la lectura serial de la decodificación y de la escritura
+ * 
+ * Etapas (un hilo cada una), conectadas por colas ColaSPSC acotadas:
+ * 1. Lector: lee líneas de la fuente y las copia a la cola de líneas.
+ * 2. Decodificador: parsea y procesa las líneas sobre la lista y el rotor,
+ *    y envía los caracteres nuevos a la cola de salida.
+ * 3. Salida: escribe los caracteres en stdout con escritura en bloque.
+ * 
+ * Un printf lento hacia una terminal o tubería ya no detiene la lectura del
+ * puerto. Cuando una cola se llena, la política de desborde decide si el
+ * productor espera (BLOQUEAR) o descarta el elemento y lo cuenta
+ * (DESCARTAR); en ningún caso hay pérdidas silenciosas.
+ */
+class PipelineDecodificador {
+private:
+    FuenteDeLineas* fuente;                 ///< Puerto serial o captura
+    ListaDeCarga* carga;                    ///< Mensaje decodificado
+    RotorDeMapeo* rotor;                    ///< Rotor del flujo
+    PoliticaDesborde politica;              ///< Comportamiento con colas llenas
+    LatenciasDeTramas* latencias;           ///< Histogramas (nullptr = sin medir)
+    PuntoDeControl* puntoDeControl;         ///< Diario y puntos de control (nullptr = sin guardar)
+    SumideroDeMensajes* sumidero;           ///< Destino de los mensajes cerrados (nullptr = sin segmentar)
+    Bitacora* bitacora;                     ///< Eventos del hilo decodificador (nullptr = sin bitácora)
+    int inactividadMs;                      ///< Silencio tras el que el lector termina (0 = sin límite)
+    bool desatendido;                       ///< Sin encabezado; la parada se avisa en stderr
+    
+    ColaSPSC<LineaPipeline> colaLineas;     ///< Lector -> decodificador
+    ColaSPSC<FragmentoSalida> colaSalida;   ///< Decodificador -> salida
+    
+    // Anillo de desborde: el lector escribe las líneas largas en orden y el
+    // decodificador libera hasta el final de cada una al procesarla
+    char* desborde;                         ///< Bytes de las líneas largas
+    size_t tamDesborde;                     ///< Capacidad del anillo
+    size_t desbordeEscrito;                 ///< Fin lógico de lo escrito (solo el lector)
+    char relleno[64];                       ///< Separa los dos índices en líneas de caché
+    std::atomic<size_t> desbordeLiberado;   ///< Fin lógico de lo ya decodificado (solo el decodificador)
+    
+    int tramasProcesadas;                   ///< Tramas válidas procesadas
+    int tramasInvalidas;                    ///< Líneas rechazadas por el parser
+    long lineasDescartadas;                 ///< Líneas perdidas por cola llena
+    long lineasLargas;                      ///< Líneas más largas que TAM_LINEA_PIPELINE (en el anillo)
+    int crecimientosDesborde;               ///< Veces que una línea no cupo en el anillo entero
+    long caracteresDescartados;             ///< Salida perdida por cola llena
+    size_t profundidadMaximaLineas;         ///< Mayor ocupación vista en la cola de líneas
+    size_t profundidadMaximaSalida;         ///< Mayor ocupación vista en la cola de salida
+    
+    /**
+     * @brief Etapa 1: lee líneas de la fuente hasta el fin del flujo
+     */
+    void hiloLector();
+    
+    /**
+     * @brief Etapa 2: decodifica las líneas de la cola
+     */
+    void hiloDecodificador();
+    
+    /**
+     * @brief Etapa 3: escribe los fragmentos decodificados
+     */
+    void hiloSalida();
+    
+    /**
+     * @brief Envía a la etapa de salida los caracteres decodificados desde 'emitidos'
+     * @param emitidos Posición absoluta del siguiente carácter a enviar (se actualiza)
+     */
+    void emitirNuevos(long long* emitidos);
+    
+    /**
+     * @brief Reserva bytes contiguos en el anillo de desborde (solo el lector)
+     * 
+     * Si la línea no cabe antes del final del anillo, empieza de nuevo en
+     * su inicio y el resto queda sin usar hasta la vuelta siguiente. Con
+     * el anillo lleno espera o falla según la política de desborde. Una
+     * línea mayor que el anillo entero espera a que se vacíe y lo agranda:
+     * es la única asignación después del constructor.
+     * 
+     * @param bytes Longitud de la línea
+     * @param fin Posición lógica tras la línea, para liberarla
+     * @return Destino de la copia, o nullptr si se debe descartar
+     */
+    char* reservarDesborde(int bytes, size_t* fin);
+    
+    // No copiable: contiene las colas
+    PipelineDecodificador(const PipelineDecodificador&);
+    PipelineDecodificador& operator=(const PipelineDecodificador&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param fuenteLineas Puerto ya abierto o captura
+     * @param cargaDestino Lista donde se acumula el mensaje
+     * @param rotorFlujo Rotor del flujo
+     * @param capacidadCola Elementos de cada cola
+     * @param politicaDesborde Comportamiento cuando una cola se llena
+     */
+    PipelineDecodificador(FuenteDeLineas* fuenteLineas, ListaDeCarga* cargaDestino,
+                          RotorDeMapeo* rotorFlujo, int capacidadCola = CAPACIDAD_COLA_DEFECTO,
+                          PoliticaDesborde politicaDesborde = DESBORDE_BLOQUEAR);
+    
+    /**
+     * @brief Destructor - Libera el anillo de desborde
+     */
+    ~PipelineDecodificador();
+    
+    /**
+     * @brief Ejecuta las tres etapas hasta el fin del flujo
+     * @return Número de tramas procesadas
+     */
+    int ejecutar();
+    
+    /**
+     * @brief Activa la medición de latencias en el hilo decodificador
+     * 
+     * La salida se considera emitida cuando el fragmento se entrega a la
+     * cola del hilo de salida. Debe llamarse antes de ejecutar().
+     * 
+     * @param destino Histogramas donde registrar (nullptr para desactivar)
+     */
+    void establecerLatencias(LatenciasDeTramas* destino) { latencias = destino; }
+    
+    /**
+     * @brief Anota las tramas del hilo decodificador en el diario
+     * 
+     * Debe llamarse antes de ejecutar().
+     * 
+     * @param destino Punto de control ya recuperado (nullptr para desactivar)
+     */
+    void establecerPuntoDeControl(PuntoDeControl* destino) { puntoDeControl = destino; }
+    
+    /**
+     * @brief Entrega a un sumidero cada mensaje cerrado por una trama FIN
+     * 
+     * El hilo decodificador reconoce el delimitador del sumidero. Debe
+     * llamarse antes de ejecutar().
+     * 
+     * @param destino Sumidero de mensajes (nullptr para desactivar)
+     */
+    void establecerSumidero(SumideroDeMensajes* destino) { sumidero = destino; }
+    
+    /**
+     * @brief Anota en una bitácora las tramas del hilo decodificador
+     * 
+     * El hilo decodificador es el único que anota. Debe llamarse antes de
+     * ejecutar().
+     * 
+     * @param destino Bitácora ya iniciada (nullptr para desactivar)
+     */
+    void establecerBitacora(Bitacora* destino) { bitacora = destino; }
+    
+    /**
+     * @brief Fija el tiempo sin datos tras el que el lector da el flujo por terminado
+     * 
+     * El lector también termina cuando se pide la parada (ControlDeParada);
+     * las etapas siguientes vacían sus colas antes de salir. Debe llamarse
+     * antes de ejecutar().
+     * 
+     * @param plazoMs Milisegundos sin datos (0 = esperar sin límite)
+     */
+    void establecerInactividad(int plazoMs) { inactividadMs = plazoMs; }
+    
+    /**
+     * @brief Activa el modo desatendido: el mensaje sin encabezado ni descripción del pipeline
+     * 
+     * El aviso de parada por señal va a stderr, para no mezclarse con el
+     * mensaje. Debe llamarse antes de ejecutar().
+     * 
+     * @param activar true para omitir el encabezado
+     */
+    void establecerDesatendido(bool activar) { desatendido = activar; }
+    
+    /**
+     * @brief Imprime los contadores de descarte y de ocupación de las colas
+     */
+    void imprimirEstadisticas() const;
+    
+    /**
+     * @brief Obtiene el número de líneas rechazadas por el parser
+     * @return Tramas inválidas
+     */
+    int obtenerTramasInvalidas() const { return tramasInvalidas; }
+};
+
+#endif // PIPELINE_DECODIFICADOR_H
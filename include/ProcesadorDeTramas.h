@@ -0,0 +1,234 @@
+/**
+ * @file ProcesadorDeTramas.h
+ * @brief Decodificación de líneas PRT-7 sobre una lista de carga y un rotor
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef PROCESADOR_DE_TRAMAS_H
+#define PROCESADOR_DE_TRAMAS_H
+
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "LoteDeCarga.h"
+#include "ArenaDeTramas.h"
+#include "RegistroDeTramas.h"
+#include "LatenciasDeTramas.h"
+#include "Bitacora.h"
+
+class PuntoDeControl;
+class SumideroDeMensajes;
+
+/// Tramas con efecto aplicado que pueden esperar a la salida antes de medirse
+const int CAPACIDAD_PENDIENTES_SALIDA = 2 * CAPACIDAD_LOTE;
+
+/**
+ * @struct LatenciaPendiente
+ * @brief Trama ya aplicada cuya salida aún no se ha emitido
+ */
+struct LatenciaPendiente {
+    long long llegada;   ///< Llegada del último byte (ns)
+    long long aplicada;  ///< Momento en que el efecto llegó a la lista o al rotor (ns)
+    TipoLatencia tipo;   ///< Familia de la trama
+};
+
+/**
+ * @class ProcesadorDeTramas
+ * @brief Lleva una línea recibida desde el parseo hasta la lista de carga
+ * 
+ * Agrupa el estado de decodificación de un flujo: el lote de tramas LOAD
+ * pendientes y la arena donde se construye la trama de cada línea. La lista
+ * de carga y el rotor pertenecen al llamador, de modo que cada puerto o
+ * fuente puede tener su propio par independiente.
+ * 
+ * Con un SumideroDeMensajes, lo que el procesador le entrega se descarta
+ * de la lista al procesar la línea siguiente (o en salidaEmitida()), para
+ * que la salida del llamador alcance a emitirlo antes.
+ */
+class ProcesadorDeTramas {
+private:
+    ListaDeCarga* carga;                ///< Lista donde se acumula el mensaje
+    RotorDeMapeo* rotor;                ///< Rotor de este flujo
+    const RegistroDeTramas* registro;   ///< Fábricas de tramas por byte de tipo
+    LoteDeCarga lote;                   ///< Racha de tramas LOAD aún sin decodificar
+    ArenaDeTramas arena;                ///< Memoria reutilizada para la trama de cada línea
+    bool detallado;                     ///< Imprimir una línea por trama
+    int tramasProcesadas;               ///< Tramas válidas procesadas
+    int tramasInvalidas;                ///< Líneas rechazadas por el parser
+    
+    LatenciasDeTramas* latencias;       ///< Histogramas (nullptr = sin medir)
+    long long* llegadasLote;            ///< Llegada de cada LOAD del lote
+    LatenciaPendiente* pendientesSalida; ///< Tramas aplicadas esperando la salida
+    int numPendientesSalida;            ///< Entradas usadas de pendientesSalida
+    
+    PuntoDeControl* puntoDeControl;     ///< Diario y puntos de control (nullptr = sin guardar)
+    
+    SumideroDeMensajes* sumidero;       ///< Destino de los mensajes (nullptr = la lista crece sin límite)
+    int entregados;                     ///< Caracteres del principio de la lista ya entregados al sumidero
+    
+    Bitacora* bitacora;                 ///< Registro de eventos (nullptr = sin bitácora)
+    NivelBitacora nivelBitacora;        ///< Nivel de 'bitacora' (BITACORA_APAGADA sin ella)
+    int flujoBitacora;                  ///< Flujo con el que se anotan los eventos
+    
+    /**
+     * @brief Entrega al sumidero el mensaje en curso y empieza uno nuevo con el rotor reiniciado
+     */
+    void cerrarMensaje();
+    
+    /**
+     * @brief Quita de la lista lo ya entregado al sumidero
+     */
+    void descartarEntregados() {
+        if (entregados > 0) {
+            carga->descartarPrincipio(entregados);
+            entregados = 0;
+        }
+    }
+    
+    /**
+     * @brief Registra la etapa de decodificación y deja la trama esperando la salida
+     */
+    void anotarAplicada(long long llegada, TipoLatencia tipo, long long ahora);
+    
+    // No copiable: contiene el lote y la arena
+    ProcesadorDeTramas(const ProcesadorDeTramas&);
+    ProcesadorDeTramas& operator=(const ProcesadorDeTramas&);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param cargaDestino Lista donde se insertan los caracteres decodificados
+     * @param rotorFlujo Rotor usado para decodificar
+     * @param registroTramas Registro de tipos de trama (compartible entre procesadores)
+     * @param modoDetallado true para imprimir una línea por trama
+     */
+    ProcesadorDeTramas(ListaDeCarga* cargaDestino, RotorDeMapeo* rotorFlujo,
+                       const RegistroDeTramas* registroTramas, bool modoDetallado = true);
+    
+    /**
+     * @brief Destructor - Libera los registros de latencia
+     */
+    ~ProcesadorDeTramas();
+    
+    /**
+     * @brief Activa la medición de latencias por trama
+     * @param destino Histogramas donde registrar (nullptr para desactivar);
+     *                debe vivir más que el procesador
+     */
+    void establecerLatencias(LatenciasDeTramas* destino);
+    
+    /**
+     * @brief Anota cada trama válida en el diario y guarda puntos de control
+     * @param destino Punto de control ya recuperado (nullptr para desactivar);
+     *                debe vivir más que el procesador
+     */
+    void establecerPuntoDeControl(PuntoDeControl* destino) { puntoDeControl = destino; }
+    
+    /**
+     * @brief Entrega los mensajes a un sumidero y acota la lista a su ventana
+     * 
+     * Las tramas FIN cierran el mensaje en curso y reinician el rotor; sin
+     * sumidero no tienen efecto. El registro debe reconocer el mismo
+     * delimitador que el sumidero.
+     * 
+     * @param destino Sumidero de mensajes (nullptr para desactivar);
+     *                debe vivir más que el procesador
+     */
+    void establecerSumidero(SumideroDeMensajes* destino) { sumidero = destino; }
+    
+    /**
+     * @brief Anota en una bitácora las tramas y los eventos de este flujo
+     * 
+     * Con el nivel apagado (o sin bitácora) el procesador no anota nada;
+     * en los demás cada evento cuesta un registro en la cola de la bitácora.
+     * 
+     * @param destino Bitácora ya iniciada (nullptr para desactivar); debe
+     *                vivir más que el procesador
+     * @param flujo Identificador de este flujo en los registros (0 si hay uno solo)
+     */
+    void establecerBitacora(Bitacora* destino, int flujo = 0) {
+        bitacora = destino;
+        nivelBitacora = destino ? destino->obtenerNivel() : BITACORA_APAGADA;
+        flujoBitacora = flujo;
+    }
+    
+    /**
+     * @brief Anota en la bitácora que la fuente no tiene datos por ahora
+     */
+    void anotarPausa() {
+        if (nivelBitacora >= BITACORA_DEPURACION) {
+            bitacora->anotar(EVENTO_PAUSA, flujoBitacora, tramasProcesadas, 0);
+        }
+    }
+    
+    /**
+     * @brief Anota en la bitácora los totales del flujo al terminar
+     */
+    void anotarFinDeFlujo() {
+        if (nivelBitacora >= BITACORA_RESUMEN) {
+            bitacora->anotar(EVENTO_FIN_FLUJO, flujoBitacora, tramasProcesadas, tramasInvalidas);
+        }
+    }
+    
+    /**
+     * @brief Parsea y procesa una línea recibida
+     * 
+     * Las tramas LOAD se acumulan en el lote; cualquier otra trama vacía
+     * antes el lote para que se decodifique con la rotación vigente.
+     * 
+     * @param linea Línea recibida (no necesita terminar en '\0')
+     * @param longitud Número de bytes de la línea
+     * @param llegadaNs Instante de llegada (relojNs()); 0 = tomar el actual.
+     *                  Solo se usa si las latencias están activas
+     */
+    void procesarLinea(const char* linea, int longitud, long long llegadaNs = 0);
+    
+    /**
+     * @brief Decodifica las tramas LOAD pendientes del lote
+     * 
+     * Debe llamarse al terminar el flujo y cuando se quiera ver el mensaje
+     * parcial al día (por ejemplo, en una línea vacía).
+     */
+    void vaciarPendientes();
+    
+    /**
+     * @brief Indica que lo aplicado hasta ahora ya se emitió por la salida
+     * 
+     * Descarta de la lista lo ya entregado al sumidero, cierra la medición
+     * de las tramas aplicadas desde la llamada anterior y atiende una
+     * petición de informe pendiente (SIGUSR1) imprimiéndolo en stderr.
+     */
+    void salidaEmitida();
+    
+    /**
+     * @brief Indica si hay que emitir la salida antes de seguir midiendo
+     * @return true si no caben más tramas esperando la salida
+     */
+    bool salidaPendienteLlena() const {
+        return numPendientesSalida >= CAPACIDAD_PENDIENTES_SALIDA - CAPACIDAD_LOTE - 1;
+    }
+    
+    /**
+     * @brief Indica si la próxima línea descartará caracteres de la lista
+     * 
+     * Quien emite la lista por su cuenta debe hacerlo antes de procesar
+     * otra línea (o llamar a salidaEmitida() después de emitir).
+     * 
+     * @return true si hay caracteres entregados al sumidero aún en la lista
+     */
+    bool hayDescartePendiente() const { return entregados > 0; }
+    
+    /**
+     * @brief Obtiene el número de tramas válidas procesadas
+     * @return Tramas procesadas
+     */
+    int obtenerTramasProcesadas() const { return tramasProcesadas; }
+    
+    /**
+     * @brief Obtiene el número de líneas rechazadas por el parser
+     * @return Tramas inválidas
+     */
+    int obtenerTramasInvalidas() const { return tramasInvalidas; }
+};
+
+#endif // PROCESADOR_DE_TRAMAS_H
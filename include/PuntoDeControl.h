@@ -0,0 +1,198 @@
+/**
+ * @file PuntoDeControl.h
+ * @brief Puntos de control del estado de decodificación para reanudar tras una caída
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * El estado se guarda en cuatro archivos con el mismo prefijo:
+ *
+ *   BASE.ckpt     Registro fijo: posiciones del rotor, generación, ranura y
+ *                 longitud confirmada del mensaje (se reemplaza con rename())
+ *   BASE.carga.0  Mensaje decodificado en dos ranuras alternas: mientras el
+ *   BASE.carga.1  mensaje solo crece, cada punto de control anexa los
+ *                 caracteres nuevos a la ranura vigente; cuando su principio
+ *                 se entrega a un SumideroDeMensajes, lo que queda se escribe
+ *                 en la otra ranura, y la vigente sigue valiendo hasta que
+ *                 el registro nuevo la reemplaza
+ *   BASE.diario   Tramas aplicadas desde el último punto de control (DiarioDeTramas)
+ *
+ * Recuperar es leer el registro, cargar el mensaje confirmado y reaplicar
+ * el diario, que nunca tiene más de --punto-cada tramas.
+ */
+
+#ifndef PUNTO_DE_CONTROL_H
+#define PUNTO_DE_CONTROL_H
+
+#include "DiarioDeTramas.h"
+#include "RotorGenerico.h"
+
+class ListaDeCarga;
+class RotorDeMapeo;
+class SumideroDeMensajes;
+
+/// Tramas entre dos puntos de control por defecto
+const int TRAMAS_POR_PUNTO_DEFECTO = 100000;
+
+/**
+ * @class PuntoDeControl
+ * @brief Guarda y recupera el rotor y el mensaje de un flujo
+ *
+ * El procesador anota cada trama válida; cuando anotar() devuelve true
+ * hay que guardar un punto de control con el estado al día. Un punto de
+ * control cuesta lo que los caracteres nuevos más un registro fijo, y
+ * vacía el diario.
+ *
+ * Orden de escritura (lo que hace segura una caída en cualquier momento):
+ * 1. Caracteres nuevos al final de la ranura vigente (o el mensaje
+ *    pendiente entero en la otra) y fdatasync()
+ * 2. Registro nuevo en BASE.ckpt.tmp, fsync() y rename() sobre BASE.ckpt
+ * 3. Diario vaciado con la generación nueva: un diario de la generación
+ *    anterior ya está incluido en el registro y se ignora al recuperar
+ *
+ * Con un sumidero, el registro guarda también el tamaño del archivo de
+ * mensajes. Al recuperar, el archivo se recorta a ese tamaño y el diario
+ * vuelve a escribir los mensajes que cerró, así que cada mensaje queda
+ * escrito una sola vez (con stdout, que no se puede recortar, los cerrados
+ * después del último punto de control pueden repetirse).
+ */
+class PuntoDeControl {
+private:
+    char* rutaPunto;                    ///< BASE.ckpt
+    char* rutaTemporal;                 ///< BASE.ckpt.tmp
+    char* rutasCarga[2];                ///< BASE.carga.0 y BASE.carga.1
+    char* rutaDiario;                   ///< BASE.diario
+    char* directorio;                   ///< Directorio de los archivos (para sincronizar el rename())
+
+    DiarioDeTramas diario;              ///< Tramas desde el último punto de control
+    int descriptorCarga;                ///< Ranura vigente abierta para anexar (-1 si está cerrada)
+    int ranura;                         ///< Ranura del mensaje confirmado (0 o 1)
+
+    TipoAlfabeto alfabeto;              ///< Alfabeto con el que se decodifica
+    unsigned int huellaConfiguracion;   ///< Suma de la cascada y la segmentación (0 sin ninguna)
+    SumideroDeMensajes* sumidero;       ///< Destino de los mensajes (nullptr = sin segmentar)
+
+    unsigned long long generacion;      ///< Generación del último punto de control
+    long long inicioMensaje;            ///< Posición absoluta en la lista del primer carácter de la ranura
+    long long caracteresGuardados;      ///< Caracteres del mensaje confirmados en la ranura
+    long long tramasGuardadas;          ///< Tramas incluidas en el último punto de control
+
+    int tramasPorPunto;                 ///< Tramas entre puntos de control
+    long long tramasDiario;             ///< Tramas anotadas en el diario actual
+    long long proximoPunto;             ///< Valor de tramasDiario que dispara el siguiente punto
+
+    // No copiable: es dueño de los descriptores y las rutas
+    PuntoDeControl(const PuntoDeControl&);
+    PuntoDeControl& operator=(const PuntoDeControl&);
+
+    /**
+     * @brief Abre una ranura del mensaje para anexar
+     * @param indice Ranura (0 o 1)
+     * @param vaciar Recortarla a 0 bytes
+     * @return Descriptor, o -1 si no se pudo abrir
+     */
+    int abrirRanura(int indice, bool vaciar);
+
+    /**
+     * @brief Anexa los caracteres [desde, tamaño) de la lista a una ranura y la sincroniza
+     */
+    bool guardarCarga(int descriptor, const char* ruta, const ListaDeCarga& carga, int desde);
+
+    /**
+     * @brief Escribe el registro de la generación siguiente y lo publica con rename()
+     * @param rotor Rotor a guardar
+     * @param ranuraMensaje Ranura con el mensaje confirmado
+     * @param caracteres Caracteres del mensaje en la ranura
+     * @param posicionMensajes Tamaño del archivo de mensajes (-1 sin archivo)
+     */
+    bool escribirRegistro(const RotorDeMapeo& rotor, int ranuraMensaje, long long caracteres,
+                          long long posicionMensajes);
+
+    /**
+     * @brief Guarda el mensaje pendiente y el registro, sin tocar el diario
+     */
+    bool guardarEstado(const ListaDeCarga& carga, const RotorDeMapeo& rotor, int entregados);
+
+public:
+    /**
+     * @brief Constructor - Aún no abre ningún archivo (ver recuperar())
+     * @param base Prefijo de los archivos de estado
+     * @param tipoAlfabeto Alfabeto del rotor
+     * @param rotores Especificación de la cascada (nullptr = un rotor)
+     * @param politica Política de sincronización del diario
+     * @param tramasLote Tramas por bloque del diario
+     * @param tramasEntrePuntos Tramas entre dos puntos de control
+     */
+    PuntoDeControl(const char* base, TipoAlfabeto tipoAlfabeto, const char* rotores,
+                   PoliticaSincronizacion politica, int tramasLote, int tramasEntrePuntos);
+
+    /**
+     * @brief Destructor - Cierra los archivos (no guarda: ver guardar())
+     */
+    ~PuntoDeControl();
+
+    /**
+     * @brief Guarda también el archivo de mensajes y la segmentación por FIN
+     *
+     * Debe llamarse antes de recuperar(): el diario se reaplica sobre el
+     * mismo sumidero, con su delimitador y su ventana.
+     *
+     * @param destino Sumidero de mensajes (nullptr = sin segmentar); debe
+     *                vivir más que el punto de control
+     */
+    void establecerSegmentacion(SumideroDeMensajes* destino);
+
+    /**
+     * @brief Restaura el estado guardado y deja el diario listo para anotar
+     *
+     * Sin estado previo empieza uno vacío. Si hubo tramas en el diario, el
+     * estado recuperado se guarda enseguida en un punto de control nuevo.
+     * Los errores y el resumen de lo recuperado se describen en stderr.
+     *
+     * @param carga Lista vacía donde cargar el mensaje
+     * @param rotor Rotor recién configurado (alfabeto y cascada)
+     * @return false si el estado está dañado, fue guardado con otra
+     *         configuración del rotor o no se pudo escribir
+     */
+    bool recuperar(ListaDeCarga* carga, RotorDeMapeo* rotor);
+
+    /**
+     * @brief Anota una trama válida ya aplicada
+     * @param trama Bytes de la trama
+     * @param longitud Número de bytes
+     * @return true si toca guardar un punto de control
+     */
+    bool anotar(const char* trama, int longitud) {
+        diario.anotar(trama, longitud);
+        return ++tramasDiario >= proximoPunto;
+    }
+
+    /**
+     * @brief Guarda un punto de control y vacía el diario
+     *
+     * El estado debe incluir todas las tramas anotadas (sin tramas LOAD
+     * pendientes en el lote del procesador).
+     *
+     * @param carga Lista del mensaje
+     * @param rotor Rotor del flujo
+     * @param entregados Caracteres del principio de la lista ya entregados
+     *        al sumidero (no forman parte del mensaje pendiente)
+     * @return false si no se pudo escribir (el punto de control anterior y
+     *         el diario siguen siendo válidos)
+     */
+    bool guardar(const ListaDeCarga& carga, const RotorDeMapeo& rotor, int entregados = 0);
+
+    /**
+     * @brief Escribe al diario las tramas del bloque en curso
+     *
+     * Para cuando el flujo queda inactivo: sincroniza solo si la política
+     * y el intervalo lo piden.
+     */
+    void escribirPendientes() { diario.escribirBloque(); }
+
+    /**
+     * @brief Obtiene las tramas incluidas en el último punto de control
+     */
+    long long obtenerTramasGuardadas() const { return tramasGuardadas; }
+};
+
+#endif // PUNTO_DE_CONTROL_H
@@ -0,0 +1,124 @@
+/**
+ * @file RegistroDeTramas.h
+ * @brief Registro de tipos de trama indexado por el byte de tipo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef REGISTRO_DE_TRAMAS_H
+#define REGISTRO_DE_TRAMAS_H
+
+#include "TramaBase.h"
+#include "ArenaDeTramas.h"
+
+/// Línea que cierra un mensaje por defecto (TramaFin)
+const char* const DELIMITADOR_FIN_DEFECTO = "FIN";
+
+/// Longitud máxima del delimitador de mensajes
+const int LONGITUD_MAX_DELIMITADOR = 31;
+
+/**
+ * @brief Firma de las funciones que construyen una trama a partir de su dato
+ * 
+ * @param dato Texto que sigue a la coma de la línea ("X" en "L,X")
+ * @param longitud Número de bytes de 'dato' (puede ser 0)
+ * @param arena Arena donde se construye la trama
+ * @return Trama construida, o nullptr si el dato es inválido
+ */
+typedef TramaBase* (*FabricaTrama)(const char* dato, int longitud, ArenaDeTramas* arena);
+
+/**
+ * @class RegistroDeTramas
+ * @brief Tabla de fábricas de tramas indexada por el primer byte de la línea
+ * 
+ * Sustituye la cadena de if/else sobre el tipo de trama por un salto directo
+ * a través de una tabla de 256 entradas. Cada tipo de trama registra su
+ * fábrica una sola vez; agregar un tipo nuevo no toca el bucle principal.
+ * 
+ * Tipos registrados por defecto (mayúsculas y minúsculas):
+ * - 'L': TramaLoad  (L,X)
+ * - 'M': TramaMap   (M,N)
+ * - 'B': TramaBulk  (B,TEXTO)
+ * - 'S': TramaSeleccion (S,I)
+ * - 'R': TramaRotor (R,I,N)
+ * - TramaFin: la línea exacta del delimitador ("FIN" por defecto)
+ * - 0xA1 a 0xA6: las mismas tramas en formato binario (FormatoBinario.h)
+ */
+class RegistroDeTramas {
+private:
+    FabricaTrama fabricas[256]; ///< Fábrica por byte de tipo (nullptr si no existe)
+    bool advertencias;          ///< Imprimir las líneas rechazadas
+    char delimitador[LONGITUD_MAX_DELIMITADOR + 1]; ///< Línea de la trama FIN
+    int longitudDelimitador;    ///< Bytes de 'delimitador'
+    
+public:
+    /**
+     * @brief Constructor - Registra los tipos de trama del protocolo PRT-7
+     */
+    RegistroDeTramas();
+    
+    /**
+     * @brief Registra (o reemplaza) la fábrica de un tipo de trama
+     * @param tipo Byte de tipo (primer carácter de la línea)
+     * @param fabrica Función que construye la trama
+     */
+    void registrar(unsigned char tipo, FabricaTrama fabrica);
+    
+    /**
+     * @brief Verifica si existe una fábrica para un byte de tipo
+     * @param tipo Byte de tipo
+     * @return true si el tipo está registrado
+     */
+    bool estaRegistrado(unsigned char tipo) const { return fabricas[tipo] != nullptr; }
+    
+    /**
+     * @brief Activa o desactiva las advertencias sobre líneas rechazadas
+     * 
+     * Útil cuando varios hilos parsean la misma captura o cuando quien
+     * llama ya cuenta las tramas inválidas por su cuenta.
+     * 
+     * @param activas true para imprimir las advertencias (por defecto)
+     */
+    void establecerAdvertencias(bool activas) { advertencias = activas; }
+    
+    /**
+     * @brief Cambia la línea que se reconoce como trama FIN
+     * 
+     * La comparación es exacta (mayúsculas incluidas) y se hace antes de
+     * buscar el tipo, así que el delimitador puede empezar por cualquier byte.
+     * 
+     * @param texto Delimitador de 1 a LONGITUD_MAX_DELIMITADOR bytes de texto
+     *        (se trunca si es más largo)
+     */
+    void establecerDelimitador(const char* texto);
+    
+    /**
+     * @brief Parsea una línea recibida y crea la trama correspondiente
+     * 
+     * El formato esperado es "T,DATO", donde T es el byte de tipo, o una
+     * trama binaria completa cuyo primer byte es una etiqueta >= 0x80. La trama
+     * se construye dentro de la arena, sin usar el heap. El llamador debe
+     * destruirla con ArenaDeTramas::destruir() tras procesarla.
+     * 
+     * @param linea Línea recibida (no necesita terminar en '\0')
+     * @param longitud Número de bytes de la línea
+     * @param arena Arena donde se construye la trama
+     * @return Puntero a TramaBase, o nullptr si el formato es inválido
+     */
+    TramaBase* parsear(const char* linea, int longitud, ArenaDeTramas* arena) const;
+};
+
+/**
+ * @brief Convierte texto decimal a entero con las reglas de atoi()
+ * 
+ * Acepta espacios iniciales y signo opcional, y se detiene en el primer
+ * carácter no numérico sin requerir el terminador '\0'. El valor se satura
+ * en lugar de desbordarse.
+ * 
+ * @param texto Texto a convertir
+ * @param longitud Número de bytes disponibles
+ * @return Valor convertido (0 si no hay dígitos)
+ */
+int enteroDesdeTexto(const char* texto, int longitud);
+
+#endif // REGISTRO_DE_TRAMAS_H
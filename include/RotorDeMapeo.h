@@ -8,12 +8,21 @@
 #ifndef ROTOR_DE_MAPEO_H
 #define ROTOR_DE_MAPEO_H
 
+#include <cstddef>  // Para size_t
+#include "RotorGenerico.h"
+
+/// Número de símbolos del alfabeto por defecto del rotor (A-Z)
+const int TAMANIO_ALFABETO = AlfabetoMayusculas::TAMANIO;
+
+/// Rotores máximos de una cascada
+const int MAX_ROTORES_CASCADA = 8;
+
 /**
  * @struct NodoRotor
  * @brief Nodo de la lista circular doblemente enlazada
  */
 struct NodoRotor {
-    char dato;              ///< Carácter almacenado (A-Z)
+    char dato;              ///< Símbolo almacenado (A-Z con el alfabeto por defecto)
     NodoRotor* siguiente;   ///< Puntero al siguiente nodo
     NodoRotor* previo;      ///< Puntero al nodo anterior
     
@@ -41,32 +50,106 @@ struct NodoRotor {
  * Ejemplo:
  * Estado inicial: A B C D E F ... (cabeza en A)
  * Rotar +2:       C D E F G H ... (cabeza en C, ahora A->C, B->D, etc.)
+ *
+ * Motor de rotación O(1):
+ * - Además de la lista, el rotor guarda el desplazamiento entero de 'cabeza'
+ *   respecto al primer símbolo y un arreglo con los nodos indexados por posición.
+ * - En la construcción se copia a una tabla de traducción de tamanio x 256 el
+ *   mapeo de RotorGenerico para el alfabeto elegido, y rotar() mantiene un
+ *   puntero a la fila vigente: getMapeo() es una sola consulta, sin ramas
+ *   según el alfabeto.
+ *
+ * Alfabetos:
+ * - El alfabeto por defecto es A-Z (ALFABETO_MAYUSCULAS), el del protocolo
+ *   original; también se admiten alfanumérico, ASCII imprimible y los 256
+ *   bytes (ver TipoAlfabeto). El alfabeto se fija al construir el rotor.
+ *
+ * Cascada de rotores:
+ * - configurarCascada() encadena hasta MAX_ROTORES_CASCADA rotores, cada uno
+ *   con su cableado (una permutación del alfabeto) y su muesca. Un símbolo
+ *   de índice x atraviesa el rotor r como cableado_r[(x + posicion_r) % N],
+ *   del rotor 0 al último; con un solo rotor sin cableado es el corrimiento
+ *   original.
+ * - Avance tipo Enigma: cuando un rotor pasa de su muesca a la posición
+ *   siguiente arrastra una posición al rotor siguiente (hacia atrás, resta).
+ * - rotar() mueve el rotor seleccionado (el 0 por defecto); las tramas
+ *   SELECT y ROTOR eligen y mueven rotores concretos.
+ * - La permutación compuesta de toda la cascada se guarda en una fila de
+ *   256 bytes que solo se recalcula cuando algún rotor cambia de posición:
+ *   getMapeo() sigue siendo una única consulta sea cual sea la cascada.
  */
 class RotorDeMapeo {
 private:
     NodoRotor* cabeza;      ///< Puntero a la posición "cero" actual del rotor
     int tamanio;            ///< Número de elementos en el rotor (26 para A-Z)
+    TipoAlfabeto alfabeto;  ///< Alfabeto del rotor
+    
+    /// Índice de cada byte en el alfabeto, pertenencia y símbolo por índice
+    const unsigned char* posicionDe;
+    const unsigned char* mascaraDe;
+    const char* simboloDe;
+    
+    int numRotores;         ///< Rotores de la cascada (1 sin cascada)
+    int seleccionado;       ///< Rotor que mueve rotar()
+    bool cascada;           ///< Hay cableados o más de un rotor: usar la fila compuesta
+    
+    /// Posición de cada rotor; la del rotor 0 es la distancia hasta 'cabeza'
+    int posiciones[MAX_ROTORES_CASCADA];
+    
+    /// Muesca de cada rotor: al pasar de ella a la siguiente arrastra al rotor siguiente
+    int muescas[MAX_ROTORES_CASCADA];
+    
+    /// Cableados [rotor * 2 * tamanio + índice + posición] -> índice, con cada
+    /// cableado repetido dos veces para no calcular el módulo (nullptr sin cascada)
+    unsigned char* cableados;
+    
+    /// Permutación compuesta de la cascada en la posición actual (nullptr sin cascada)
+    char* filaCompuesta;
+    
+    /// Bytes que pertenecen al alfabeto: los únicos que cambian en filaCompuesta
+    unsigned char* bytesDelAlfabeto;
+    int numBytesDelAlfabeto;
+    
+    /// Nodos del rotor indexados por su distancia desde el primer símbolo
+    NodoRotor** nodos;
+    
+    /// Tabla de traducción: [desplazamiento * 256 + byte de entrada] -> byte mapeado
+    char* tablaMapeo;
+    
+    /// Fila vigente: la de tablaMapeo del desplazamiento actual, o filaCompuesta con cascada
+    const char* filaActual;
+    
+    // No copiable: es dueño de los nodos y de la tabla
+    RotorDeMapeo(const RotorDeMapeo&);
+    RotorDeMapeo& operator=(const RotorDeMapeo&);
     
     /**
-     * @brief Encuentra un nodo que contiene un carácter específico
-     * @param c Carácter a buscar
-     * @return Puntero al nodo que contiene el carácter, o nullptr si no existe
+     * @brief Construye la lista circular y la tabla para un alfabeto
      */
-    NodoRotor* buscarNodo(char c) const;
+    template <class Alfabeto>
+    void construir();
     
     /**
-     * @brief Calcula la distancia entre dos nodos en la lista circular
-     * @param desde Nodo de inicio
-     * @param hasta Nodo de destino
-     * @return Número de pasos desde 'desde' hasta 'hasta'
+     * @brief Apunta 'cabeza' y 'filaActual' a la posición actual
+     * 
+     * Con cascada recalcula la permutación compuesta: O(tamanio * rotores) más
+     * los bytes del alfabeto,
+     * solo tras un movimiento real de algún rotor.
      */
-    int calcularDistancia(NodoRotor* desde, NodoRotor* hasta) const;
+    void actualizarPosicion();
+    
+    /**
+     * @brief Lee el cableado de un rotor de la especificación
+     * @return Bytes consumidos, o 0 si el cableado es inválido
+     */
+    int leerRotor(const char* texto, int indice);
     
 public:
     /**
-     * @brief Constructor - Inicializa el rotor con el alfabeto A-Z
+     * @brief Constructor - Inicializa el rotor con el alfabeto indicado
+     * @param tipoAlfabeto Alfabeto del rotor (A-Z por defecto)
      */
-    RotorDeMapeo();
+    explicit RotorDeMapeo(TipoAlfabeto tipoAlfabeto = ALFABETO_MAYUSCULAS);
     
     /**
      * @brief Destructor - Libera toda la memoria de los nodos
@@ -80,12 +163,74 @@ public:
      * Si N < 0: rota hacia atrás (previo)
      * Si N == 0: no hace nada
      * 
-     * La rotación es circular, por lo que rotar 26 posiciones equivale a no rotar.
+     * La rotación es circular, por lo que rotar 'tamanio' posiciones equivale a no rotar.
+     * Complejidad: O(1) (aritmética modular sobre el desplazamiento)
+     * 
+     * Con cascada rota el rotor seleccionado (ver rotarRotor()).
      * 
      * @param n Número de posiciones a rotar (puede ser negativo)
      */
     void rotar(int n);
     
+    /**
+     * @brief Rota un rotor de la cascada, con arrastre a los siguientes
+     * 
+     * Cada paso por la muesca del rotor avanza (o retrocede) una posición
+     * el rotor siguiente, y así sucesivamente; el arrastre del último rotor
+     * se pierde. Un índice fuera de la cascada se ignora.
+     * 
+     * @param indice Rotor a mover (0 = el primero que atraviesa el símbolo)
+     * @param n Número de posiciones a rotar (puede ser negativo)
+     */
+    void rotarRotor(int indice, int n);
+    
+    /**
+     * @brief Elige el rotor que mueven rotar() y las tramas MAP
+     * @param indice Rotor de la cascada
+     * @return false si el índice no existe (la selección no cambia)
+     */
+    bool seleccionarRotor(int indice);
+    
+    /**
+     * @brief Coloca cada rotor en una posición absoluta, sin arrastre
+     * 
+     * Sirve para restaurar un estado guardado (ver PuntoDeControl).
+     * 
+     * @param posicionesRotores Posición de cada rotor, en el rango [0, tamanio)
+     * @param rotores Número de posiciones (debe coincidir con la cascada)
+     * @param rotorSeleccionado Rotor que moverán rotar() y las tramas MAP
+     * @return false si el número de rotores o alguna posición no es válida
+     */
+    bool establecerEstado(const int* posicionesRotores, int rotores, int rotorSeleccionado);
+    
+    /**
+     * @brief Vuelve a la posición inicial: todos los rotores en 0 y el 0 seleccionado
+     * 
+     * Cada mensaje de un flujo segmentado empieza con el rotor así (ver TramaFin).
+     */
+    void reiniciar();
+    
+    /**
+     * @brief Configura la cascada de rotores
+     * 
+     * La especificación es una lista separada por comas con un elemento por
+     * rotor: el cableado (exactamente 'tamanio' símbolos, una permutación
+     * del alfabeto), seguido opcionalmente de ':' y el símbolo de la muesca.
+     * Como el cableado tiene longitud fija, puede contener ',' o ':' (pero
+     * no el byte 0: con ALFABETO_BYTES solo sirve la forma numérica).
+     * Un número N (menor que el tamaño del alfabeto) crea N rotores sin
+     * cableado, con la muesca en el último símbolo.
+     * 
+     * Ejemplo (A-Z): "EKMFLGDQVZNTOWYHXUSPAIBRCJ:Q,AJDKSIRUXBLHWTMCQGZNPYFVOE:E"
+     * 
+     * Todos los rotores vuelven a la posición 0 y se selecciona el rotor 0.
+     * Los errores se describen en stderr.
+     * 
+     * @param especificacion Especificación de la cascada
+     * @return false si la especificación es inválida (el rotor no cambia)
+     */
+    bool configurarCascada(const char* especificacion);
+    
     /**
      * @brief Obtiene el carácter mapeado según la rotación actual
      * 
@@ -99,21 +244,93 @@ public:
      * Input: 'A' -> está a -2 de 'cabeza' -> mapea a 'A'+2 = 'C'
      * Input: 'W' -> está a 20 de 'cabeza' -> mapea a 'A'+20 = 'U'... más rotación
      * 
+     * Complejidad: O(1) (una consulta a la tabla precalculada)
+     * 
      * @param in Carácter a mapear
      * @return Carácter mapeado según la rotación actual
      */
-    char getMapeo(char in);
+    char getMapeo(char in) const {
+        return filaActual[static_cast<unsigned char>(in)];
+    }
+    
+    /**
+     * @brief Decodifica un bloque de caracteres con la rotación actual
+     * 
+     * Entre dos tramas MAP el desplazamiento es constante, por lo que una
+     * racha de tramas LOAD equivale a un corrimiento César sobre un bloque
+     * de bytes. Con el alfabeto A-Z se usa un kernel AVX2 o SSE2 cuando el
+     * procesador lo permite; la tabla de traducción es el respaldo escalar y
+     * el camino de los demás alfabetos.
+     * 
+     * Respeta las mismas reglas que getMapeo(): los bytes fuera del alfabeto
+     * se devuelven tal cual (con A-Z, las minúsculas se mapean como mayúsculas).
+     * Con cascada se usa siempre la fila compuesta.
+     * 
+     * @param in Bloque de entrada
+     * @param out Bloque de salida (puede coincidir con 'in')
+     * @param n Número de caracteres del bloque
+     */
+    void mapearBloque(const char* in, char* out, size_t n) const;
     
     /**
      * @brief Imprime el estado actual del rotor (para depuración)
      */
     void imprimirEstado() const;
     
+    /**
+     * @brief Imprime la posición de cada rotor de la cascada (" 3 4* 0", '*' = seleccionado)
+     */
+    void imprimirPosiciones() const;
+    
     /**
      * @brief Obtiene el carácter actual en la posición de cabeza
      * @return Carácter en la posición de cabeza
      */
     char obtenerCabeza() const { return cabeza ? cabeza->dato : '\0'; }
+    
+    /**
+     * @brief Obtiene el desplazamiento actual del rotor (el 0 con cascada) respecto al primer símbolo
+     * @return Desplazamiento en el rango [0, tamanio)
+     */
+    int obtenerDesplazamiento() const { return posiciones[0]; }
+    
+    /**
+     * @brief Obtiene el número de símbolos del alfabeto
+     * @return 26 para A-Z
+     */
+    int obtenerTamanio() const { return tamanio; }
+    
+    /**
+     * @brief Obtiene el alfabeto del rotor
+     */
+    TipoAlfabeto obtenerAlfabeto() const { return alfabeto; }
+    
+    /**
+     * @brief Indica si el mapeo pasa por una cascada (cableados o varios rotores)
+     * 
+     * Sin cascada, el estado del rotor es la suma de las rotaciones; con
+     * cascada depende también del arrastre y de la selección.
+     */
+    bool esCascada() const { return cascada; }
+    
+    /**
+     * @brief Obtiene el número de rotores de la cascada (1 sin cascada)
+     */
+    int obtenerNumeroRotores() const { return numRotores; }
+    
+    /**
+     * @brief Obtiene el rotor seleccionado
+     */
+    int obtenerRotorSeleccionado() const { return seleccionado; }
+    
+    /**
+     * @brief Obtiene la posición de un rotor de la cascada
+     * @param indice Rotor de la cascada
+     * @return Posición en el rango [0, tamanio), o -1 si el rotor no existe
+     */
+    int obtenerPosicionRotor(int indice) const {
+        return indice >= 0 && indice < numRotores ? posiciones[indice] : -1;
+    }
 };
 
 #endif // ROTOR_DE_MAPEO_H
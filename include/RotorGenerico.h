@@ -0,0 +1,222 @@
+/**
+ * @file RotorGenerico.h
+ * @brief Rotor de corrimiento parametrizado por alfabeto, con tablas generadas al compilar
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef ROTOR_GENERICO_H
+#define ROTOR_GENERICO_H
+
+#include <cstddef>  // Para size_t
+
+/**
+ * @enum TipoAlfabeto
+ * @brief Alfabetos disponibles para el rotor
+ */
+enum TipoAlfabeto {
+    ALFABETO_MAYUSCULAS,    ///< A-Z (las minúsculas se mapean como mayúsculas); el del protocolo original
+    ALFABETO_ALFANUMERICO,  ///< 0-9, A-Z y a-z (62 símbolos, distingue mayúsculas)
+    ALFABETO_IMPRIMIBLE,    ///< ASCII imprimible, del espacio a '~' (95 símbolos)
+    ALFABETO_BYTES          ///< Los 256 valores de byte
+};
+
+/**
+ * @struct AlfabetoMayusculas
+ * @brief A-Z; las minúsculas ocupan la posición de su mayúscula
+ */
+struct AlfabetoMayusculas {
+    static const int TAMANIO = 26;
+    static constexpr int indiceDe(int b) {
+        return (b >= 'A' && b <= 'Z') ? b - 'A' : (b >= 'a' && b <= 'z') ? b - 'a' : -1;
+    }
+    static constexpr char simboloEn(int i) { return static_cast<char>('A' + i); }
+};
+
+/**
+ * @struct AlfabetoAlfanumerico
+ * @brief Dígitos, mayúsculas y minúsculas, en ese orden
+ */
+struct AlfabetoAlfanumerico {
+    static const int TAMANIO = 62;
+    static constexpr int indiceDe(int b) {
+        return (b >= '0' && b <= '9') ? b - '0'
+             : (b >= 'A' && b <= 'Z') ? 10 + b - 'A'
+             : (b >= 'a' && b <= 'z') ? 36 + b - 'a' : -1;
+    }
+    static constexpr char simboloEn(int i) {
+        return static_cast<char>(i < 10 ? '0' + i : i < 36 ? 'A' + i - 10 : 'a' + i - 36);
+    }
+};
+
+/**
+ * @struct AlfabetoImprimible
+ * @brief ASCII imprimible (0x20-0x7E); el espacio también rota
+ */
+struct AlfabetoImprimible {
+    static const int TAMANIO = 95;
+    static constexpr int indiceDe(int b) { return (b >= 0x20 && b <= 0x7E) ? b - 0x20 : -1; }
+    static constexpr char simboloEn(int i) { return static_cast<char>(0x20 + i); }
+};
+
+/**
+ * @struct AlfabetoBytes
+ * @brief Todos los valores de byte
+ */
+struct AlfabetoBytes {
+    static const int TAMANIO = 256;
+    static constexpr int indiceDe(int b) { return b; }
+    static constexpr char simboloEn(int i) { return static_cast<char>(i); }
+};
+
+/**
+ * @brief Número de símbolos de un alfabeto
+ */
+inline int tamanioDeAlfabeto(TipoAlfabeto alfabeto) {
+    switch (alfabeto) {
+        case ALFABETO_ALFANUMERICO: return AlfabetoAlfanumerico::TAMANIO;
+        case ALFABETO_IMPRIMIBLE:   return AlfabetoImprimible::TAMANIO;
+        case ALFABETO_BYTES:        return AlfabetoBytes::TAMANIO;
+        default:                    return AlfabetoMayusculas::TAMANIO;
+    }
+}
+
+/**
+ * @struct SecuenciaIndices
+ * @brief Lista de enteros 0..N-1 como parámetros de plantilla (std::index_sequence no existe en C++11)
+ */
+template <int... I>
+struct SecuenciaIndices {};
+
+template <class A, class B>
+struct UnirIndices;
+
+template <int... I, int... J>
+struct UnirIndices<SecuenciaIndices<I...>, SecuenciaIndices<J...> > {
+    typedef SecuenciaIndices<I..., static_cast<int>(sizeof...(I)) + J...> tipo;
+};
+
+/**
+ * @struct GenerarIndices
+ * @brief Genera SecuenciaIndices<0, ..., N-1> con profundidad de instanciación logarítmica
+ */
+template <int N>
+struct GenerarIndices {
+    typedef typename UnirIndices<typename GenerarIndices<N / 2>::tipo,
+                                 typename GenerarIndices<N - N / 2>::tipo>::tipo tipo;
+};
+
+template <>
+struct GenerarIndices<0> {
+    typedef SecuenciaIndices<> tipo;
+};
+
+template <>
+struct GenerarIndices<1> {
+    typedef SecuenciaIndices<0> tipo;
+};
+
+/**
+ * @struct TablasAlfabeto
+ * @brief Tablas constantes de un alfabeto, calculadas por el compilador
+ *
+ * - posicion[b]: índice del byte b en el alfabeto (0 si no pertenece)
+ * - mascara[b]: 0xFF si b pertenece al alfabeto, 0 si no
+ * - simbolos[i]: símbolo i % TAMANIO, duplicado para que posición más
+ *   desplazamiento nunca necesite módulo
+ */
+template <class Alfabeto,
+          class Bytes = typename GenerarIndices<256>::tipo,
+          class Simbolos = typename GenerarIndices<2 * Alfabeto::TAMANIO>::tipo>
+struct TablasAlfabeto;
+
+template <class Alfabeto, int... B, int... S>
+struct TablasAlfabeto<Alfabeto, SecuenciaIndices<B...>, SecuenciaIndices<S...> > {
+    static constexpr unsigned char posicion[256] = {
+        static_cast<unsigned char>(Alfabeto::indiceDe(B) < 0 ? 0 : Alfabeto::indiceDe(B))...
+    };
+    static constexpr unsigned char mascara[256] = {
+        static_cast<unsigned char>(Alfabeto::indiceDe(B) < 0 ? 0x00 : 0xFF)...
+    };
+    static constexpr char simbolos[2 * Alfabeto::TAMANIO] = {
+        Alfabeto::simboloEn(S % Alfabeto::TAMANIO)...
+    };
+};
+
+template <class Alfabeto, int... B, int... S>
+constexpr unsigned char TablasAlfabeto<Alfabeto, SecuenciaIndices<B...>, SecuenciaIndices<S...> >::posicion[256];
+
+template <class Alfabeto, int... B, int... S>
+constexpr unsigned char TablasAlfabeto<Alfabeto, SecuenciaIndices<B...>, SecuenciaIndices<S...> >::mascara[256];
+
+template <class Alfabeto, int... B, int... S>
+constexpr char TablasAlfabeto<Alfabeto, SecuenciaIndices<B...>, SecuenciaIndices<S...> >::simbolos[2 * Alfabeto::TAMANIO];
+
+/**
+ * @class RotorGenerico
+ * @brief Rotor de corrimiento sobre un alfabeto fijado en compilación
+ *
+ * La rotación es un desplazamiento modular; el mapeo de un byte es una
+ * consulta a las tablas de TablasAlfabeto sin ramas: los bytes que no
+ * pertenecen al alfabeto se devuelven tal cual mediante la máscara.
+ *
+ * Con AlfabetoMayusculas reproduce exactamente RotorDeMapeo::getMapeo().
+ */
+template <class Alfabeto>
+class RotorGenerico {
+private:
+    typedef TablasAlfabeto<Alfabeto> Tablas;
+    int desplazamiento;  ///< Posiciones rotadas (0..TAMANIO-1)
+
+public:
+    /// Número de símbolos del alfabeto
+    static const int TAMANIO = Alfabeto::TAMANIO;
+
+    RotorGenerico() : desplazamiento(0) {}
+
+    /**
+     * @brief Rota N posiciones (negativo = hacia atrás)
+     */
+    void rotar(int n) {
+        n %= TAMANIO;
+        if (n < 0) n += TAMANIO;
+        desplazamiento = (desplazamiento + n) % TAMANIO;
+    }
+
+    /**
+     * @brief Coloca el rotor en un desplazamiento absoluto
+     */
+    void establecerDesplazamiento(int d) {
+        desplazamiento = 0;
+        rotar(d);
+    }
+
+    /**
+     * @brief Byte mapeado según la rotación actual
+     */
+    char getMapeo(char in) const {
+        unsigned char b = static_cast<unsigned char>(in);
+        unsigned char m = Tablas::mascara[b];
+        unsigned char rotado = static_cast<unsigned char>(Tablas::simbolos[Tablas::posicion[b] + desplazamiento]);
+        return static_cast<char>((rotado & m) | (b & static_cast<unsigned char>(~m)));
+    }
+
+    /**
+     * @brief Mapea un bloque completo con la rotación actual
+     * @param in Bloque de entrada
+     * @param out Bloque de salida (puede coincidir con 'in')
+     * @param n Número de bytes
+     */
+    void mapearBloque(const char* in, char* out, size_t n) const {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = getMapeo(in[i]);
+        }
+    }
+
+    /**
+     * @brief Desplazamiento actual
+     */
+    int obtenerDesplazamiento() const { return desplazamiento; }
+};
+
+#endif // ROTOR_GENERICO_H
@@ -0,0 +1,97 @@
+/**
+ * @file SalidaDeMensaje.h
+ * @brief Modos de salida del mensaje mientras se decodifica el flujo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef SALIDA_DE_MENSAJE_H
+#define SALIDA_DE_MENSAJE_H
+
+#include "ListaDeCarga.h"
+#include "EscritorBuffer.h"
+#include <chrono>
+
+/// Intervalo por defecto entre líneas de progreso (milisegundos)
+const int INTERVALO_PROGRESO_DEFECTO_MS = 1000;
+
+/**
+ * @enum ModoSalida
+ * @brief Qué se imprime mientras llegan las tramas
+ */
+enum ModoSalida {
+    SALIDA_DETALLADA,    ///< Cada trama y el mensaje parcial (comportamiento original)
+    SALIDA_SILENCIOSA,   ///< Nada hasta el mensaje final
+    SALIDA_INCREMENTAL,  ///< Solo los caracteres nuevos, con escritura en bloque
+    SALIDA_PERIODICA     ///< Una línea de progreso cada cierto intervalo
+};
+
+/**
+ * @class SalidaDeMensaje
+ * @brief Aplica el modo de salida elegido durante el bucle de tramas
+ * 
+ * En modo detallado el mensaje parcial se reimprime completo con cada
+ * trama, lo que cuesta O(n²) a lo largo de una sesión. Los otros modos
+ * cuestan O(1) por trama: el incremental solo copia lo decodificado desde
+ * la última vez (ListaDeCarga::copiarDesde()) a un EscritorBuffer, y el
+ * periódico solo consulta el reloj cada SONDEO_RELOJ tramas.
+ */
+class SalidaDeMensaje {
+private:
+    const ListaDeCarga* carga;      ///< Mensaje que se está ensamblando
+    ModoSalida modo;                ///< Modo elegido
+    EscritorBuffer escritor;        ///< Salida con buffer (stdout)
+    long long emitidos;             ///< Posición absoluta del siguiente carácter a escribir (modo incremental)
+    int tramasSinSondeo;            ///< Tramas desde la última consulta del reloj
+    std::chrono::steady_clock::duration intervalo;            ///< Período del progreso
+    std::chrono::steady_clock::time_point inicio;             ///< Comienzo del flujo
+    std::chrono::steady_clock::time_point proximoReporte;     ///< Siguiente línea de progreso
+    
+    /**
+     * @brief Escribe los caracteres decodificados desde la última emisión
+     */
+    void emitirNuevos();
+    
+    /**
+     * @brief Escribe una línea de progreso si ya venció el intervalo
+     * @param tramas Tramas procesadas hasta ahora
+     * @param forzar Escribirla aunque no haya vencido
+     */
+    void reportarProgreso(int tramas, bool forzar);
+    
+public:
+    /**
+     * @brief Constructor
+     * @param cargaMensaje Lista donde se ensambla el mensaje
+     * @param modoSalida Modo de salida
+     * @param intervaloMs Intervalo del modo periódico
+     */
+    SalidaDeMensaje(const ListaDeCarga* cargaMensaje, ModoSalida modoSalida,
+                    int intervaloMs = INTERVALO_PROGRESO_DEFECTO_MS);
+    
+    /**
+     * @brief Indica si el procesador debe imprimir cada trama
+     * @return true en modo detallado
+     */
+    bool esDetallada() const { return modo == SALIDA_DETALLADA; }
+    
+    /**
+     * @brief Avisa que se procesó una línea
+     * @param tramas Tramas procesadas hasta ahora
+     */
+    void tramaProcesada(int tramas);
+    
+    /**
+     * @brief Avisa que la fuente no tiene datos por ahora (entrega lo pendiente)
+     * @param tramas Tramas procesadas hasta ahora
+     */
+    void pausa(int tramas);
+    
+    /**
+     * @brief Termina la salida al final del flujo
+     * @param tramas Tramas procesadas en total
+     */
+    void finalizar(int tramas);
+};
+
+#endif // SALIDA_DE_MENSAJE_H
@@ -14,6 +14,47 @@
     #include <termios.h>
 #endif
 
+#include "FuenteDeLineas.h"
+
+/// Tamaño del buffer interno de lectura del puerto (bytes)
+const int TAM_BUFFER_LECTURA = 65536;
+
+/**
+ * @struct ConfiguracionSerial
+ * @brief Parámetros de línea y política de lectura del puerto serial
+ * 
+ * Los valores por defecto reproducen la configuración original del
+ * decodificador: 9600 baud, 8N1, sin control de flujo, VMIN=0 y VTIME=1.
+ */
+struct ConfiguracionSerial {
+    int baudios;        ///< Velocidad en baudios (estándar, hasta 4000000)
+    int bitsDatos;      ///< Bits por carácter (5 a 8)
+    char paridad;       ///< 'N' (ninguna), 'E' (par) u 'O' (impar)
+    int bitsParada;     ///< Bits de parada (1 o 2)
+    char controlFlujo;  ///< 'N' (ninguno), 'H' (RTS/CTS) o 'S' (XON/XOFF)
+    int vmin;           ///< Bytes mínimos por lectura (VMIN, 0 a 255)
+    int vtime;          ///< Timeout de lectura en décimas de segundo (VTIME, 0 a 255)
+    bool modoCrudo;     ///< Partir de cfmakeraw() en lugar de una estructura vacía
+    
+    /**
+     * @brief Constructor - Configuración por defecto (9600 8N1)
+     */
+    ConfiguracionSerial()
+        : baudios(9600), bitsDatos(8), paridad('N'), bitsParada(1),
+          controlFlujo('N'), vmin(0), vtime(1), modoCrudo(false) {}
+};
+
+/**
+ * @brief Verifica que una configuración serial sea válida en esta plataforma
+ * 
+ * Comprueba que la velocidad sea una de las estándar soportadas por el
+ * sistema y que el resto de los parámetros estén en rango.
+ * 
+ * @param config Configuración a validar
+ * @return nullptr si es válida, o un mensaje que describe el problema
+ */
+const char* validarConfiguracionSerial(const ConfiguracionSerial& config);
+
 /**
  * @class SerialPort
  * @brief Maneja la comunicación con el puerto serial
@@ -23,11 +64,16 @@
  * 
  * Características:
  * - Multiplataforma (Windows/Linux)
- * - Configuración automática del puerto (9600 baud, 8N1)
+ * - Configuración del puerto mediante ConfiguracionSerial (9600 baud, 8N1 por defecto)
  * - Lectura línea por línea
  * - Manejo de errores
+ * 
+ * Lectura con buffer: el puerto se lee con llamadas read() grandes sobre un
+ * buffer interno; los saltos de línea se localizan con memchr() y las
+ * líneas se entregan como vistas dentro del buffer, sin copiarlas. Cuando el
+ * espacio libre se agota, los bytes pendientes se compactan al inicio.
  */
-class SerialPort {
+class SerialPort : public FuenteDeLineas {
 private:
 #ifdef _WIN32
     HANDLE hSerial;         ///< Handle del puerto serial (Windows)
@@ -37,6 +83,17 @@ private:
 #endif
     
     bool conectado;         ///< Estado de la conexión
+    ConfiguracionSerial configuracion; ///< Parámetros aplicados al puerto
+    
+    char* bufferLectura;    ///< Bytes leídos del puerto y aún no consumidos
+    int inicio;             ///< Primer byte sin consumir del buffer
+    int fin;                ///< Fin de los bytes válidos del buffer
+    int inicioBusqueda;     ///< Posición desde donde seguir buscando '\n'
+    bool noBloqueante;      ///< Lecturas sin espera (modo multiplexado)
+    long long ultimaLlegadaNs; ///< Instante de la última lectura con datos (relojNs())
+    int esperaMaximaMs;     ///< Silencio tras el que leerLineaVista() vuelve sin datos (0 = sin límite)
+    bool pausaAvisada;      ///< Ya se devolvió 0 en esta racha de silencio
+    int descriptorCancelacion; ///< Descriptor cuya lectura interrumpe la espera (-1 = ninguno)
     
     /**
      * @brief Configurar parámetros del puerto serial
@@ -44,12 +101,62 @@ private:
      */
     bool configurarPuerto();
     
+    /**
+     * @brief Lee del puerto todo lo que quepa en el buffer interno
+     * 
+     * Compacta los bytes pendientes al inicio del buffer si no queda espacio
+     * libre al final. Invalida las vistas entregadas anteriormente.
+     * 
+     * @return Bytes leídos, 0 si venció el timeout, -1 si hubo error
+     */
+    int rellenarBuffer();
+    
+#ifndef _WIN32
+    /**
+     * @brief Espera con poll() a que el puerto tenga datos
+     * 
+     * Con VMIN=0 el hilo duerme en poll() en lugar de despertar en cada
+     * timeout de VTIME: una línea a medias o el primer silencio tras los
+     * datos esperan VTIME (para entregarla o avisar la pausa); después se
+     * espera hasta completar la espera máxima desde la última llegada, o
+     * sin límite. Con VMIN>0 se espera sin límite, como lo haría read().
+     * La espera termina antes si el descriptor de cancelación se vuelve
+     * legible o llega una señal.
+     * 
+     * @return true si hay datos que leer, false si venció el plazo o se canceló
+     */
+    bool esperarDatos();
+#endif
+    
+    /**
+     * @brief Busca una línea completa entre los bytes ya leídos
+     * 
+     * Si la encuentra, la consume del buffer. Una trama binaria (primer
+     * byte >= 0x80) se entrega completa según su longitud, sin buscar '\n'.
+     * 
+     * @param linea Vista donde se devuelve la línea
+     * @return true si había una línea completa
+     */
+    bool extraerLineaCompleta(VistaLinea& linea);
+    
+    /**
+     * @brief Entrega como línea todos los bytes pendientes (línea incompleta)
+     * @param linea Vista donde se devuelve la línea
+     */
+    void extraerPendiente(VistaLinea& linea);
+    
+    // No copiable: es dueño del descriptor y del buffer
+    SerialPort(const SerialPort&);
+    SerialPort& operator=(const SerialPort&);
+    
 public:
     /**
      * @brief Constructor
      * @param nombrePuerto Nombre del puerto (ej. "COM3" en Windows, "/dev/ttyUSB0" en Linux)
+     * @param config Parámetros de línea y de lectura (por defecto 9600 8N1)
      */
-    explicit SerialPort(const char* nombrePuerto);
+    explicit SerialPort(const char* nombrePuerto,
+                        const ConfiguracionSerial& config = ConfiguracionSerial());
     
     /**
      * @brief Destructor - Cierra el puerto automáticamente
@@ -62,6 +169,55 @@ public:
      */
     bool estaConectado() const { return conectado; }
     
+    /**
+     * @brief Obtiene la configuración aplicada al puerto
+     * @return Configuración serial
+     */
+    const ConfiguracionSerial& obtenerConfiguracion() const { return configuracion; }
+    
+    /**
+     * @brief Activa o desactiva las lecturas sin espera
+     * 
+     * En modo no bloqueante una lectura sin datos devuelve de inmediato y
+     * las líneas incompletas permanecen en el buffer hasta recibir su '\n'.
+     * Es el modo usado cuando el puerto se atiende con epoll.
+     * 
+     * @param activar true para no bloquear
+     * @return true si el modo se aplicó
+     */
+    bool establecerNoBloqueante(bool activar);
+    
+    /**
+     * @brief Fija cuánto silencio espera leerLineaVista() antes de devolver 0
+     * 
+     * La primera lectura sin datos tras una racha vuelve a los VTIME, para
+     * que el llamador vacíe su salida; las siguientes duermen hasta que
+     * pasen plazoMs desde la última llegada. Solo tiene efecto con VMIN=0
+     * y fuera del modo no bloqueante (en Windows rige solo VTIME).
+     * 
+     * @param plazoMs Milisegundos sin datos (0 = esperar sin límite)
+     */
+    void establecerEsperaMaxima(int plazoMs) { esperaMaximaMs = plazoMs; }
+    
+    /**
+     * @brief Fija un descriptor que interrumpe las esperas al volverse legible
+     * 
+     * Típicamente el extremo de lectura de una tubería de aviso
+     * (ControlDeParada): escribir en ella despierta al hilo que lee el
+     * puerto, sea cual sea el hilo que recibió la señal. No se consume.
+     * 
+     * @param descriptor Descriptor a vigilar (-1 = ninguno)
+     */
+    void establecerCancelacion(int descriptor) { descriptorCancelacion = descriptor; }
+    
+#ifndef _WIN32
+    /**
+     * @brief Obtiene el descriptor de archivo del puerto
+     * @return Descriptor, o -1 si el puerto está cerrado
+     */
+    int obtenerDescriptor() const { return conectado ? fd : -1; }
+#endif
+    
     /**
      * @brief Lee una línea completa del puerto serial
      * 
@@ -74,6 +230,32 @@ public:
      */
     int leerLinea(char* buffer, int longitudMax);
     
+    /**
+     * @brief Lee una línea completa sin copiarla
+     * 
+     * Igual que leerLinea(), pero devuelve una vista dentro del buffer
+     * interno. Solo se elimina un '\r' inmediatamente anterior al '\n'.
+     * Si vence el timeout con una línea a medias, se entrega lo recibido;
+     * si vence sin nada recibido (o una señal interrumpe la lectura), se
+     * devuelve 0 para que el llamador aplique su propio plazo.
+     * 
+     * @param linea Vista donde se devuelve la línea (válida hasta la siguiente lectura)
+     * @return Longitud de la línea (0 si no llegó nada a tiempo), o -1 si hay error
+     */
+    int leerLineaVista(VistaLinea& linea) override;
+    
+    /**
+     * @brief Devuelve todas las líneas completas que ya están en el buffer
+     * 
+     * Si no hay ninguna línea completa, hace una sola lectura del puerto
+     * (respetando el timeout) antes de buscar. No espera indefinidamente.
+     * 
+     * @param lineas Arreglo donde se devuelven las vistas
+     * @param maxLineas Capacidad del arreglo
+     * @return Número de líneas devueltas (0 si no hay ninguna), o -1 si hay error
+     */
+    int leerLineas(VistaLinea* lineas, int maxLineas);
+    
     /**
      * @brief Lee un solo carácter del puerto serial
      * @param c Referencia donde se almacenará el carácter leído
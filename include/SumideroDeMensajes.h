@@ -0,0 +1,126 @@
+/**
+ * @file SumideroDeMensajes.h
+ * @brief Destino de los mensajes de un flujo segmentado por tramas FIN
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef SUMIDERO_DE_MENSAJES_H
+#define SUMIDERO_DE_MENSAJES_H
+
+#include "ListaDeCarga.h"
+#include "EscritorBuffer.h"
+#include "RegistroDeTramas.h"
+#include <cstdio>
+
+/// Caracteres del mensaje abierto que se retienen en memoria por defecto
+const int VENTANA_MENSAJE_DEFECTO = 1 << 20;
+
+/**
+ * @class SumideroDeMensajes
+ * @brief Escribe cada mensaje en un archivo a medida que se decodifica
+ * 
+ * Con un sumidero, la lista de carga deja de crecer sin límite: el
+ * procesador le entrega el mensaje al llegar la trama FIN, o un tramo del
+ * mensaje abierto cuando este supera la ventana, y después descarta de la
+ * lista lo entregado (ListaDeCarga::descartarPrincipio()). La memoria queda
+ * acotada por la ventana aunque el flujo no termine nunca.
+ * 
+ * Cada mensaje cerrado se escribe seguido de un salto de línea y con
+ * fflush(), de modo que quien lee el archivo ve mensajes completos. Un
+ * mensaje que contenga saltos de línea (alfabeto de bytes) no se puede
+ * separar del siguiente al leer.
+ */
+class SumideroDeMensajes {
+private:
+    FILE* destino;              ///< Archivo de los mensajes (nullptr = no escribir)
+    bool propio;                ///< 'destino' se abrió aquí y se cierra al destruir
+    EscritorBuffer* escritor;   ///< Buffer sobre 'destino' (nullptr sin destino)
+    char delimitador[LONGITUD_MAX_DELIMITADOR + 1]; ///< Línea de la trama FIN
+    int ventana;                ///< Caracteres del mensaje abierto antes de entregar un tramo
+    long long mensajesCerrados; ///< Mensajes terminados por una trama FIN
+    long long caracteresEscritos; ///< Caracteres entregados (sin los saltos de línea)
+    
+    // No copiable: es dueño del archivo y del buffer
+    SumideroDeMensajes(const SumideroDeMensajes&);
+    SumideroDeMensajes& operator=(const SumideroDeMensajes&);
+    
+public:
+    /**
+     * @brief Constructor - Sumidero sin destino: cuenta pero no escribe (ver abrir())
+     * @param delimitadorFin Línea que cierra un mensaje (se trunca a LONGITUD_MAX_DELIMITADOR)
+     * @param ventanaCaracteres Caracteres del mensaje abierto que se retienen en memoria
+     */
+    explicit SumideroDeMensajes(const char* delimitadorFin = DELIMITADOR_FIN_DEFECTO,
+                                int ventanaCaracteres = VENTANA_MENSAJE_DEFECTO);
+    
+    /**
+     * @brief Destructor - Escribe lo pendiente y cierra el archivo propio
+     */
+    ~SumideroDeMensajes();
+    
+    /**
+     * @brief Elige el archivo de los mensajes
+     * @param ruta Archivo donde agregar los mensajes, o "-" para stdout
+     * @return false si no se pudo abrir
+     */
+    bool abrir(const char* ruta);
+    
+    /**
+     * @brief Entrega un tramo del mensaje abierto (sin cerrarlo ni hacer fflush())
+     * @param carga Lista del mensaje
+     * @param desde Primer carácter de la lista aún no entregado
+     */
+    void volcar(const ListaDeCarga& carga, int desde);
+    
+    /**
+     * @brief Entrega el final del mensaje y lo cierra con un salto de línea
+     * @param carga Lista del mensaje
+     * @param desde Primer carácter de la lista aún no entregado
+     */
+    void cerrarMensaje(const ListaDeCarga& carga, int desde);
+    
+    /**
+     * @brief Escribe lo pendiente en el archivo
+     */
+    void vaciar();
+    
+    /**
+     * @brief Escribe lo pendiente y obtiene el tamaño del archivo de mensajes
+     * @return Bytes del archivo, o -1 si no es un archivo propio (stdout o sin destino)
+     */
+    long long obtenerPosicion();
+    
+    /**
+     * @brief Recorta el archivo de mensajes a un tamaño anterior
+     * 
+     * Al reanudar, deja el archivo como estaba en el punto de control para
+     * que las tramas del diario vuelvan a escribir exactamente lo mismo.
+     * 
+     * @param posicion Tamaño devuelto por obtenerPosicion()
+     * @return false si el archivo es más corto o no se pudo recortar
+     */
+    bool recortar(long long posicion);
+    
+    /**
+     * @brief Obtiene la línea que cierra un mensaje
+     */
+    const char* obtenerDelimitador() const { return delimitador; }
+    
+    /**
+     * @brief Obtiene los caracteres del mensaje abierto que se retienen en memoria
+     */
+    int obtenerVentana() const { return ventana; }
+    
+    /**
+     * @brief Obtiene el número de mensajes cerrados
+     */
+    long long obtenerMensajesCerrados() const { return mensajesCerrados; }
+    
+    /**
+     * @brief Obtiene los caracteres entregados en total
+     */
+    long long obtenerCaracteresEscritos() const { return caracteresEscritos; }
+};
+
+#endif // SUMIDERO_DE_MENSAJES_H
@@ -11,6 +11,7 @@
 // Forward declarations para evitar dependencias circulares
 class ListaDeCarga;
 class RotorDeMapeo;
+class LoteDeCarga;
 
 /**
  * @class TramaBase
@@ -43,10 +44,82 @@ public:
     virtual void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) = 0;
     
     /**
-     * @brief Obtiene una representación en texto de la trama para depuración
-     * @return Cadena con la representación de la trama
+     * @brief Escribe una representación en texto de la trama para depuración
+     * 
+     * La trama no guarda su propio buffer de texto: solo se formatea cuando
+     * se necesita para el registro, en el buffer que proporciona el llamador.
+     * 
+     * @param buffer Buffer de destino (siempre queda terminado en '\0')
+     * @param tamBuffer Tamaño del buffer
+     * @return Puntero a 'buffer', para usarlo directamente en printf
+     */
+    virtual const char* obtenerRepresentacion(char* buffer, int tamBuffer) const = 0;
+    
+    /**
+     * @brief Intenta agregar la trama a la racha de tramas LOAD pendientes
+     * 
+     * Las tramas que solo aportan un carácter de carga pueden diferir su
+     * decodificación al lote; el resto debe procesarse de inmediato (después
+     * de vaciar el lote, porque pueden cambiar el rotor).
+     * 
+     * @param lote Lote de caracteres pendientes
+     * @return true si la trama quedó en el lote y no debe procesarse aparte
+     */
+    virtual bool acumularEnLote(LoteDeCarga* lote) const {
+        (void)lote;
+        return false;
+    }
+    
+    /**
+     * @brief Obtiene la rotación que la trama aplica al rotor
+     * 
+     * Las rotaciones solo se suman módulo 26, así que el estado del rotor en
+     * cualquier punto de un flujo es la suma de las rotaciones anteriores
+     * (sin cascada de rotores; ver RotorDeMapeo::esCascada()).
+     * 
+     * @return Rotación aplicada (0 si la trama no modifica el rotor)
+     */
+    virtual int obtenerRotacion() const { return 0; }
+    
+    /**
+     * @brief Indica si la trama cierra el mensaje en curso (ver TramaFin)
+     * @return true si el procesador debe entregar el mensaje y reiniciar el rotor
+     */
+    virtual bool cierraMensaje() const { return false; }
+    
+    /**
+     * @brief Aplica al rotor el efecto de la trama, sin tocar la carga
+     * 
+     * Lo usa quien decodifica con decodificarEn() en lugar de procesar().
+     * Por defecto rota el rotor obtenerRotacion() posiciones; las tramas que
+     * eligen o mueven rotores concretos de la cascada lo redefinen.
+     * 
+     * @param rotor Rotor a ajustar
+     */
+    virtual void ajustarRotor(RotorDeMapeo* rotor) const;
+    
+    /**
+     * @brief Decodifica la carga de la trama directamente en un buffer
+     * 
+     * Alternativa a procesar() para quien ensambla el mensaje sin una
+     * ListaDeCarga (por ejemplo, la decodificación paralela de capturas).
+     * 
+     * @param rotor Rotor con la rotación vigente (puede ser nullptr si destino es nullptr)
+     * @param destino Buffer de salida, o nullptr para solo contar
+     * @return Número de caracteres que la trama aporta al mensaje
+     */
+    virtual int decodificarEn(const RotorDeMapeo* rotor, char* destino) const {
+        (void)rotor;
+        (void)destino;
+        return 0;
+    }
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama (para el registro)
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
      */
-    virtual const char* obtenerRepresentacion() const = 0;
+    virtual void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const = 0;
 };
 
 #endif // TRAMA_BASE_H
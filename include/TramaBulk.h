@@ -0,0 +1,88 @@
+/**
+ * @file TramaBulk.h
+ * @brief Clase para tramas de tipo BULK que contienen varios caracteres de carga
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TRAMA_BULK_H
+#define TRAMA_BULK_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class TramaBulk
+ * @brief Representa una trama BULK del protocolo PRT-7
+ * 
+ * Una trama BULK transporta una cadena completa que se decodifica con la
+ * rotación actual del rotor, como si fueran varias tramas LOAD seguidas,
+ * pero con un solo despacho y sin el costo de una línea por carácter.
+ * 
+ * Formato: B,TEXTO donde TEXTO son todos los bytes hasta el fin de línea
+ * Ejemplo: B,HOLA MUNDO equivale a L,H L,O L,L L,A L,  L,M ... L,O
+ * 
+ * La trama no copia el texto: apunta a la línea recibida, que debe seguir
+ * vigente mientras la trama se procesa.
+ */
+class TramaBulk : public TramaBase {
+private:
+    const char* datos;  ///< Caracteres de carga (dentro de la línea recibida)
+    int longitud;       ///< Número de caracteres de carga
+    
+public:
+    /**
+     * @brief Constructor
+     * @param texto Caracteres de carga
+     * @param n Número de caracteres
+     */
+    TramaBulk(const char* texto, int n);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TramaBulk();
+    
+    /**
+     * @brief Procesa la trama BULK
+     * 
+     * Decodifica todos los caracteres con RotorDeMapeo::mapearBloque() y los
+     * inserta en la lista de carga en el mismo orden.
+     * 
+     * @param carga Lista donde se insertarán los caracteres decodificados
+     * @param rotor Rotor usado para decodificar los caracteres
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
+     * @return Cadena con formato "B,TEXTO"
+     */
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Escribe el texto decodificado en el buffer
+     * @param rotor Rotor con la rotación vigente
+     * @param destino Buffer de salida, o nullptr para solo contar
+     * @return Longitud del texto de la trama
+     */
+    int decodificarEn(const RotorDeMapeo* rotor, char* destino) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
+    
+    /**
+     * @brief Obtiene el número de caracteres de carga
+     * @return Longitud del texto de la trama
+     */
+    int obtenerLongitud() const { return longitud; }
+};
+
+#endif // TRAMA_BULK_H
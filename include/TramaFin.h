@@ -0,0 +1,67 @@
+/**
+ * @file TramaFin.h
+ * @brief Clase para tramas FIN que cierran un mensaje del flujo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TRAMA_FIN_H
+#define TRAMA_FIN_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class TramaFin
+ * @brief Representa el delimitador entre dos mensajes de un mismo flujo
+ * 
+ * La trama en sí no modifica la carga ni el rotor: quien la cierra es el
+ * procesador, que entrega el mensaje a su SumideroDeMensajes y reinicia el
+ * rotor. Sin sumidero, la trama se acepta y no tiene efecto.
+ * 
+ * Formato: una línea igual al delimitador ("FIN" por defecto, ver
+ * RegistroDeTramas::establecerDelimitador()), o el byte 0xA6 en binario
+ */
+class TramaFin : public TramaBase {
+public:
+    /**
+     * @brief Constructor
+     */
+    TramaFin();
+    
+    /**
+     * @brief Destructor
+     */
+    ~TramaFin();
+    
+    /**
+     * @brief No hace nada: el procesador cierra el mensaje (ver cierraMensaje())
+     * @param carga Lista de carga (no se utiliza)
+     * @param rotor Rotor (no se utiliza)
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Indica que la trama cierra el mensaje en curso
+     * @return Siempre true
+     */
+    bool cierraMensaje() const override { return true; }
+    
+    /**
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
+     * @return Cadena "FIN"
+     */
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
+};
+
+#endif // TRAMA_FIN_H
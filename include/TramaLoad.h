@@ -25,7 +25,6 @@
 class TramaLoad : public TramaBase {
 private:
     char caracter;           ///< Carácter contenido en la trama
-    char representacion[10]; ///< Buffer para la representación en texto
     
 public:
     /**
@@ -52,10 +51,34 @@ public:
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
     
     /**
-     * @brief Obtiene una representación en texto de la trama
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
      * @return Cadena con formato "L,X"
      */
-    const char* obtenerRepresentacion() const override;
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Agrega el carácter de la trama al lote de carga pendiente
+     * @param lote Lote de caracteres pendientes
+     * @return true si cupo en el lote
+     */
+    bool acumularEnLote(LoteDeCarga* lote) const override;
+    
+    /**
+     * @brief Escribe el carácter decodificado en el buffer
+     * @param rotor Rotor con la rotación vigente
+     * @param destino Buffer de salida, o nullptr para solo contar
+     * @return 1
+     */
+    int decodificarEn(const RotorDeMapeo* rotor, char* destino) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
     
     /**
      * @brief Obtiene el carácter almacenado
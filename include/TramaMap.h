@@ -26,7 +26,6 @@
 class TramaMap : public TramaBase {
 private:
     int rotacion;            ///< Número de posiciones a rotar (puede ser negativo)
-    char representacion[20]; ///< Buffer para la representación en texto
     
 public:
     /**
@@ -52,16 +51,25 @@ public:
     void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
     
     /**
-     * @brief Obtiene una representación en texto de la trama
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
      * @return Cadena con formato "M,N"
      */
-    const char* obtenerRepresentacion() const override;
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
     
     /**
      * @brief Obtiene el valor de rotación
      * @return Número de posiciones a rotar
      */
-    int obtenerRotacion() const { return rotacion; }
+    int obtenerRotacion() const override { return rotacion; }
 };
 
 #endif // TRAMA_MAP_H
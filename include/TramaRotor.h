@@ -0,0 +1,85 @@
+/**
+ * @file TramaRotor.h
+ * @brief Clase para tramas ROTOR que rotan un rotor concreto de la cascada
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TRAMA_ROTOR_H
+#define TRAMA_ROTOR_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class TramaRotor
+ * @brief Representa una trama ROTOR de la cascada de rotores
+ * 
+ * Rota el rotor indicado N posiciones, con arrastre a los rotores
+ * siguientes (ver RotorDeMapeo::rotarRotor()), sin cambiar la selección.
+ * Sin cascada, "R,0,N" equivale a "M,N" y los demás índices no tienen efecto.
+ * 
+ * Formato: R,I,N donde I es el índice del rotor y N la rotación
+ * Ejemplo: R,2,-1 significa "retroceder una posición el rotor 2"
+ */
+class TramaRotor : public TramaBase {
+private:
+    int indice;              ///< Rotor a mover
+    int rotacion;            ///< Número de posiciones a rotar (puede ser negativo)
+    
+public:
+    /**
+     * @brief Constructor
+     * @param i Índice del rotor
+     * @param n Número de posiciones a rotarlo
+     */
+    TramaRotor(int i, int n);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TramaRotor();
+    
+    /**
+     * @brief Procesa la trama ROTOR: rota el rotor indicado
+     * @param carga Lista de carga (no se utiliza)
+     * @param rotor Rotor (cascada) que será rotado
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Rota el rotor indicado (igual que procesar())
+     * @param rotor Rotor (cascada) que será rotado
+     */
+    void ajustarRotor(RotorDeMapeo* rotor) const override;
+    
+    /**
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
+     * @return Cadena con formato "R,I,N"
+     */
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
+    
+    /**
+     * @brief Obtiene la rotación equivalente sin cascada
+     * @return La rotación si mueve el rotor 0, 0 en otro caso
+     */
+    int obtenerRotacion() const override { return indice == 0 ? rotacion : 0; }
+    
+    /**
+     * @brief Obtiene el índice del rotor
+     * @return Rotor que mueve la trama
+     */
+    int obtenerIndice() const { return indice; }
+};
+
+#endif // TRAMA_ROTOR_H
@@ -0,0 +1,76 @@
+/**
+ * @file TramaSeleccion.h
+ * @brief Clase para tramas SELECT que eligen el rotor que mueven las tramas MAP
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ */
+
+#ifndef TRAMA_SELECCION_H
+#define TRAMA_SELECCION_H
+
+#include "TramaBase.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+
+/**
+ * @class TramaSeleccion
+ * @brief Representa una trama SELECT de la cascada de rotores
+ * 
+ * Elige qué rotor de la cascada rotan las tramas MAP siguientes. Sin
+ * cascada solo existe el rotor 0 y la trama no tiene efecto.
+ * 
+ * Formato: S,I donde I es el índice del rotor (0 = el primero)
+ * Ejemplo: S,1 significa "las tramas MAP mueven ahora el rotor 1"
+ */
+class TramaSeleccion : public TramaBase {
+private:
+    int indice;              ///< Rotor a seleccionar
+    
+public:
+    /**
+     * @brief Constructor
+     * @param i Índice del rotor a seleccionar
+     */
+    explicit TramaSeleccion(int i);
+    
+    /**
+     * @brief Destructor
+     */
+    ~TramaSeleccion();
+    
+    /**
+     * @brief Procesa la trama SELECT: cambia el rotor seleccionado
+     * @param carga Lista de carga (no se utiliza)
+     * @param rotor Rotor (cascada) cuya selección cambia
+     */
+    void procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) override;
+    
+    /**
+     * @brief Cambia el rotor seleccionado (igual que procesar())
+     * @param rotor Rotor (cascada) cuya selección cambia
+     */
+    void ajustarRotor(RotorDeMapeo* rotor) const override;
+    
+    /**
+     * @brief Escribe una representación en texto de la trama
+     * @param buffer Buffer de destino
+     * @param tamBuffer Tamaño del buffer
+     * @return Cadena con formato "S,I"
+     */
+    const char* obtenerRepresentacion(char* buffer, int tamBuffer) const override;
+    
+    /**
+     * @brief Imprime el resultado de procesar la trama
+     * @param carga Lista de carga después de procesar la trama
+     * @param rotor Rotor después de procesar la trama
+     */
+    void imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const override;
+    
+    /**
+     * @brief Obtiene el índice del rotor
+     * @return Rotor que selecciona la trama
+     */
+    int obtenerIndice() const { return indice; }
+};
+
+#endif // TRAMA_SELECCION_H
@@ -0,0 +1,170 @@
+/**
+ * @file prueba_asignaciones.cpp
+ * @brief Prueba: decodificar en régimen estable no pide memoria al montículo
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Reemplaza operator new en este ejecutable para contar las asignaciones.
+ * Un primer recorrido del flujo calienta la arena de tramas, el lote de
+ * carga y el pool de nodos; después se limpia la lista (sus nodos vuelven
+ * al pool) y se procesa el mismo flujo otra vez. En ese segundo recorrido
+ * no debe haber ninguna asignación, ni con tramas de texto ni binarias.
+ *
+ * Devuelve 0 si la prueba pasa y 1 si falla.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "FormatoBinario.h"
+
+// ---------------------------------------------------------------------------
+// Conteo de asignaciones
+// ---------------------------------------------------------------------------
+
+namespace {
+
+/// Llamadas a operator new desde el inicio del programa
+std::atomic<long long> asignaciones(0);
+
+} // namespace
+
+void* operator new(size_t n) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t n) {
+    asignaciones.fetch_add(1, std::memory_order_relaxed);
+    void* p = malloc(n ? n : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+namespace {
+
+/// Tramas del flujo de prueba
+const int TRAMAS_PRUEBA = 100000;
+
+/// Bytes reservados por trama (la más larga es un BULK de 40 caracteres)
+const int BYTES_POR_TRAMA = 48;
+
+/**
+ * @struct FlujoPrueba
+ * @brief Tramas generadas en memoria
+ */
+struct FlujoPrueba {
+    char* datos;            ///< Bytes de todas las tramas
+    VistaLinea* lineas;     ///< Vista de cada trama dentro de 'datos'
+    int cantidad;           ///< Número de tramas
+
+    FlujoPrueba() : datos(new char[TRAMAS_PRUEBA * BYTES_POR_TRAMA]),
+                    lineas(new VistaLinea[TRAMAS_PRUEBA]), cantidad(0) {}
+    ~FlujoPrueba() {
+        delete[] datos;
+        delete[] lineas;
+    }
+};
+
+/**
+ * @brief Genera un flujo con LOAD, MAP, BULK y alguna línea inválida
+ * @param binario Codificar las tramas en binario
+ * @param flujo Flujo donde se dejan las tramas
+ */
+void generarFlujo(bool binario, FlujoPrueba* flujo) {
+    const char* alfabeto = "ABCDEFGHIJKLMNOPQRSTUVWXYZ ";
+    unsigned int estado = 12345;
+    char linea[BYTES_POR_TRAMA];
+    char* escritura = flujo->datos;
+
+    for (int i = 0; i < TRAMAS_PRUEBA; ++i) {
+        estado = estado * 1103515245u + 12345u;
+        unsigned int r = (estado >> 8) % 100;
+        int n;
+
+        if (r < 10) {
+            n = sprintf(linea, "M,%d", static_cast<int>((estado >> 16) % 51) - 25);
+        } else if (r < 15) {
+            int largo = 1 + static_cast<int>((estado >> 16) % 40);
+            linea[0] = 'B';
+            linea[1] = ',';
+            for (int j = 0; j < largo; ++j) {
+                linea[2 + j] = alfabeto[(estado >> (j % 16)) % 27];
+            }
+            n = 2 + largo;
+        } else if (r < 16 && !binario) {
+            n = sprintf(linea, "basura");
+        } else {
+            n = sprintf(linea, "L,%c", alfabeto[(estado >> 16) % 27]);
+        }
+
+        if (binario) {
+            n = codificarLineaBinaria(linea, n, reinterpret_cast<unsigned char*>(escritura));
+        } else {
+            memcpy(escritura, linea, n);
+        }
+        flujo->lineas[i].datos = escritura;
+        flujo->lineas[i].longitud = n;
+        escritura += n;
+    }
+    flujo->cantidad = TRAMAS_PRUEBA;
+}
+
+/**
+ * @brief Procesa el flujo dos veces y cuenta las asignaciones de la segunda
+ * @param nombre Nombre del caso (para el informe)
+ * @param binario Usar tramas binarias
+ * @return true si la segunda pasada no asignó memoria
+ */
+bool probarRegimenEstable(const char* nombre, bool binario) {
+    FlujoPrueba flujo;
+    generarFlujo(binario, &flujo);
+
+    ListaDeCarga carga;
+    RotorDeMapeo rotor;
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(&carga, &rotor, &registro, false);
+
+    // Calentamiento: arena, lote y nodos del pool quedan reservados
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        procesador.procesarLinea(flujo.lineas[i].datos, flujo.lineas[i].longitud);
+    }
+    procesador.vaciarPendientes();
+    int caracteres = carga.obtenerTamanio();
+    carga.limpiar();
+
+    long long antes = asignaciones.load(std::memory_order_relaxed);
+    for (int i = 0; i < flujo.cantidad; ++i) {
+        procesador.procesarLinea(flujo.lineas[i].datos, flujo.lineas[i].longitud);
+    }
+    procesador.vaciarPendientes();
+    long long pedidas = asignaciones.load(std::memory_order_relaxed) - antes;
+
+    bool correcto = pedidas == 0 && carga.obtenerTamanio() == caracteres && caracteres > 0;
+    printf("%-8s %d tramas, %d caracteres: %lld asignación(es) en régimen estable -> %s\n",
+           nombre, flujo.cantidad, carga.obtenerTamanio(), pedidas, correcto ? "OK" : "FALLA");
+    return correcto;
+}
+
+} // namespace
+
+int main() {
+    bool correcto = true;
+    correcto = probarRegimenEstable("texto", false) && correcto;
+    correcto = probarRegimenEstable("binario", true) && correcto;
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file prueba_parada.cpp
+ * @brief Prueba: SIGTERM detiene el pipeline que lee un puerto con VMIN=1
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Abre una pseudoterminal como puerto serial con VMIN=1 y VTIME=0 (read()
+ * bloquearía sin límite) y sin plazo de inactividad, la decodifica con el
+ * pipeline en otro hilo, le escribe cuatro tramas y envía SIGTERM al
+ * proceso, como --desatendido --inactividad 0 --vmin 1 --vtime 0
+ * --pipeline. La señal la atiende cualquier hilo; el lector tiene que
+ * despertar por la tubería de aviso y el pipeline terminar en orden.
+ *
+ * Si el lector se queda bloqueado, alarm() mata el proceso y la prueba
+ * falla. Devuelve 0 si la prueba pasa y 1 si falla.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <csignal>
+#include <thread>
+#include <chrono>
+#include <fcntl.h>
+#include <unistd.h>
+#include "SerialPort.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "PipelineDecodificador.h"
+#include "ControlDeParada.h"
+
+namespace {
+
+/// Segundos tras los que se da la prueba por colgada
+const int LIMITE_SEGUNDOS = 10;
+
+/**
+ * @brief Decodifica el puerto con el pipeline hasta la parada
+ */
+void decodificar(SerialPort* puerto, ListaDeCarga* carga, int* tramas) {
+    RotorDeMapeo rotor;
+    PipelineDecodificador pipeline(puerto, carga, &rotor);
+    pipeline.establecerInactividad(0);
+    pipeline.establecerDesatendido(true);
+    *tramas = pipeline.ejecutar();
+}
+
+} // namespace
+
+int main() {
+    int maestro = posix_openpt(O_RDWR | O_NOCTTY);
+    if (maestro < 0 || grantpt(maestro) != 0 || unlockpt(maestro) != 0) {
+        printf("No se pudo crear la pseudoterminal\n");
+        return 1;
+    }
+
+    ConfiguracionSerial config;
+    config.vmin = 1;
+    config.vtime = 0;
+    SerialPort puerto(ptsname(maestro), config);
+    if (!puerto.estaConectado()) {
+        return 1;
+    }
+
+    // Como main(): parada ordenada y puerto sin plazo, atento a la tubería
+    ControlDeParada::instalar();
+    puerto.establecerEsperaMaxima(0);
+    puerto.establecerCancelacion(ControlDeParada::obtenerDescriptorAviso());
+    alarm(LIMITE_SEGUNDOS);
+
+    ListaDeCarga carga;
+    int tramas = 0;
+    std::thread decodificador(decodificar, &puerto, &carga, &tramas);
+
+    const char* datos = "L,H\nL,O\nL,L\nL,A\n";
+    if (write(maestro, datos, 16) != 16) {
+        printf("No se pudo escribir en la pseudoterminal\n");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+
+    kill(getpid(), SIGTERM);
+    decodificador.join();
+    close(maestro);
+
+    char mensaje[5] = {0};
+    carga.copiarDesde(0, mensaje, 4);
+    bool correcto = tramas == 4 && carga.obtenerTamanio() == 4 &&
+                    ControlDeParada::obtenerSenal() == SIGTERM;
+    printf("VMIN=1 VTIME=0, pipeline: %d trama(s), mensaje \"%s\", parada por señal %d -> %s\n",
+           tramas, mensaje, ControlDeParada::obtenerSenal(), correcto ? "OK" : "FALLA");
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file prueba_paralelo.cpp
+ * @brief Prueba: el decodificador paralelo divide y decodifica capturas binarias y mixtas
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Escribe capturas de varios MiB (binaria, mixta de texto y binario, y de
+ * texto con algún byte alto suelto), las decodifica con
+ * DecodificadorParalelo en cuatro hilos y compara el resultado con el
+ * bucle secuencial caracter a caracter. Las tramas M,10 llevan un byte
+ * '\n' dentro de la trama binaria, así que cortar en el primer '\n'
+ * separaría mal la captura.
+ *
+ * Además comprueba que cada captura se dividió en más de un tramo y que
+ * el repaso secuencial de los cortes recorrió pocos bytes frente al
+ * total. Devuelve 0 si la prueba pasa y 1 si falla.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "DecodificadorParalelo.h"
+#include "ArchivoMapeado.h"
+#include "FuenteReplay.h"
+#include "FormatoBinario.h"
+
+namespace {
+
+/// Hilos del decodificador paralelo
+const int HILOS_PRUEBA = 4;
+
+/// Tamaño aproximado de cada captura (varios tramos de 1 MiB)
+const long TAM_CAPTURA = 6L << 20;
+
+/// Fracción máxima de la captura que el repaso de los cortes puede recorrer en serie
+const int FRACCION_MAXIMA_EN_SERIE = 8;
+
+/// Captura a escribir
+enum TipoCaptura {
+    CAPTURA_BINARIA,        ///< Solo tramas binarias
+    CAPTURA_MIXTA,          ///< Texto y binario alternados
+    CAPTURA_TEXTO_ALTO      ///< Texto con un byte alto suelto al principio
+};
+
+/**
+ * @brief Escribe una trama en texto o en binario
+ */
+void escribirTrama(FILE* archivo, const char* linea, bool binario, unsigned char* codificada) {
+    int longitud = static_cast<int>(strlen(linea));
+    if (binario) {
+        int n = codificarLineaBinaria(linea, longitud, codificada);
+        fwrite(codificada, 1, n, archivo);
+    } else {
+        fwrite(linea, 1, longitud, archivo);
+        fputc('\n', archivo);
+    }
+}
+
+/**
+ * @brief Escribe una captura de unos TAM_CAPTURA bytes
+ * @param ruta Archivo a crear
+ * @param tipo Binaria, mixta o de texto con un byte alto
+ * @return false si no se pudo escribir
+ */
+bool escribirCaptura(const char* ruta, TipoCaptura tipo) {
+    FILE* archivo = fopen(ruta, "wb");
+    if (!archivo) {
+        fprintf(stderr, "No se pudo crear %s\n", ruta);
+        return false;
+    }
+
+    unsigned char* codificada = new unsigned char[MAX_TRAMA_BINARIA + 64];
+    if (tipo == CAPTURA_TEXTO_ALTO) {
+        fputs("L,\xC3\x91\n", archivo);  // Trama inválida: "L,Ñ" en UTF-8
+    }
+
+    char linea[64];
+    for (int i = 0; ftell(archivo) < TAM_CAPTURA; ++i) {
+        bool binario = tipo == CAPTURA_BINARIA || (tipo == CAPTURA_MIXTA && (i / 7) % 2 == 0);
+
+        snprintf(linea, sizeof(linea), "L,%c", 'A' + i % 26);
+        escribirTrama(archivo, linea, binario, codificada);
+        snprintf(linea, sizeof(linea), "M,%d", i % 3 == 0 ? 10 : i % 27);
+        escribirTrama(archivo, linea, binario, codificada);
+        snprintf(linea, sizeof(linea), "B,HOLA%c%cMUNDO", 'A' + i % 26, 'Z' - i % 26);
+        escribirTrama(archivo, linea, binario, codificada);
+    }
+
+    delete[] codificada;
+    fclose(archivo);
+    return true;
+}
+
+/**
+ * @brief Decodifica una captura con el bucle secuencial (como procesarFlujo)
+ */
+void decodificarSecuencial(const char* ruta, ListaDeCarga* carga) {
+    FuenteReplay fuente;
+    fuente.abrir(ruta);
+    RotorDeMapeo rotor;
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(carga, &rotor, &registro, false);
+
+    VistaLinea linea;
+    while (fuente.leerLineaVista(linea) > 0) {
+        procesador.procesarLinea(linea.datos, linea.longitud);
+    }
+    procesador.vaciarPendientes();
+}
+
+/**
+ * @brief Compara el decodificador paralelo con el secuencial sobre una captura
+ * @param nombre Nombre del caso (para el informe)
+ * @param tipo Captura a escribir
+ * @return true si los mensajes coinciden y la captura se dividió
+ */
+bool probarCaptura(const char* nombre, TipoCaptura tipo) {
+    const char* ruta = "prueba_paralelo.cap";
+    const char* rutaSalida = "prueba_paralelo.txt";
+    if (!escribirCaptura(ruta, tipo)) {
+        return false;
+    }
+
+    ListaDeCarga secuencial;
+    decodificarSecuencial(ruta, &secuencial);
+
+    DecodificadorParalelo decodificador(HILOS_PRUEBA);
+    ArchivoMapeado entrada;
+    bool correcto = entrada.abrir(ruta) && decodificador.decodificar(entrada, rutaSalida);
+    size_t bytesCaptura = entrada.obtenerTamanio();
+    entrada.cerrar();
+
+    ArchivoMapeado salida;
+    correcto = correcto && salida.abrir(rutaSalida);
+    int esperado = secuencial.obtenerTamanio();
+    size_t obtenido = salida.obtenerTamanio();
+    correcto = correcto && esperado > 0 && obtenido == static_cast<size_t>(esperado);
+    if (correcto) {
+        char* a = new char[esperado];
+        secuencial.copiarDesde(0, a, esperado);
+        correcto = memcmp(a, salida.obtenerDatos(), esperado) == 0;
+        delete[] a;
+    }
+    salida.cerrar();
+    remove(ruta);
+    remove(rutaSalida);
+
+    int tramos = decodificador.obtenerNumTramos();
+    size_t enSerie = decodificador.obtenerBytesRecorridosEnSerie();
+    correcto = correcto && tramos > 1 && enSerie < bytesCaptura / FRACCION_MAXIMA_EN_SERIE;
+
+    fprintf(stderr, "%-12s %lu bytes: %d tramo(s), %lu en serie, secuencial %d, paralelo %lu caracteres -> %s\n",
+            nombre, static_cast<unsigned long>(bytesCaptura), tramos, static_cast<unsigned long>(enSerie),
+            esperado, static_cast<unsigned long>(obtenido), correcto ? "OK" : "FALLA");
+    return correcto;
+}
+
+} // namespace
+
+int main() {
+    bool correcto = true;
+    correcto = probarCaptura("binaria", CAPTURA_BINARIA) && correcto;
+    correcto = probarCaptura("mixta", CAPTURA_MIXTA) && correcto;
+    correcto = probarCaptura("texto+alto", CAPTURA_TEXTO_ALTO) && correcto;
+    return correcto ? 0 : 1;
+}
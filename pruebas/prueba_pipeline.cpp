@@ -0,0 +1,175 @@
+/**
+ * @file prueba_pipeline.cpp
+ * @brief Prueba: el pipeline decodifica lo mismo que el bucle secuencial
+ * @author Sistema de Decodificación PRT-7
+ * @date 2025
+ *
+ * Escribe capturas de texto y binarias con tramas BULK más largas que
+ * TAM_LINEA_PIPELINE (600 caracteres, y 4000 en binario, cerca de
+ * MAX_CARGA_BULK_BINARIA), las reproduce con FuenteReplay por los dos
+ * caminos y compara los mensajes caracter a caracter. Una captura repite
+ * el BULK largo hasta dar varias vueltas al anillo de desborde y otra
+ * tiene un BULK más largo que el anillo entero, que obliga a agrandarlo.
+ *
+ * El pipeline escribe el mensaje en stdout, así que stdout se descarta y
+ * el informe va a stderr. Devuelve 0 si la prueba pasa y 1 si falla.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include "RotorDeMapeo.h"
+#include "ListaDeCarga.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "PipelineDecodificador.h"
+#include "FuenteReplay.h"
+#include "FormatoBinario.h"
+
+namespace {
+
+#ifdef _WIN32
+const char* const DISPOSITIVO_NULO = "NUL";
+#else
+const char* const DISPOSITIVO_NULO = "/dev/null";
+#endif
+
+/// Caracteres del BULK largo de texto
+const int LARGO_BULK_TEXTO = 600;
+
+/// Caracteres del BULK largo binario
+const int LARGO_BULK_BINARIO = 4000;
+
+/// Repeticiones de la captura para dar varias vueltas al anillo de desborde
+const int REPETICIONES_VUELTAS = 3 * TAM_DESBORDE_PIPELINE / LARGO_BULK_BINARIO;
+
+/// Caracteres de un BULK de texto que no cabe en el anillo de desborde
+const int LARGO_BULK_ENORME = TAM_DESBORDE_PIPELINE + 1000;
+
+/**
+ * @brief Escribe una captura: L,A / BULK largo / M,3 / L,Z / BULK corto
+ * @param ruta Archivo a crear
+ * @param largoBulk Caracteres del BULK largo
+ * @param binario Codificar las tramas en binario
+ * @param repeticiones Veces que se repiten las cinco tramas
+ * @return false si no se pudo escribir
+ */
+bool escribirCaptura(const char* ruta, int largoBulk, bool binario, int repeticiones) {
+    FILE* archivo = fopen(ruta, "wb");
+    if (!archivo) {
+        fprintf(stderr, "No se pudo crear %s\n", ruta);
+        return false;
+    }
+
+    char* bulk = new char[largoBulk + 2];
+    bulk[0] = 'B';
+    bulk[1] = ',';
+    for (int i = 0; i < largoBulk; ++i) {
+        bulk[2 + i] = static_cast<char>('A' + i % 26);
+    }
+
+    const char* lineas[] = {"L,A", bulk, "M,3", "L,Z", "B,HOLA"};
+    int longitudes[] = {3, largoBulk + 2, 3, 3, 6};
+    unsigned char* codificada = new unsigned char[MAX_TRAMA_BINARIA];
+
+    for (int r = 0; r < repeticiones; ++r) {
+        for (int i = 0; i < 5; ++i) {
+            if (binario) {
+                int n = codificarLineaBinaria(lineas[i], longitudes[i], codificada);
+                fwrite(codificada, 1, n, archivo);
+            } else {
+                fwrite(lineas[i], 1, longitudes[i], archivo);
+                fputc('\n', archivo);
+            }
+        }
+    }
+
+    delete[] codificada;
+    delete[] bulk;
+    fclose(archivo);
+    return true;
+}
+
+/**
+ * @brief Decodifica una captura con el bucle secuencial (como procesarFlujo)
+ */
+void decodificarSecuencial(const char* ruta, ListaDeCarga* carga) {
+    FuenteReplay fuente;
+    fuente.abrir(ruta);
+    RotorDeMapeo rotor;
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(carga, &rotor, &registro, false);
+
+    VistaLinea linea;
+    while (fuente.leerLineaVista(linea) > 0) {
+        procesador.procesarLinea(linea.datos, linea.longitud);
+    }
+    procesador.vaciarPendientes();
+}
+
+/**
+ * @brief Decodifica una captura con el pipeline de tres hilos
+ */
+void decodificarPipeline(const char* ruta, ListaDeCarga* carga) {
+    FuenteReplay fuente;
+    fuente.abrir(ruta);
+    RotorDeMapeo rotor;
+    PipelineDecodificador pipeline(&fuente, carga, &rotor);
+    pipeline.establecerDesatendido(true);
+    pipeline.ejecutar();
+}
+
+/**
+ * @brief Compara los dos caminos sobre una captura
+ * @param nombre Nombre del caso (para el informe)
+ * @param largoBulk Caracteres del BULK largo
+ * @param binario Captura binaria
+ * @param repeticiones Veces que se repiten las cinco tramas
+ * @return true si los mensajes coinciden
+ */
+bool probarCaptura(const char* nombre, int largoBulk, bool binario, int repeticiones = 1) {
+    const char* ruta = binario ? "prueba_pipeline.bin" : "prueba_pipeline.txt";
+    if (!escribirCaptura(ruta, largoBulk, binario, repeticiones)) {
+        return false;
+    }
+
+    ListaDeCarga secuencial;
+    ListaDeCarga paralela;
+    decodificarSecuencial(ruta, &secuencial);
+    decodificarPipeline(ruta, &paralela);
+    remove(ruta);
+
+    int esperado = (1 + largoBulk + 1 + 4) * repeticiones;
+    bool correcto = secuencial.obtenerTamanio() == esperado &&
+                    paralela.obtenerTamanio() == esperado;
+    if (correcto) {
+        char* a = new char[esperado];
+        char* b = new char[esperado];
+        secuencial.copiarDesde(0, a, esperado);
+        paralela.copiarDesde(0, b, esperado);
+        correcto = memcmp(a, b, esperado) == 0;
+        delete[] a;
+        delete[] b;
+    }
+
+    fprintf(stderr, "%-8s BULK de %d x %d: secuencial %d, pipeline %d caracteres (esperados %d) -> %s\n",
+            nombre, largoBulk, repeticiones, secuencial.obtenerTamanio(), paralela.obtenerTamanio(),
+            esperado, correcto ? "OK" : "FALLA");
+    return correcto;
+}
+
+} // namespace
+
+int main() {
+    if (!freopen(DISPOSITIVO_NULO, "w", stdout)) {
+        return 1;
+    }
+
+    bool correcto = true;
+    correcto = probarCaptura("texto", LARGO_BULK_TEXTO, false) && correcto;
+    correcto = probarCaptura("texto", LARGO_BULK_BINARIO, false) && correcto;
+    correcto = probarCaptura("binario", LARGO_BULK_BINARIO, true) && correcto;
+    correcto = probarCaptura("binario", LARGO_BULK_BINARIO, true, REPETICIONES_VUELTAS) && correcto;
+    correcto = probarCaptura("texto", LARGO_BULK_ENORME, false) && correcto;
+    return correcto ? 0 : 1;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file AnalizadorPorLotes.cpp
+ * @brief Implementación del analizador de tramas por lotes
+ */
+
+#include "AnalizadorPorLotes.h"
+#include "FormatoBinario.h"
+#include "RotorDeMapeo.h"  // Para MAX_ROTORES_CASCADA
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief Indica si un índice de rotor puede existir en una cascada
+ */
+inline bool esIndiceDeRotor(long long indice) {
+    return indice >= 0 && indice < MAX_ROTORES_CASCADA;
+}
+
+} // namespace
+
+AnalizadorPorLotes::AnalizadorPorLotes(const char* delimitadorFin)
+    : tramas(new TramaCompacta[CAPACIDAD_LOTE_TRAMAS]),
+      longitudDelimitador(0),
+      caminoDirecto(true) {
+    strncpy(delimitador, delimitadorFin, LONGITUD_MAX_DELIMITADOR);
+    delimitador[LONGITUD_MAX_DELIMITADOR] = '\0';
+    longitudDelimitador = static_cast<int>(strlen(delimitador));
+    
+    // Un delimitador con forma "L,X" se reconocería como LOAD en el camino directo
+    caminoDirecto = !(longitudDelimitador == 3 && (delimitador[0] == 'L' || delimitador[0] == 'l') &&
+                      delimitador[1] == ',');
+    
+    for (int i = 0; i < NUM_CONTADORES_METRICA; ++i) {
+        invalidas[i] = 0;
+    }
+}
+
+AnalizadorPorLotes::~AnalizadorPorLotes() {
+    delete[] tramas;
+}
+
+void AnalizadorPorLotes::analizarTexto(const char* linea, int longitud, TramaCompacta* trama) {
+    // Mismo orden de comprobaciones que RegistroDeTramas::parsear()
+    if (longitud == longitudDelimitador && memcmp(linea, delimitador, longitud) == 0) {
+        trama->tipo = COMPACTA_FIN;
+        return;
+    }
+    if (longitud < 3) {
+        rechazar(trama, CONTADOR_INVALIDA_CORTA, longitud);
+        return;
+    }
+    if (linea[1] != ',') {
+        rechazar(trama, CONTADOR_INVALIDA_SIN_COMA, longitud);
+        return;
+    }
+    
+    const char* dato = linea + 2;
+    int longitudDato = longitud - 2;
+    
+    switch (linea[0]) {
+        case 'L': case 'l':
+            trama->tipo = COMPACTA_LOAD;
+            trama->valor = static_cast<unsigned char>(dato[0]);
+            return;
+        
+        case 'M': case 'm':
+            trama->tipo = COMPACTA_MAP;
+            trama->valor = enteroDesdeTexto(dato, longitudDato);
+            return;
+        
+        case 'B': case 'b':
+            trama->tipo = COMPACTA_BULK;
+            trama->valor = longitudDato;
+            trama->posicion += 2;
+            return;
+        
+        case 'S': case 's': {
+            int indice = enteroDesdeTexto(dato, longitudDato);
+            if (!esIndiceDeRotor(indice)) break;
+            trama->tipo = COMPACTA_SELECCION;
+            trama->valor = indice;
+            return;
+        }
+        
+        case 'R': case 'r': {
+            const char* coma = static_cast<const char*>(memchr(dato, ',', longitudDato));
+            if (!coma) break;
+            int longitudIndice = static_cast<int>(coma - dato);
+            int indice = enteroDesdeTexto(dato, longitudIndice);
+            if (!esIndiceDeRotor(indice)) break;
+            trama->tipo = COMPACTA_ROTOR;
+            trama->rotor = static_cast<unsigned char>(indice);
+            trama->valor = enteroDesdeTexto(coma + 1, longitudDato - longitudIndice - 1);
+            return;
+        }
+        
+        default:
+            rechazar(trama, CONTADOR_INVALIDA_TIPO, longitud);
+            return;
+    }
+    
+    rechazar(trama, CONTADOR_INVALIDA_DATO, longitud);
+}
+
+void AnalizadorPorLotes::analizarBinaria(const unsigned char* bytes, int longitud, TramaCompacta* trama) {
+    // Mismas reglas que las fábricas binarias de RegistroDeTramas
+    const unsigned char* dato = bytes + 1;
+    int longitudDato = longitud - 1;
+    unsigned int valor;
+    int usados;
+    
+    switch (bytes[0]) {
+        case ETIQUETA_LOAD:
+            if (longitudDato != 1) break;
+            trama->tipo = COMPACTA_LOAD;
+            trama->valor = dato[0];
+            return;
+        
+        case ETIQUETA_MAP:
+            usados = leerVarint(dato, longitudDato, &valor);
+            if (usados <= 0 || usados != longitudDato) break;
+            trama->tipo = COMPACTA_MAP;
+            trama->valor = decodificarZigzag(valor);
+            return;
+        
+        case ETIQUETA_BULK:
+            usados = leerVarint(dato, longitudDato, &valor);
+            if (usados <= 0 || valor == 0 || static_cast<unsigned int>(longitudDato - usados) != valor) break;
+            trama->tipo = COMPACTA_BULK;
+            trama->valor = static_cast<int>(valor);
+            trama->posicion += 1 + usados;
+            return;
+        
+        case ETIQUETA_SELECCION:
+            usados = leerVarint(dato, longitudDato, &valor);
+            if (usados <= 0 || usados != longitudDato || !esIndiceDeRotor(valor)) break;
+            trama->tipo = COMPACTA_SELECCION;
+            trama->valor = static_cast<int>(valor);
+            return;
+        
+        case ETIQUETA_ROTOR: {
+            unsigned int indice;
+            usados = leerVarint(dato, longitudDato, &indice);
+            if (usados <= 0 || !esIndiceDeRotor(indice)) break;
+            int segundo = leerVarint(dato + usados, longitudDato - usados, &valor);
+            if (segundo <= 0 || usados + segundo != longitudDato) break;
+            trama->tipo = COMPACTA_ROTOR;
+            trama->rotor = static_cast<unsigned char>(indice);
+            trama->valor = decodificarZigzag(valor);
+            return;
+        }
+        
+        case ETIQUETA_FIN:
+            if (longitudDato != 0) break;
+            trama->tipo = COMPACTA_FIN;
+            return;
+        
+        default:
+            rechazar(trama, CONTADOR_INVALIDA_TIPO, longitud);
+            return;
+    }
+    
+    rechazar(trama, CONTADOR_INVALIDA_DATO, longitud);
+}
+
+int AnalizadorPorLotes::analizar(const char* datos, size_t disponibles, size_t* consumidos) {
+    const char* p = datos;
+    const char* fin = datos + disponibles;
+    int n = 0;
+    
+    while (n < CAPACIDAD_LOTE_TRAMAS && p < fin) {
+        TramaCompacta* trama = tramas + n;
+        trama->posicion = static_cast<unsigned int>(p - datos);
+        trama->rotor = 0;
+        unsigned char tipo = static_cast<unsigned char>(*p);
+        
+        // Camino directo para "L,X\n" y "L,X\r\n": sin buscar el salto de línea
+        if ((tipo == 'L' || tipo == 'l') && caminoDirecto && fin - p >= 4 &&
+            p[1] == ',' && p[2] != '\n' && p[2] != '\r') {
+            int salto = p[3] == '\n' ? 4 : (p[3] == '\r' && fin - p >= 5 && p[4] == '\n') ? 5 : 0;
+            if (salto) {
+                trama->tipo = COMPACTA_LOAD;
+                trama->valor = static_cast<unsigned char>(p[2]);
+                p += salto;
+                n++;
+                continue;
+            }
+        }
+        
+        // Camino directo para la LOAD binaria: etiqueta y carácter
+        if (tipo == ETIQUETA_LOAD && fin - p >= 2) {
+            trama->tipo = COMPACTA_LOAD;
+            trama->valor = static_cast<unsigned char>(p[1]);
+            p += 2;
+            n++;
+            continue;
+        }
+        
+        if (esTramaBinaria(tipo)) {
+            size_t longitud = longitudTramaBinaria(p, static_cast<size_t>(fin - p));
+            if (longitud == 0) {
+                longitud = static_cast<size_t>(fin - p);  // Trama truncada al final del buffer
+            }
+            analizarBinaria(reinterpret_cast<const unsigned char*>(p), static_cast<int>(longitud), trama);
+            p += longitud;
+            n++;
+            continue;
+        }
+        
+        const char* salto = static_cast<const char*>(memchr(p, '\n', static_cast<size_t>(fin - p)));
+        const char* siguiente = salto ? salto + 1 : fin;
+        int largo = static_cast<int>((salto ? salto : fin) - p);
+        if (largo > 0 && p[largo - 1] == '\r') {
+            largo--;
+        }
+        
+        // Las líneas vacías separan ráfagas: no son tramas
+        if (largo > 0) {
+            analizarTexto(p, largo, trama);
+            n++;
+        }
+        p = siguiente;
+    }
+    
+    *consumidos = static_cast<size_t>(p - datos);
+    return n;
+}
+
+void AnalizadorPorLotes::publicarInvalidas() {
+    const ContadorMetrica motivos[] = {
+        CONTADOR_INVALIDA_CORTA, CONTADOR_INVALIDA_SIN_COMA, CONTADOR_INVALIDA_TIPO, CONTADOR_INVALIDA_DATO
+    };
+    
+    for (size_t i = 0; i < sizeof(motivos) / sizeof(motivos[0]); ++i) {
+        if (invalidas[motivos[i]] > 0) {
+            Metricas::sumar(motivos[i], static_cast<unsigned long long>(invalidas[motivos[i]]));
+            invalidas[motivos[i]] = 0;
+        }
+    }
+}
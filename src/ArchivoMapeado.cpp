@@ -0,0 +1,98 @@
+/**
+ * @file ArchivoMapeado.cpp
+ * @brief Implementación de la proyección de archivos en memoria
+ */
+
+#include "ArchivoMapeado.h"
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
+ArchivoMapeado::ArchivoMapeado() : datos(nullptr), tamanio(0), mapeado(false) {
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    cerrar();
+}
+
+bool ArchivoMapeado::abrir(const char* ruta) {
+    cerrar();
+    
+#ifndef _WIN32
+    int descriptor = open(ruta, O_RDONLY);
+    if (descriptor < 0) {
+        fprintf(stderr, "Error: No se pudo abrir %s: %s\n", ruta, strerror(errno));
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(descriptor, &info) != 0) {
+        fprintf(stderr, "Error: No se pudo consultar %s: %s\n", ruta, strerror(errno));
+        close(descriptor);
+        return false;
+    }
+    
+    tamanio = static_cast<size_t>(info.st_size);
+    if (tamanio > 0) {
+        void* proyeccion = mmap(nullptr, tamanio, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (proyeccion == MAP_FAILED) {
+            fprintf(stderr, "Error: No se pudo proyectar %s: %s\n", ruta, strerror(errno));
+            close(descriptor);
+            tamanio = 0;
+            return false;
+        }
+        
+        // La captura se recorre de principio a fin: pedir lectura anticipada
+        madvise(proyeccion, tamanio, MADV_SEQUENTIAL);
+        datos = static_cast<const char*>(proyeccion);
+        mapeado = true;
+    }
+    
+    // La proyección sigue siendo válida después de cerrar el descriptor
+    close(descriptor);
+    return true;
+#else
+    FILE* archivo = fopen(ruta, "rb");
+    if (!archivo) {
+        fprintf(stderr, "Error: No se pudo abrir %s: %s\n", ruta, strerror(errno));
+        return false;
+    }
+    
+    fseek(archivo, 0, SEEK_END);
+    long longitud = ftell(archivo);
+    fseek(archivo, 0, SEEK_SET);
+    
+    if (longitud > 0) {
+        char* contenido = new char[longitud];
+        tamanio = fread(contenido, 1, longitud, archivo);
+        datos = contenido;
+    }
+    fclose(archivo);
+    return true;
+#endif
+}
+
+void ArchivoMapeado::cerrar() {
+    if (datos) {
+#ifndef _WIN32
+        if (mapeado) {
+            munmap(const_cast<char*>(datos), tamanio);
+        } else {
+            delete[] datos;
+        }
+#else
+        delete[] datos;
+#endif
+    }
+    
+    datos = nullptr;
+    tamanio = 0;
+    mapeado = false;
+}
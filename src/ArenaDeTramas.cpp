@@ -0,0 +1,37 @@
+/**
+ * @file ArenaDeTramas.cpp
+ * @brief Implementación de la arena de tramas
+ */
+
+#include "ArenaDeTramas.h"
+
+namespace {
+
+/// Alineación suficiente para cualquier trama (punteros, int, vtable)
+const size_t ALINEACION_ARENA = 16;
+
+} // namespace
+
+ArenaDeTramas::ArenaDeTramas(size_t capacidadBytes)
+    : memoria(new unsigned char[capacidadBytes + ALINEACION_ARENA]),
+      capacidad(capacidadBytes),
+      usado(0) {
+}
+
+ArenaDeTramas::~ArenaDeTramas() {
+    delete[] memoria;
+}
+
+void* ArenaDeTramas::reservar(size_t tam) {
+    // Alinear el inicio del bloque y el tamaño pedido
+    size_t base = reinterpret_cast<size_t>(memoria);
+    size_t inicio = (base + usado + ALINEACION_ARENA - 1) & ~(ALINEACION_ARENA - 1);
+    size_t fin = inicio + tam;
+    
+    if (fin > base + capacidad + ALINEACION_ARENA) {
+        return nullptr;
+    }
+    
+    usado = fin - base;
+    return reinterpret_cast<void*>(inicio);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file Bitacora.cpp
+ * @brief Implementación de la bitácora asíncrona
+ */
+
+#include "Bitacora.h"
+#include <cerrno>
+
+namespace {
+
+/**
+ * @brief Escribe bytes de una trama: imprimibles tal cual, el resto como \xHH
+ */
+void escribirBytes(EscritorBuffer* escritor, const char* bytes, int n) {
+    for (int i = 0; i < n; ++i) {
+        unsigned char c = static_cast<unsigned char>(bytes[i]);
+        if (c >= 0x20 && c < 0x7F) {
+            escritor->escribir(bytes + i, 1);
+        } else {
+            escritor->escribirFormato("\\x%02X", c);
+        }
+    }
+}
+
+} // namespace
+
+Bitacora::Bitacora(NivelBitacora nivelBitacora, int capacidad)
+    : nivel(nivelBitacora),
+      cola(static_cast<size_t>(capacidad)),
+      archivo(nullptr),
+      archivoPropio(false),
+      inicioNs(relojNs()),
+      descartados(0),
+      enMarcha(false) {
+}
+
+Bitacora::~Bitacora() {
+    detener();
+}
+
+bool Bitacora::iniciar(const char* ruta) {
+    if (ruta && strcmp(ruta, "-") != 0) {
+        archivo = fopen(ruta, "a");
+        if (!archivo) {
+            fprintf(stderr, "Error: No se pudo abrir la bitácora %s: %s\n", ruta, strerror(errno));
+            return false;
+        }
+        archivoPropio = true;
+    } else {
+        archivo = stderr;
+    }
+
+    inicioNs = relojNs();
+    hilo = std::thread(&Bitacora::ejecutar, this);
+    enMarcha = true;
+    return true;
+}
+
+void Bitacora::detener() {
+    if (!enMarcha) return;
+
+    cola.cerrar();
+    hilo.join();
+    enMarcha = false;
+
+    if (descartados > 0) {
+        fprintf(archivo, "Bitácora: %lld registro(s) descartados por cola llena\n", descartados);
+    }
+    if (archivoPropio) {
+        fclose(archivo);
+    } else {
+        fflush(archivo);
+    }
+    archivo = nullptr;
+    archivoPropio = false;
+}
+
+void Bitacora::ejecutar() {
+    EscritorBuffer escritor(archivo);
+    bool pendiente = false;
+
+    while (true) {
+        RegistroBitacora* registro = cola.frente();
+
+        if (!registro) {
+            // Nada en la cola: entregar lo formateado antes de esperar
+            if (pendiente) {
+                escritor.vaciar();
+                pendiente = false;
+            }
+            if (cola.estaCerrada() && !cola.frente()) {
+                break;
+            }
+            cola.esperarElementos();
+            continue;
+        }
+
+        formatear(*registro, &escritor);
+        cola.liberar();
+        pendiente = true;
+    }
+}
+
+void Bitacora::formatear(const RegistroBitacora& registro, EscritorBuffer* escritor) const {
+    long long ns = registro.instanteNs - inicioNs;
+    escritor->escribirFormato("[%6lld.%06lld] ", ns / 1000000000LL, (ns / 1000LL) % 1000000LL);
+    if (registro.flujo > 0) {
+        escritor->escribirFormato("#%d ", registro.flujo - 1);
+    }
+
+    switch (registro.evento) {
+        case EVENTO_CARGA:
+        case EVENTO_TRAMA:
+        case EVENTO_INVALIDA: {
+            const char* etiqueta = registro.evento == EVENTO_INVALIDA ? "Trama inválida: [" : "Trama recibida: [";
+            escritor->escribir(etiqueta, static_cast<int>(strlen(etiqueta)));
+            escribirBytes(escritor, registro.texto, registro.longitudTexto);
+            if (registro.extra > registro.longitudTexto) {
+                escritor->escribirFormato("...] (%d bytes)", registro.extra);
+            } else {
+                escritor->escribir("]", 1);
+            }
+
+            if (registro.evento == EVENTO_CARGA) {
+                escritor->escribirFormato(" -> Carácter en lote (%d pendiente(s))", registro.valor);
+            } else if (registro.evento == EVENTO_TRAMA) {
+                escritor->escribirFormato(" -> Rotor en %d, cabeza en '", registro.valor);
+                escribirBytes(escritor, &registro.caracter, 1);
+                escritor->escribir("'", 1);
+            }
+            break;
+        }
+
+        case EVENTO_MENSAJE:
+            escritor->escribirFormato("FIN DE MENSAJE: mensaje %d escrito", registro.valor);
+            break;
+
+        case EVENTO_LOTE:
+            escritor->escribirFormato("Lote de %d carácter(es) decodificado", registro.valor);
+            break;
+
+        case EVENTO_VOLCADO:
+            escritor->escribirFormato("Ventana llena: %d carácter(es) escritos antes del FIN", registro.valor);
+            break;
+
+        case EVENTO_PUNTO:
+            escritor->escribirFormato(registro.valor ? "Punto de control guardado tras %d trama(s)"
+                                                     : "Error: No se pudo guardar el punto de control tras %d trama(s)",
+                                      registro.extra);
+            break;
+
+        case EVENTO_PAUSA:
+            escritor->escribirFormato("Sin datos (%d trama(s) procesadas)", registro.valor);
+            break;
+
+        case EVENTO_FIN_FLUJO:
+            escritor->escribirFormato("Fin del flujo: %d trama(s) procesadas, %d inválida(s)",
+                                      registro.valor, registro.extra);
+            break;
+
+        default:
+            escritor->escribirFormato("Evento desconocido %d", registro.evento);
+            break;
+    }
+    escritor->escribir("\n", 1);
+}
+
+bool nivelBitacoraDesdeTexto(const char* nombre, NivelBitacora* nivel) {
+    if (strcmp(nombre, "apagada") == 0)         *nivel = BITACORA_APAGADA;
+    else if (strcmp(nombre, "resumen") == 0)    *nivel = BITACORA_RESUMEN;
+    else if (strcmp(nombre, "trama") == 0)      *nivel = BITACORA_TRAMA;
+    else if (strcmp(nombre, "depuracion") == 0) *nivel = BITACORA_DEPURACION;
+    else return false;
+    return true;
+}
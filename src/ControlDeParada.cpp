@@ -0,0 +1,61 @@
+/**
+ * @file ControlDeParada.cpp
+ * @brief Implementación de la parada ordenada por señal
+ */
+
+#include "ControlDeParada.h"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+volatile sig_atomic_t ControlDeParada::senalRecibida = 0;
+int ControlDeParada::tuberiaAviso[2] = {-1, -1};
+
+namespace {
+
+/**
+ * @brief Manejador de SIGTERM y SIGINT: solo anota la petición
+ */
+void manejarParada(int senal) {
+    ControlDeParada::solicitar(senal);
+}
+
+} // namespace
+
+void ControlDeParada::solicitar(int senal) {
+    senalRecibida = senal;
+#ifndef _WIN32
+    if (tuberiaAviso[1] >= 0) {
+        int errnoPrevio = errno;  // El código interrumpido puede estar leyendo errno
+        char aviso = 1;
+        ssize_t escritos = write(tuberiaAviso[1], &aviso, 1);
+        (void)escritos;  // Tubería llena: ya hay un aviso pendiente
+        errno = errnoPrevio;
+    }
+#endif
+}
+
+void ControlDeParada::instalar() {
+#ifdef _WIN32
+    // signal() ya restaura la acción por defecto al entregar la señal
+    signal(SIGINT, manejarParada);
+    signal(SIGTERM, manejarParada);
+#else
+    if (tuberiaAviso[0] < 0 && pipe(tuberiaAviso) == 0) {
+        for (int i = 0; i < 2; ++i) {
+            fcntl(tuberiaAviso[i], F_SETFL, fcntl(tuberiaAviso[i], F_GETFL) | O_NONBLOCK);
+            fcntl(tuberiaAviso[i], F_SETFD, FD_CLOEXEC);
+        }
+    }
+    
+    struct sigaction accion;
+    sigemptyset(&accion.sa_mask);
+    accion.sa_handler = manejarParada;
+    accion.sa_flags = SA_RESETHAND;  // Sin SA_RESTART: las lecturas bloqueadas vuelven con EINTR
+    sigaction(SIGINT, &accion, nullptr);
+    sigaction(SIGTERM, &accion, nullptr);
+#endif
+}
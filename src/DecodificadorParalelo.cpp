@@ -0,0 +1,508 @@
+/**
+ * @file DecodificadorParalelo.cpp
+ * @brief Implementación de la decodificación paralela de capturas
+ */
+
+#include "DecodificadorParalelo.h"
+#include "RotorDeMapeo.h"
+#include "FormatoBinario.h"
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <thread>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+namespace {
+
+/// Tramos por hilo: más de uno reparte mejor la carga si los tramos difieren
+const int TRAMOS_POR_HILO = 4;
+
+/// Tamaño mínimo de un tramo (capturas pequeñas no se fragmentan de más)
+const size_t TAM_MINIMO_TRAMO = 1 << 20;
+
+/// Bytes que se revisan de una vez al buscar tramas binarias
+const size_t BLOQUE_REVISION = 4096;
+
+/// Bytes tras el punto proporcional donde se busca un inicio de trama probable
+const size_t VENTANA_RESINCRONIZACION = 64 * 1024;
+
+/// Tramas seguidas con forma válida que confirman un inicio probable
+const int TRAMAS_CONFIRMACION = 8;
+
+/// Bytes máximos que se miran para confirmar un inicio probable
+const size_t BYTES_CONFIRMACION = 16 * 1024;
+
+/**
+ * @brief Indica si la captura tiene algún byte >= 0x80
+ * 
+ * Sin esos bytes no hay tramas binarias y la captura puede cortarse en
+ * cualquier '\n'. El bucle interno se vectoriza, así que la revisión es
+ * mucho más rápida que recorrer las tramas.
+ */
+bool contieneBytesAltos(const char* datos, size_t tamanio) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(datos);
+    
+    for (size_t i = 0; i < tamanio; i += BLOQUE_REVISION) {
+        size_t fin = tamanio - i < BLOQUE_REVISION ? tamanio : i + BLOQUE_REVISION;
+        unsigned char acumulado = 0;
+        for (size_t j = i; j < fin; ++j) {
+            acumulado |= bytes[j];
+        }
+        if (acumulado & 0x80) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Indica si una trama delimitada tiene la forma de una trama del protocolo
+ * 
+ * Solo mira la forma (etiqueta binaria conocida y completa, o "X,..." /
+ * "FIN" en texto), no el dato: sirve para elegir cortes, no para parsear.
+ */
+bool pareceTrama(const VistaLinea& trama, bool completa) {
+    if (trama.longitud == 0) {
+        return true;  // Línea vacía
+    }
+    unsigned char primero = static_cast<unsigned char>(trama.datos[0]);
+    if (esTramaBinaria(primero)) {
+        return completa && primero >= ETIQUETA_LOAD && primero <= ETIQUETA_FIN;
+    }
+    return completa && ((trama.longitud >= 3 && trama.datos[1] == ',') ||
+                        (trama.longitud == 3 && memcmp(trama.datos, "FIN", 3) == 0));
+}
+
+/**
+ * @brief Busca desde 'objetivo' un byte que probablemente inicie una trama
+ * 
+ * Una trama de texto empieza tras un '\n' y una binaria en una etiqueta;
+ * el candidato se acepta si desde él se leen TRAMAS_CONFIRMACION tramas
+ * con forma válida. Es solo una suposición: el recorrido de la fase 0
+ * comprueba si coincide con los límites reales.
+ * 
+ * @return Posición del candidato, u 'objetivo' si no hay ninguno en la ventana
+ */
+size_t buscarInicioProbable(const char* datos, size_t tamanio, size_t objetivo) {
+    size_t limite = tamanio - objetivo < VENTANA_RESINCRONIZACION ? tamanio
+                  : objetivo + VENTANA_RESINCRONIZACION;
+    
+    for (size_t candidato = objetivo; candidato < limite; ++candidato) {
+        unsigned char byte = static_cast<unsigned char>(datos[candidato]);
+        bool posible = (candidato > 0 && datos[candidato - 1] == '\n') ||
+                       (byte >= ETIQUETA_LOAD && byte <= ETIQUETA_FIN);
+        if (!posible) continue;
+        
+        size_t fin = tamanio - candidato < BYTES_CONFIRMACION ? tamanio : candidato + BYTES_CONFIRMACION;
+        size_t posicion = candidato;
+        int validas = 0;
+        while (validas < TRAMAS_CONFIRMACION && posicion < fin) {
+            VistaLinea trama;
+            size_t consumidos = delimitarTrama(datos + posicion, fin - posicion, &trama);
+            bool completa = posicion + consumidos < fin || fin == tamanio;
+            if (!pareceTrama(trama, completa)) break;
+            posicion += consumidos;
+            validas++;
+        }
+        if (validas == TRAMAS_CONFIRMACION || posicion == tamanio) {
+            return candidato;
+        }
+    }
+    return objetivo;
+}
+
+/**
+ * @brief Normaliza una rotación al rango [0, tamanio) igual que RotorDeMapeo::rotar()
+ */
+inline int normalizarRotacion(int n, int tamanio) {
+    n = n % tamanio;
+    return n < 0 ? n + tamanio : n;
+}
+
+/**
+ * @brief Segundos transcurridos entre dos instantes
+ */
+inline double segundosEntre(std::chrono::steady_clock::time_point a,
+                            std::chrono::steady_clock::time_point b) {
+    return std::chrono::duration<double>(b - a).count();
+}
+
+} // namespace
+
+DecodificadorParalelo::DecodificadorParalelo(int hilos, TipoAlfabeto tipoAlfabeto,
+                                             const char* especificacionCascada)
+    : numHilos(hilos),
+      alfabeto(tipoAlfabeto),
+      tamanioAlfabeto(tamanioDeAlfabeto(tipoAlfabeto)),
+      cascada(especificacionCascada),
+      secuencial(false),
+      datos(nullptr),
+      salida(nullptr),
+      tramos(nullptr),
+      numTramos(0),
+      siguienteTramo(0),
+      totalTramas(0),
+      totalInvalidas(0),
+      totalCaracteres(0),
+      bytesEntrada(0),
+      bytesRecorridosEnSerie(0),
+      segundosAnalisis(0.0),
+      segundosDecodificacion(0.0) {
+    if (numHilos <= 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+        if (numHilos <= 0) numHilos = 1;
+    }
+    
+    if (cascada) {
+        RotorDeMapeo prueba(alfabeto);
+        secuencial = prueba.configurarCascada(cascada) && prueba.esCascada();
+    }
+}
+
+DecodificadorParalelo::~DecodificadorParalelo() {
+    delete[] tramos;
+}
+
+void DecodificadorParalelo::dividir(size_t tamanio) {
+    size_t maximoPorTamanio = tamanio / TAM_MINIMO_TRAMO;
+    numTramos = secuencial ? 1 : numHilos * TRAMOS_POR_HILO;
+    if (static_cast<size_t>(numTramos) > maximoPorTamanio) {
+        numTramos = maximoPorTamanio > 0 ? static_cast<int>(maximoPorTamanio) : 1;
+    }
+    
+    delete[] tramos;
+    tramos = new TramoDeCaptura[numTramos];
+    bytesRecorridosEnSerie = 0;
+    
+    // Dentro de una trama binaria puede haber bytes '\n': si las hay, cada
+    // corte es una suposición que la fase 0 comprueba (ver resincronizar())
+    bool binaria = numTramos > 1 && contieneBytesAltos(datos, tamanio);
+    
+    size_t inicio = 0;
+    for (int i = 0; i < numTramos; ++i) {
+        size_t fin = tamanio;
+        
+        if (i < numTramos - 1) {
+            size_t objetivo = tamanio / numTramos * (i + 1);
+            if (objetivo < inicio) objetivo = inicio;
+            
+            if (binaria) {
+                fin = buscarInicioProbable(datos, tamanio, objetivo);
+            } else {
+                // Cortar después del primer '\n' a partir del punto proporcional
+                const void* salto = memchr(datos + objetivo, '\n', tamanio - objetivo);
+                fin = salto ? static_cast<size_t>(static_cast<const char*>(salto) - datos) + 1 : tamanio;
+            }
+        }
+        
+        TramoDeCaptura& tramo = tramos[i];
+        tramo.inicio = inicio;
+        tramo.fin = fin;
+        tramo.finRecorrido = fin;
+        tramo.rotacion = 0;
+        tramo.caracteres = 0;
+        tramo.tramas = 0;
+        tramo.invalidas = 0;
+        tramo.desplazamientoInicial = 0;
+        tramo.posicionSalida = 0;
+        
+        inicio = fin;
+    }
+    
+    if (binaria) {
+        ejecutarFase(0);
+        resincronizar();
+    }
+}
+
+void DecodificadorParalelo::recorrerTramo(TramoDeCaptura* tramo) {
+    VistaLinea trama;
+    size_t posicion = tramo->inicio;
+    while (posicion < tramo->fin) {
+        posicion += delimitarTrama(datos + posicion, bytesEntrada - posicion, &trama);
+    }
+    tramo->finRecorrido = posicion;
+}
+
+void DecodificadorParalelo::resincronizar() {
+    VistaLinea trama;
+    size_t inicioReal = 0;  // El primer tramo empieza en el primer byte
+    
+    for (int i = 0; i < numTramos; ++i) {
+        TramoDeCaptura& tramo = tramos[i];
+        size_t finReal;
+        
+        if (inicioReal == tramo.inicio) {
+            finReal = tramo.finRecorrido;
+        } else if (inicioReal >= tramo.fin && i < numTramos - 1) {
+            finReal = inicioReal;  // Una trama del tramo anterior lo cubre entero
+        } else {
+            // Avanzar a la vez desde el inicio real y desde el supuesto: si
+            // se encuentran en una trama, desde ahí el recorrido supuesto es
+            // el real y su fin vale
+            size_t real = inicioReal;
+            size_t supuesto = tramo.inicio;
+            while (real < tramo.fin && supuesto != real) {
+                if (supuesto < real) {
+                    supuesto += delimitarTrama(datos + supuesto, bytesEntrada - supuesto, &trama);
+                } else {
+                    real += delimitarTrama(datos + real, bytesEntrada - real, &trama);
+                }
+            }
+            finReal = supuesto == real ? tramo.finRecorrido : real;
+            bytesRecorridosEnSerie += real - inicioReal;
+        }
+        
+        tramo.inicio = inicioReal;
+        tramo.fin = finReal;
+        inicioReal = finReal;
+    }
+}
+
+void DecodificadorParalelo::analizarTramo(TramoDeCaptura* tramo) {
+    AnalizadorPorLotes analizador;
+    const TramaCompacta* tramas = analizador.obtenerTramas();
+    size_t posicion = tramo->inicio;
+    
+    while (posicion < tramo->fin) {
+        size_t consumidos;
+        int n = analizador.analizar(datos + posicion, tramo->fin - posicion, &consumidos);
+        posicion += consumidos;
+        
+        for (int i = 0; i < n; ++i) {
+            const TramaCompacta& trama = tramas[i];
+            switch (trama.tipo) {
+                case COMPACTA_LOAD:
+                    tramo->caracteres++;
+                    break;
+                case COMPACTA_BULK:
+                    tramo->caracteres += trama.valor;
+                    break;
+                case COMPACTA_MAP:
+                    tramo->rotacion = (tramo->rotacion + normalizarRotacion(trama.valor, tamanioAlfabeto))
+                                      % tamanioAlfabeto;
+                    break;
+                case COMPACTA_ROTOR:
+                    // Sin cascada solo existe el rotor 0 (TramaRotor::obtenerRotacion())
+                    if (trama.rotor == 0) {
+                        tramo->rotacion = (tramo->rotacion + normalizarRotacion(trama.valor, tamanioAlfabeto))
+                                          % tamanioAlfabeto;
+                    }
+                    break;
+                case COMPACTA_INVALIDA:
+                    tramo->invalidas++;
+                    tramo->tramas--;
+                    break;
+                default:
+                    break;
+            }
+        }
+        tramo->tramas += n;
+    }
+    
+    // Las líneas rechazadas se cuentan aquí y no en la fase de decodificación
+    analizador.publicarInvalidas();
+}
+
+void DecodificadorParalelo::decodificarTramo(const TramoDeCaptura* tramo) {
+    AnalizadorPorLotes analizador;
+    const TramaCompacta* tramas = analizador.obtenerTramas();
+    RotorDeMapeo rotor(alfabeto);
+    if (cascada) {
+        rotor.configurarCascada(cascada);
+    }
+    rotor.rotar(tramo->desplazamientoInicial);
+    
+    char* destino = salida + tramo->posicionSalida;
+    size_t posicion = tramo->inicio;
+    
+    while (posicion < tramo->fin) {
+        const char* lote = datos + posicion;
+        size_t consumidos;
+        int n = analizador.analizar(lote, tramo->fin - posicion, &consumidos);
+        posicion += consumidos;
+        
+        for (int i = 0; i < n; ++i) {
+            const TramaCompacta& trama = tramas[i];
+            switch (trama.tipo) {
+                case COMPACTA_LOAD:
+                    *destino++ = rotor.getMapeo(static_cast<char>(trama.valor));
+                    break;
+                case COMPACTA_BULK:
+                    rotor.mapearBloque(lote + trama.posicion, destino, static_cast<size_t>(trama.valor));
+                    destino += trama.valor;
+                    break;
+                case COMPACTA_MAP:
+                    rotor.rotar(trama.valor);
+                    break;
+                case COMPACTA_SELECCION:
+                    if (secuencial) {
+                        rotor.seleccionarRotor(trama.valor);
+                    }
+                    break;
+                case COMPACTA_ROTOR:
+                    if (secuencial) {
+                        rotor.rotarRotor(trama.rotor, trama.valor);
+                    } else if (trama.rotor == 0) {
+                        rotor.rotar(trama.valor);
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+}
+
+void DecodificadorParalelo::trabajador(int fase) {
+    while (true) {
+        int i = siguienteTramo.fetch_add(1, std::memory_order_relaxed);
+        if (i >= numTramos) break;
+        
+        if (fase == 0) {
+            recorrerTramo(&tramos[i]);
+        } else if (fase == 1) {
+            analizarTramo(&tramos[i]);
+        } else {
+            decodificarTramo(&tramos[i]);
+        }
+    }
+}
+
+void DecodificadorParalelo::ejecutarFase(int fase) {
+    siguienteTramo.store(0, std::memory_order_relaxed);
+    
+    int hilos = numHilos < numTramos ? numHilos : numTramos;
+    std::thread* trabajadores = new std::thread[hilos];
+    for (int i = 0; i < hilos; ++i) {
+        trabajadores[i] = std::thread(&DecodificadorParalelo::trabajador, this, fase);
+    }
+    for (int i = 0; i < hilos; ++i) {
+        trabajadores[i].join();
+    }
+    delete[] trabajadores;
+}
+
+bool DecodificadorParalelo::decodificar(const ArchivoMapeado& entrada, const char* rutaDestino) {
+    datos = entrada.obtenerDatos();
+    bytesEntrada = entrada.obtenerTamanio();
+    
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    
+    // Fase 0 (si hay tramas binarias) y fase 1: suma de rotaciones y caracteres por tramo
+    dividir(bytesEntrada);
+    ejecutarFase(1);
+    
+    // Fase 2: escaneo exclusivo
+    int desplazamiento = 0;
+    long long posicion = 0;
+    totalTramas = 0;
+    totalInvalidas = 0;
+    for (int i = 0; i < numTramos; ++i) {
+        tramos[i].desplazamientoInicial = desplazamiento;
+        tramos[i].posicionSalida = posicion;
+        desplazamiento = (desplazamiento + tramos[i].rotacion) % tamanioAlfabeto;
+        posicion += tramos[i].caracteres;
+        totalTramas += tramos[i].tramas;
+        totalInvalidas += tramos[i].invalidas;
+    }
+    totalCaracteres = posicion;
+    
+    std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+    segundosAnalisis = segundosEntre(t0, t1);
+    
+    // Preparar la salida: proyección del archivo destino o buffer en memoria
+    size_t total = static_cast<size_t>(totalCaracteres);
+    FILE* archivo = rutaDestino ? nullptr : stdout;
+    bool proyectada = false;
+    
+#ifndef _WIN32
+    int descriptor = -1;
+    if (rutaDestino) {
+        descriptor = open(rutaDestino, O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (descriptor < 0 || ftruncate(descriptor, static_cast<off_t>(total)) != 0) {
+            fprintf(stderr, "Error: No se pudo preparar %s: %s\n", rutaDestino, strerror(errno));
+            if (descriptor >= 0) close(descriptor);
+            return false;
+        }
+        
+        if (total > 0) {
+            void* proyeccion = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+            if (proyeccion == MAP_FAILED) {
+                fprintf(stderr, "Error: No se pudo proyectar %s: %s\n", rutaDestino, strerror(errno));
+                close(descriptor);
+                return false;
+            }
+            salida = static_cast<char*>(proyeccion);
+            proyectada = true;
+        }
+    }
+#else
+    if (rutaDestino) {
+        archivo = fopen(rutaDestino, "wb");
+        if (!archivo) {
+            fprintf(stderr, "Error: No se pudo crear %s: %s\n", rutaDestino, strerror(errno));
+            return false;
+        }
+    }
+#endif
+    
+    if (!proyectada) {
+        salida = new char[total > 0 ? total : 1];
+    }
+    
+    // Fase 3: cada tramo decodifica en su posición
+    ejecutarFase(3);
+    segundosDecodificacion = segundosEntre(t1, std::chrono::steady_clock::now());
+    
+    bool completo = true;
+    if (proyectada) {
+#ifndef _WIN32
+        munmap(salida, total);
+#endif
+    } else {
+        if (archivo) {
+            completo = fwrite(salida, 1, total, archivo) == total;
+            if (archivo == stdout) {
+                fflush(stdout);
+            } else {
+                fclose(archivo);
+            }
+        }
+        delete[] salida;
+    }
+    salida = nullptr;
+    
+#ifndef _WIN32
+    if (descriptor >= 0) close(descriptor);
+#endif
+    
+    if (!completo) {
+        fprintf(stderr, "Error: No se pudo escribir el mensaje completo\n");
+    }
+    return completo;
+}
+
+void DecodificadorParalelo::imprimirResumen(FILE* destino) const {
+    double segundos = segundosAnalisis + segundosDecodificacion;
+    
+    fprintf(destino, "Decodificación paralela (%d hilo(s), %d tramo(s)):\n", numHilos, numTramos);
+    fprintf(destino, "  - Bytes de captura: %llu\n", static_cast<unsigned long long>(bytesEntrada));
+    fprintf(destino, "  - Tramas procesadas: %lld\n", totalTramas);
+    fprintf(destino, "  - Tramas inválidas: %lld\n", totalInvalidas);
+    fprintf(destino, "  - Caracteres decodificados: %lld\n", totalCaracteres);
+    if (bytesRecorridosEnSerie > 0) {
+        fprintf(destino, "  - Bytes recorridos en serie para ajustar cortes: %llu\n",
+                static_cast<unsigned long long>(bytesRecorridosEnSerie));
+    }
+    fprintf(destino, "  - Análisis y escaneo: %.3f s\n", segundosAnalisis);
+    fprintf(destino, "  - Decodificación: %.3f s\n", segundosDecodificacion);
+    if (segundos > 0.0) {
+        fprintf(destino, "  - Rendimiento: %.2f GB/s\n", bytesEntrada / segundos / 1e9);
+    }
+}
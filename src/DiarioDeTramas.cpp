@@ -0,0 +1,295 @@
+/**
+ * @file DiarioDeTramas.cpp
+ * @brief Implementación del diario de tramas
+ */
+
+#include "DiarioDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "HistogramaLatencia.h"  // Para relojNs()
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define open _open
+    #define close _close
+    #define read _read
+    #define write _write
+    #define lseek _lseeki64
+#else
+    #include <unistd.h>
+    #define O_BINARY 0
+#endif
+
+/// Bytes de la cabecera del archivo
+const int BYTES_CABECERA_DIARIO = 24;
+
+/// Bytes de la cabecera de cada bloque
+const int BYTES_CABECERA_BLOQUE = 12;
+
+/// Versión del formato
+const unsigned int VERSION_DIARIO = 1;
+
+static const char MAGIA_DIARIO[8] = {'P', 'R', 'T', '7', 'D', 'I', 'A', 'R'};
+
+unsigned int sumaFnv(const void* datos, size_t n, unsigned int suma) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(datos);
+    for (size_t i = 0; i < n; ++i) {
+        suma ^= bytes[i];
+        suma *= 16777619u;
+    }
+    return suma;
+}
+
+bool sincronizarDescriptor(int descriptor) {
+#ifdef _WIN32
+    return _commit(descriptor) == 0;
+#elif defined(__APPLE__)
+    return fsync(descriptor) == 0;
+#else
+    return fdatasync(descriptor) == 0;
+#endif
+}
+
+bool escribirCompleto(int descriptor, const void* datos, size_t n) {
+    const char* p = static_cast<const char*>(datos);
+    while (n > 0) {
+        long escritos = static_cast<long>(write(descriptor, p, static_cast<unsigned int>(n)));
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += escritos;
+        n -= static_cast<size_t>(escritos);
+    }
+    return true;
+}
+
+bool truncarDescriptor(int descriptor, long long longitud) {
+#ifdef _WIN32
+    return _chsize_s(descriptor, longitud) == 0;
+#else
+    return ftruncate(descriptor, static_cast<off_t>(longitud)) == 0;
+#endif
+}
+
+DiarioDeTramas::DiarioDeTramas(PoliticaSincronizacion politicaSincronizacion, int tramasLote,
+                               int intervaloSincronizacionMs)
+    : descriptor(-1),
+      politica(politicaSincronizacion),
+      tramasPorLote(politicaSincronizacion == SINCRONIZAR_TRAMA || tramasLote < 1 ? 1 : tramasLote),
+      intervaloMs(intervaloSincronizacionMs),
+      bloque(new unsigned char[CAPACIDAD_BLOQUE_DIARIO]),
+      bytesBloque(BYTES_CABECERA_BLOQUE),
+      tramasBloque(0),
+      ultimaSincronizacionNs(0),
+      sucio(false),
+      error(false) {
+}
+
+DiarioDeTramas::~DiarioDeTramas() {
+    if (descriptor >= 0) {
+        sincronizar();
+        close(descriptor);
+    }
+    delete[] bloque;
+}
+
+bool DiarioDeTramas::escribirCabecera(unsigned long long generacion) {
+    unsigned char cabecera[BYTES_CABECERA_DIARIO];
+    unsigned int version = VERSION_DIARIO;
+    unsigned int reservado = 0;
+
+    memcpy(cabecera, MAGIA_DIARIO, 8);
+    memcpy(cabecera + 8, &version, 4);
+    memcpy(cabecera + 12, &reservado, 4);
+    memcpy(cabecera + 16, &generacion, 8);
+    return escribirCompleto(descriptor, cabecera, sizeof(cabecera));
+}
+
+bool DiarioDeTramas::abrir(const char* ruta, unsigned long long generacion) {
+    if (descriptor >= 0) {
+        close(descriptor);
+    }
+
+    descriptor = open(ruta, O_RDWR | O_CREAT | O_APPEND | O_BINARY, 0644);
+    if (descriptor < 0) {
+        fprintf(stderr, "Error: No se pudo abrir el diario %s: %s\n", ruta, strerror(errno));
+        return false;
+    }
+
+    error = false;
+    return reiniciar(generacion);
+}
+
+bool DiarioDeTramas::reiniciar(unsigned long long generacion) {
+    if (descriptor < 0) return false;
+
+    // Lo anotado hasta aquí ya está en el punto de control
+    bytesBloque = BYTES_CABECERA_BLOQUE;
+    tramasBloque = 0;
+
+    // Con O_APPEND las escrituras van al final aunque el archivo se recorte
+    if (!truncarDescriptor(descriptor, 0) || !escribirCabecera(generacion)) {
+        fprintf(stderr, "Error: No se pudo reiniciar el diario: %s\n", strerror(errno));
+        error = true;
+        return false;
+    }
+
+    sucio = true;
+    sincronizar();
+    return true;
+}
+
+void DiarioDeTramas::anotarFueraDeBloque(const char* trama, int longitud) {
+    escribirBloque();
+
+    if (bytesBloque + MAX_BYTES_VARINT + longitud <= CAPACIDAD_BLOQUE_DIARIO) {
+        anotar(trama, longitud);
+        return;
+    }
+
+    // Trama mayor que un bloque: bloque propio de una sola trama
+    int capacidad = BYTES_CABECERA_BLOQUE + MAX_BYTES_VARINT + longitud;
+    unsigned char* grande = new unsigned char[capacidad];
+    unsigned char* normal = bloque;
+
+    bloque = grande;
+    bytesBloque = BYTES_CABECERA_BLOQUE;
+    bytesBloque += escribirVarint(static_cast<unsigned int>(longitud), bloque + bytesBloque);
+    memcpy(bloque + bytesBloque, trama, longitud);
+    bytesBloque += longitud;
+    tramasBloque = 1;
+    escribirBloque();
+
+    bloque = normal;
+    delete[] grande;
+}
+
+void DiarioDeTramas::escribirBloque() {
+    if (tramasBloque > 0 && descriptor >= 0 && !error) {
+        unsigned int bytes = static_cast<unsigned int>(bytesBloque - BYTES_CABECERA_BLOQUE);
+        unsigned int tramas = static_cast<unsigned int>(tramasBloque);
+        unsigned int suma = sumaFnv(bloque + BYTES_CABECERA_BLOQUE, bytes);
+
+        memcpy(bloque, &bytes, 4);
+        memcpy(bloque + 4, &tramas, 4);
+        memcpy(bloque + 8, &suma, 4);
+
+        // Una sola escritura por bloque: o llega completo o la suma lo delata
+        if (escribirCompleto(descriptor, bloque, bytesBloque)) {
+            sucio = true;
+        } else {
+            fprintf(stderr, "Error: No se pudo escribir en el diario: %s\n", strerror(errno));
+            error = true;
+        }
+    }
+    bytesBloque = BYTES_CABECERA_BLOQUE;
+    tramasBloque = 0;
+
+    if (!sucio || politica == SINCRONIZAR_NUNCA) return;
+
+    long long ahora = relojNs();
+    if (politica == SINCRONIZAR_TRAMA ||
+        ahora - ultimaSincronizacionNs >= static_cast<long long>(intervaloMs) * 1000000LL) {
+        sincronizarDescriptor(descriptor);
+        ultimaSincronizacionNs = ahora;
+        sucio = false;
+    }
+}
+
+void DiarioDeTramas::sincronizar() {
+    escribirBloque();
+
+    if (sucio && descriptor >= 0 && politica != SINCRONIZAR_NUNCA) {
+        sincronizarDescriptor(descriptor);
+        ultimaSincronizacionNs = relojNs();
+    }
+    sucio = false;
+}
+
+long long DiarioDeTramas::reproducir(const char* ruta, unsigned long long generacion,
+                                     ProcesadorDeTramas* procesador, long long* descartados) {
+    if (descartados) *descartados = 0;
+
+    int entrada = open(ruta, O_RDONLY | O_BINARY);
+    if (entrada < 0) {
+        return 0;  // Sin diario: nada que reaplicar
+    }
+
+    // El diario solo contiene lo posterior al último punto de control: cabe en memoria
+    long long tamanio = static_cast<long long>(lseek(entrada, 0, SEEK_END));
+    lseek(entrada, 0, SEEK_SET);
+    if (tamanio < BYTES_CABECERA_DIARIO) {
+        close(entrada);
+        if (descartados) *descartados = tamanio > 0 ? tamanio : 0;
+        return 0;
+    }
+
+    unsigned char* datos = new unsigned char[tamanio];
+    long long leidos = 0;
+    while (leidos < tamanio) {
+        long n = static_cast<long>(read(entrada, datos + leidos, static_cast<unsigned int>(tamanio - leidos)));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        leidos += n;
+    }
+    close(entrada);
+
+    unsigned int version = 0;
+    unsigned long long generacionDiario = 0;
+    memcpy(&version, datos + 8, 4);
+    memcpy(&generacionDiario, datos + 16, 8);
+
+    if (leidos < BYTES_CABECERA_DIARIO || memcmp(datos, MAGIA_DIARIO, 8) != 0 || version != VERSION_DIARIO ||
+        generacionDiario != generacion) {
+        // De otra generación: ya incluido en el punto de control
+        delete[] datos;
+        return 0;
+    }
+
+    long long tramasReaplicadas = 0;
+    long long pos = BYTES_CABECERA_DIARIO;
+
+    while (pos + BYTES_CABECERA_BLOQUE <= leidos) {
+        unsigned int bytes, tramas, suma;
+        memcpy(&bytes, datos + pos, 4);
+        memcpy(&tramas, datos + pos + 4, 4);
+        memcpy(&suma, datos + pos + 8, 4);
+
+        const unsigned char* registros = datos + pos + BYTES_CABECERA_BLOQUE;
+        if (tramas == 0 || pos + BYTES_CABECERA_BLOQUE + bytes > leidos ||
+            sumaFnv(registros, bytes) != suma) {
+            break;  // Bloque incompleto o dañado: fin de lo recuperable
+        }
+
+        // Comprobar la estructura antes de aplicar: el bloque se aplica entero o nada
+        const unsigned char* fin = registros + bytes;
+        const unsigned char* p = registros;
+        unsigned int contadas = 0;
+        while (p < fin) {
+            unsigned int longitud;
+            int n = leerVarint(p, static_cast<size_t>(fin - p), &longitud);
+            if (n <= 0 || longitud == 0 || longitud > static_cast<unsigned int>(fin - p - n)) break;
+            p += n + longitud;
+            contadas++;
+        }
+        if (p != fin || contadas != tramas) break;
+
+        for (p = registros; p < fin; ) {
+            unsigned int longitud;
+            p += leerVarint(p, static_cast<size_t>(fin - p), &longitud);
+            procesador->procesarLinea(reinterpret_cast<const char*>(p), static_cast<int>(longitud));
+            p += longitud;
+        }
+
+        tramasReaplicadas += tramas;
+        pos += BYTES_CABECERA_BLOQUE + bytes;
+    }
+    procesador->vaciarPendientes();
+
+    if (descartados) *descartados = tamanio - pos;
+    delete[] datos;
+    return tramasReaplicadas;
+}
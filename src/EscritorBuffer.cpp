@@ -0,0 +1,58 @@
+/**
+ * @file EscritorBuffer.cpp
+ * @brief Implementación del escritor con buffer
+ */
+
+#include "EscritorBuffer.h"
+#include <cstdarg>
+#include <cstring>
+
+EscritorBuffer::EscritorBuffer(FILE* flujo, int tamBuffer)
+    : destino(flujo),
+      buffer(new char[tamBuffer]),
+      capacidad(tamBuffer),
+      usados(0) {
+}
+
+EscritorBuffer::~EscritorBuffer() {
+    vaciar();
+    delete[] buffer;
+}
+
+void EscritorBuffer::escribir(const char* datos, int n) {
+    if (usados + n > capacidad) {
+        vaciar();
+        
+        // Bloques más grandes que el buffer se escriben directamente
+        if (n > capacidad) {
+            fwrite(datos, 1, n, destino);
+            return;
+        }
+    }
+    
+    memcpy(buffer + usados, datos, n);
+    usados += n;
+}
+
+void EscritorBuffer::escribirFormato(const char* formato, ...) {
+    char texto[256];
+    
+    va_list argumentos;
+    va_start(argumentos, formato);
+    int n = vsnprintf(texto, sizeof(texto), formato, argumentos);
+    va_end(argumentos);
+    
+    if (n < 0) return;
+    if (n >= static_cast<int>(sizeof(texto))) {
+        n = sizeof(texto) - 1;
+    }
+    escribir(texto, n);
+}
+
+void EscritorBuffer::vaciar() {
+    if (usados > 0) {
+        fwrite(buffer, 1, usados, destino);
+        usados = 0;
+    }
+    fflush(destino);
+}
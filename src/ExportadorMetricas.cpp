@@ -0,0 +1,168 @@
+/**
+ * @file ExportadorMetricas.cpp
+ * @brief Implementación del exportador de métricas
+ */
+
+#include "ExportadorMetricas.h"
+#include "Metricas.h"
+#include "HistogramaLatencia.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+
+namespace {
+
+/// Granularidad de la espera entre escrituras (para detenerse rápido)
+const int PASO_ESPERA_MS = 50;
+
+/**
+ * @brief Escribe la cabecera HELP/TYPE de una familia de métricas
+ */
+void escribirCabecera(FILE* archivo, const char* nombre, const char* tipo, const char* ayuda) {
+    fprintf(archivo, "# HELP %s %s\n", nombre, ayuda);
+    fprintf(archivo, "# TYPE %s %s\n", nombre, tipo);
+}
+
+/**
+ * @brief Copia una cadena en memoria nueva (con sufijo opcional)
+ */
+char* duplicar(const char* texto, const char* sufijo) {
+    size_t largo = strlen(texto);
+    size_t largoSufijo = strlen(sufijo);
+    char* copia = new char[largo + largoSufijo + 1];
+    memcpy(copia, texto, largo);
+    memcpy(copia + largo, sufijo, largoSufijo + 1);
+    return copia;
+}
+
+} // namespace
+
+ExportadorMetricas::ExportadorMetricas(const char* rutaArchivo, int intervalo)
+    : ruta(duplicar(rutaArchivo, "")),
+      rutaTemporal(duplicar(rutaArchivo, ".tmp")),
+      intervaloMs(intervalo),
+      detenerHilo(false),
+      enMarcha(false),
+      tramasPrevias(0),
+      bytesPrevios(0),
+      instantePrevioNs(relojNs()) {
+}
+
+ExportadorMetricas::~ExportadorMetricas() {
+    detener();
+    delete[] ruta;
+    delete[] rutaTemporal;
+}
+
+bool ExportadorMetricas::iniciar() {
+    if (!escribir()) {
+        fprintf(stderr, "Error: No se pudo escribir el archivo de métricas %s\n", ruta);
+        return false;
+    }
+
+    detenerHilo.store(false);
+    hilo = std::thread(&ExportadorMetricas::ejecutar, this);
+    enMarcha = true;
+    return true;
+}
+
+void ExportadorMetricas::detener() {
+    if (!enMarcha) return;
+
+    detenerHilo.store(true);
+    hilo.join();
+    enMarcha = false;
+    escribir();
+}
+
+void ExportadorMetricas::ejecutar() {
+    while (!detenerHilo.load()) {
+        for (int esperado = 0; esperado < intervaloMs && !detenerHilo.load(); esperado += PASO_ESPERA_MS) {
+            int paso = intervaloMs - esperado < PASO_ESPERA_MS ? intervaloMs - esperado : PASO_ESPERA_MS;
+            std::this_thread::sleep_for(std::chrono::milliseconds(paso));
+        }
+        if (!detenerHilo.load()) {
+            escribir();
+        }
+    }
+}
+
+bool ExportadorMetricas::escribir() {
+    FILE* archivo = fopen(rutaTemporal, "w");
+    if (!archivo) {
+        return false;
+    }
+
+    unsigned long long load = Metricas::totalDe(CONTADOR_TRAMAS_LOAD);
+    unsigned long long map = Metricas::totalDe(CONTADOR_TRAMAS_MAP);
+    unsigned long long bulk = Metricas::totalDe(CONTADOR_TRAMAS_BULK);
+    unsigned long long otras = Metricas::totalDe(CONTADOR_TRAMAS_OTRAS);
+    unsigned long long bytes = Metricas::totalDe(CONTADOR_BYTES_LEIDOS);
+    unsigned long long tramas = load + map + bulk + otras;
+
+    // Tasas sobre el intervalo desde la escritura anterior
+    long long ahora = relojNs();
+    double segundos = (ahora - instantePrevioNs) / 1e9;
+    double tramasPorSegundo = segundos > 0.0 ? (tramas - tramasPrevias) / segundos : 0.0;
+    double bytesPorSegundo = segundos > 0.0 ? (bytes - bytesPrevios) / segundos : 0.0;
+    tramasPrevias = tramas;
+    bytesPrevios = bytes;
+    instantePrevioNs = ahora;
+
+    escribirCabecera(archivo, "prt7_tramas_total", "counter", "Tramas validas procesadas por tipo");
+    fprintf(archivo, "prt7_tramas_total{tipo=\"load\"} %llu\n", load);
+    fprintf(archivo, "prt7_tramas_total{tipo=\"map\"} %llu\n", map);
+    fprintf(archivo, "prt7_tramas_total{tipo=\"bulk\"} %llu\n", bulk);
+    fprintf(archivo, "prt7_tramas_total{tipo=\"otra\"} %llu\n", otras);
+
+    escribirCabecera(archivo, "prt7_tramas_invalidas_total", "counter", "Lineas rechazadas por el parser por motivo");
+    fprintf(archivo, "prt7_tramas_invalidas_total{motivo=\"corta\"} %llu\n",
+            Metricas::totalDe(CONTADOR_INVALIDA_CORTA));
+    fprintf(archivo, "prt7_tramas_invalidas_total{motivo=\"sin_coma\"} %llu\n",
+            Metricas::totalDe(CONTADOR_INVALIDA_SIN_COMA));
+    fprintf(archivo, "prt7_tramas_invalidas_total{motivo=\"tipo_desconocido\"} %llu\n",
+            Metricas::totalDe(CONTADOR_INVALIDA_TIPO));
+    fprintf(archivo, "prt7_tramas_invalidas_total{motivo=\"dato_invalido\"} %llu\n",
+            Metricas::totalDe(CONTADOR_INVALIDA_DATO));
+
+    escribirCabecera(archivo, "prt7_bytes_leidos_total", "counter", "Bytes recibidos del puerto o de la captura");
+    fprintf(archivo, "prt7_bytes_leidos_total %llu\n", bytes);
+
+    escribirCabecera(archivo, "prt7_lecturas_total", "counter", "Llamadas de lectura al puerto serial");
+    fprintf(archivo, "prt7_lecturas_total %llu\n", Metricas::totalDe(CONTADOR_LLAMADAS_LECTURA));
+
+    escribirCabecera(archivo, "prt7_lecturas_vacias_total", "counter", "Lecturas del puerto terminadas sin datos");
+    fprintf(archivo, "prt7_lecturas_vacias_total %llu\n", Metricas::totalDe(CONTADOR_LECTURAS_VACIAS));
+
+    escribirCabecera(archivo, "prt7_lineas_descartadas_total", "counter", "Lineas perdidas por cola llena en el pipeline");
+    fprintf(archivo, "prt7_lineas_descartadas_total %llu\n", Metricas::totalDe(CONTADOR_LINEAS_DESCARTADAS));
+    escribirCabecera(archivo, "prt7_bitacora_descartados_total", "counter", "Registros de la bitacora perdidos por cola llena");
+    fprintf(archivo, "prt7_bitacora_descartados_total %llu\n",
+            Metricas::totalDe(CONTADOR_REGISTROS_BITACORA_DESCARTADOS));
+
+    escribirCabecera(archivo, "prt7_tramas_por_segundo", "gauge", "Tramas validas por segundo en el ultimo intervalo");
+    fprintf(archivo, "prt7_tramas_por_segundo %.1f\n", tramasPorSegundo);
+
+    escribirCabecera(archivo, "prt7_bytes_por_segundo", "gauge", "Bytes leidos por segundo en el ultimo intervalo");
+    fprintf(archivo, "prt7_bytes_por_segundo %.1f\n", bytesPorSegundo);
+
+    escribirCabecera(archivo, "prt7_desplazamiento_rotor", "gauge", "Desplazamiento actual del rotor (0 a 25)");
+    fprintf(archivo, "prt7_desplazamiento_rotor %lld\n", Metricas::valorDe(INDICADOR_DESPLAZAMIENTO_ROTOR));
+
+    escribirCabecera(archivo, "prt7_profundidad_cola", "gauge", "Elementos en las colas del pipeline");
+    fprintf(archivo, "prt7_profundidad_cola{cola=\"lineas\"} %lld\n", Metricas::valorDe(INDICADOR_COLA_LINEAS));
+    fprintf(archivo, "prt7_profundidad_cola{cola=\"salida\"} %lld\n", Metricas::valorDe(INDICADOR_COLA_SALIDA));
+
+    escribirCabecera(archivo, "prt7_ultima_actualizacion_segundos", "gauge", "Hora Unix de esta escritura");
+    fprintf(archivo, "prt7_ultima_actualizacion_segundos %lld\n", static_cast<long long>(time(nullptr)));
+
+    bool correcto = !ferror(archivo);
+    if (fclose(archivo) != 0) correcto = false;
+
+    // El renombrado es atómico: el recolector ve el archivo anterior o el nuevo
+#ifdef _WIN32
+    remove(ruta);  // rename() no reemplaza un archivo existente en Windows
+#endif
+    return correcto && rename(rutaTemporal, ruta) == 0;
+}
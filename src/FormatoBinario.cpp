@@ -0,0 +1,230 @@
+/**
+ * @file FormatoBinario.cpp
+ * @brief Implementación de la codificación binaria de tramas
+ */
+
+#include "FormatoBinario.h"
+#include "RegistroDeTramas.h"
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief Verifica que una carga pueda escribirse como línea de texto
+ * @return false si contiene '\r' o '\n'
+ */
+bool esRepresentableEnTexto(const char* datos, int longitud) {
+    return !memchr(datos, '\n', longitud) && !memchr(datos, '\r', longitud);
+}
+
+} // namespace
+
+int escribirVarint(unsigned int valor, unsigned char* destino) {
+    int n = 0;
+    while (valor >= 0x80) {
+        destino[n++] = static_cast<unsigned char>(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = static_cast<unsigned char>(valor);
+    return n;
+}
+
+int leerVarint(const unsigned char* datos, size_t disponibles, unsigned int* valor) {
+    unsigned int resultado = 0;
+    
+    for (int i = 0; i < MAX_BYTES_VARINT; ++i) {
+        if (static_cast<size_t>(i) >= disponibles) {
+            return 0;
+        }
+        resultado |= static_cast<unsigned int>(datos[i] & 0x7F) << (7 * i);
+        if ((datos[i] & 0x80) == 0) {
+            *valor = resultado;
+            return i + 1;
+        }
+    }
+    
+    return -1;
+}
+
+size_t longitudTramaBinaria(const char* datos, size_t disponibles) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(datos);
+    unsigned int valor;
+    int usados;
+    
+    switch (bytes[0]) {
+        case ETIQUETA_LOAD:
+            return disponibles >= 2 ? 2 : 0;
+        
+        case ETIQUETA_FIN:
+            return 1;
+        
+        case ETIQUETA_MAP:
+        case ETIQUETA_SELECCION:
+            usados = leerVarint(bytes + 1, disponibles - 1, &valor);
+            if (usados == 0) return 0;
+            return usados < 0 ? 1 + MAX_BYTES_VARINT : 1 + usados;
+        
+        case ETIQUETA_ROTOR: {
+            usados = leerVarint(bytes + 1, disponibles - 1, &valor);
+            if (usados == 0) return 0;
+            if (usados < 0) return 1 + MAX_BYTES_VARINT;
+            
+            int segundo = leerVarint(bytes + 1 + usados, disponibles - 1 - usados, &valor);
+            if (segundo == 0) return 0;
+            return segundo < 0 ? 1 + usados + MAX_BYTES_VARINT : 1 + usados + segundo;
+        }
+        
+        case ETIQUETA_BULK:
+            usados = leerVarint(bytes + 1, disponibles - 1, &valor);
+            if (usados == 0) return 0;
+            if (usados < 0) return 1 + MAX_BYTES_VARINT;
+            
+            // Una longitud fuera de rango invalida solo la cabecera
+            if (valor == 0 || valor > static_cast<unsigned int>(MAX_CARGA_BULK_BINARIA)) {
+                return 1 + usados;
+            }
+            return disponibles >= 1 + usados + valor ? 1 + usados + valor : 0;
+        
+        default:
+            // Etiqueta desconocida: trama de un byte
+            return 1;
+    }
+}
+
+size_t delimitarTrama(const char* datos, size_t disponibles, VistaLinea* trama) {
+    trama->datos = datos;
+    trama->llegadaNs = 0;  // Datos ya grabados: sin instante de llegada
+    
+    if (esTramaBinaria(static_cast<unsigned char>(datos[0]))) {
+        size_t longitud = longitudTramaBinaria(datos, disponibles);
+        if (longitud == 0) {
+            longitud = disponibles;  // Trama truncada al final del bloque
+        }
+        trama->longitud = static_cast<int>(longitud);
+        return longitud;
+    }
+    
+    const char* salto = static_cast<const char*>(memchr(datos, '\n', disponibles));
+    size_t largo = salto ? static_cast<size_t>(salto - datos) : disponibles;
+    size_t consumidos = salto ? largo + 1 : largo;
+    
+    // Eliminar el retorno de carro previo al salto de línea
+    if (largo > 0 && datos[largo - 1] == '\r') {
+        largo--;
+    }
+    
+    trama->longitud = static_cast<int>(largo);
+    return consumidos;
+}
+
+int codificarLineaBinaria(const char* linea, int longitud, unsigned char* destino) {
+    if (longitud == 3 && memcmp(linea, "FIN", 3) == 0) {
+        destino[0] = ETIQUETA_FIN;
+        return 1;
+    }
+    
+    if (longitud < 3 || linea[1] != ',') {
+        return 0;
+    }
+    
+    const char* dato = linea + 2;
+    int longitudDato = longitud - 2;
+    int n = 0;
+    
+    switch (linea[0]) {
+        case 'L': case 'l':
+            destino[n++] = ETIQUETA_LOAD;
+            destino[n++] = static_cast<unsigned char>(dato[0]);
+            return n;
+        
+        case 'M': case 'm':
+            destino[n++] = ETIQUETA_MAP;
+            n += escribirVarint(codificarZigzag(enteroDesdeTexto(dato, longitudDato)), destino + n);
+            return n;
+        
+        case 'B': case 'b':
+            for (int i = 0; i < longitudDato; i += MAX_CARGA_BULK_BINARIA) {
+                int tramo = longitudDato - i < MAX_CARGA_BULK_BINARIA ? longitudDato - i : MAX_CARGA_BULK_BINARIA;
+                destino[n++] = ETIQUETA_BULK;
+                n += escribirVarint(static_cast<unsigned int>(tramo), destino + n);
+                memcpy(destino + n, dato + i, tramo);
+                n += tramo;
+            }
+            return n;
+        
+        case 'S': case 's':
+            destino[n++] = ETIQUETA_SELECCION;
+            n += escribirVarint(static_cast<unsigned int>(enteroDesdeTexto(dato, longitudDato)), destino + n);
+            return n;
+        
+        case 'R': case 'r': {
+            const char* coma = static_cast<const char*>(memchr(dato, ',', longitudDato));
+            if (!coma) return 0;
+            int longitudIndice = static_cast<int>(coma - dato);
+            destino[n++] = ETIQUETA_ROTOR;
+            n += escribirVarint(static_cast<unsigned int>(enteroDesdeTexto(dato, longitudIndice)), destino + n);
+            n += escribirVarint(codificarZigzag(enteroDesdeTexto(coma + 1, longitudDato - longitudIndice - 1)),
+                                destino + n);
+            return n;
+        }
+        
+        default:
+            return 0;
+    }
+}
+
+int decodificarTramaATexto(const char* trama, int longitud, char* destino) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(trama);
+    unsigned int valor;
+    int usados;
+    
+    if (longitud == 1 && bytes[0] == ETIQUETA_FIN) {
+        memcpy(destino, "FIN", 3);
+        return 3;
+    }
+    
+    if (longitud < 2) {
+        return 0;
+    }
+    
+    switch (bytes[0]) {
+        case ETIQUETA_LOAD:
+            if (longitud != 2 || !esRepresentableEnTexto(trama + 1, 1)) return 0;
+            destino[0] = 'L';
+            destino[1] = ',';
+            destino[2] = trama[1];
+            return 3;
+        
+        case ETIQUETA_MAP:
+            usados = leerVarint(bytes + 1, longitud - 1, &valor);
+            if (usados <= 0 || 1 + usados != longitud) return 0;
+            return sprintf(destino, "M,%d", decodificarZigzag(valor));
+        
+        case ETIQUETA_BULK:
+            usados = leerVarint(bytes + 1, longitud - 1, &valor);
+            if (usados <= 0 || valor == 0 || 1 + usados + valor != static_cast<unsigned int>(longitud)) return 0;
+            if (!esRepresentableEnTexto(trama + 1 + usados, valor)) return 0;
+            destino[0] = 'B';
+            destino[1] = ',';
+            memcpy(destino + 2, trama + 1 + usados, valor);
+            return 2 + valor;
+        
+        case ETIQUETA_SELECCION:
+            usados = leerVarint(bytes + 1, longitud - 1, &valor);
+            if (usados <= 0 || 1 + usados != longitud) return 0;
+            return sprintf(destino, "S,%u", valor);
+        
+        case ETIQUETA_ROTOR: {
+            usados = leerVarint(bytes + 1, longitud - 1, &valor);
+            if (usados <= 0) return 0;
+            unsigned int rotacion;
+            int segundo = leerVarint(bytes + 1 + usados, longitud - 1 - usados, &rotacion);
+            if (segundo <= 0 || 1 + usados + segundo != longitud) return 0;
+            return sprintf(destino, "R,%u,%d", valor, decodificarZigzag(rotacion));
+        }
+        
+        default:
+            return 0;
+    }
+}
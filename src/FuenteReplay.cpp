@@ -0,0 +1,34 @@
+/**
+ * @file FuenteReplay.cpp
+ * @brief Implementación de la reproducción de capturas
+ */
+
+#include "FuenteReplay.h"
+#include "FormatoBinario.h"
+#include "Metricas.h"
+
+FuenteReplay::FuenteReplay() : posicion(0) {
+}
+
+bool FuenteReplay::abrir(const char* ruta) {
+    posicion = 0;
+    return archivo.abrir(ruta);
+}
+
+int FuenteReplay::leerLineaVista(VistaLinea& linea) {
+    const char* datos = archivo.obtenerDatos();
+    size_t tamanio = archivo.obtenerTamanio();
+    
+    // Líneas de texto o tramas binarias, con las mismas reglas que SerialPort
+    size_t anterior = posicion;
+    while (posicion < tamanio) {
+        posicion += delimitarTrama(datos + posicion, tamanio - posicion, &linea);
+        if (linea.longitud > 0) {
+            Metricas::sumar(CONTADOR_BYTES_LEIDOS, posicion - anterior);
+            return linea.longitud;
+        }
+    }
+    
+    Metricas::sumar(CONTADOR_BYTES_LEIDOS, posicion - anterior);
+    return -1;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file HistogramaLatencia.cpp
+ * @brief Implementación del histograma log-lineal de latencias
+ */
+
+#include "HistogramaLatencia.h"
+#include <cstring>
+
+namespace {
+
+/**
+ * @brief Posición del bit más significativo de un valor positivo
+ */
+inline int bitMasAlto(unsigned long long valor) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(valor);
+#else
+    int bit = 0;
+    while (valor >>= 1) bit++;
+    return bit;
+#endif
+}
+
+} // namespace
+
+HistogramaLatencia::HistogramaLatencia() {
+    reiniciar();
+}
+
+void HistogramaLatencia::reiniciar() {
+    memset(cubetas, 0, sizeof(cubetas));
+    cuenta = 0;
+    maximo = 0;
+}
+
+int HistogramaLatencia::indiceDe(long long valor) {
+    if (valor < SUBCUBETAS_LATENCIA) {
+        return static_cast<int>(valor);
+    }
+
+    int bit = bitMasAlto(static_cast<unsigned long long>(valor));
+    if (bit > MAX_POTENCIA_LATENCIA) {
+        return NUM_CUBETAS_LATENCIA - 1;
+    }
+
+    // Los BITS_SUBCUBETA_LATENCIA bits siguientes al más alto eligen la subcubeta
+    int grupo = bit - BITS_SUBCUBETA_LATENCIA;
+    int subcubeta = static_cast<int>(valor >> grupo) - SUBCUBETAS_LATENCIA;
+    return SUBCUBETAS_LATENCIA + grupo * SUBCUBETAS_LATENCIA + subcubeta;
+}
+
+long long HistogramaLatencia::limiteSuperior(int indice) {
+    if (indice < SUBCUBETAS_LATENCIA) {
+        return indice;
+    }
+
+    int grupo = (indice - SUBCUBETAS_LATENCIA) / SUBCUBETAS_LATENCIA;
+    int subcubeta = (indice - SUBCUBETAS_LATENCIA) % SUBCUBETAS_LATENCIA;
+    long long inferior = static_cast<long long>(SUBCUBETAS_LATENCIA + subcubeta) << grupo;
+    return inferior + (1LL << grupo) - 1;
+}
+
+long long HistogramaLatencia::obtenerPercentil(double percentil) const {
+    if (cuenta == 0) return 0;
+
+    // Número de muestras que deben quedar en o por debajo del resultado
+    unsigned long long objetivo =
+        static_cast<unsigned long long>(percentil / 100.0 * static_cast<double>(cuenta) + 0.5);
+    if (objetivo < 1) objetivo = 1;
+    if (objetivo > cuenta) objetivo = cuenta;
+
+    unsigned long long acumuladas = 0;
+    for (int i = 0; i < NUM_CUBETAS_LATENCIA; ++i) {
+        acumuladas += cubetas[i];
+        if (acumuladas >= objetivo) {
+            long long limite = limiteSuperior(i);
+            return limite < maximo ? limite : maximo;
+        }
+    }
+    return maximo;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file LatenciasDeTramas.cpp
+ * @brief Implementación de los histogramas por etapa y tipo de trama
+ */
+
+#include "LatenciasDeTramas.h"
+#include "FormatoBinario.h"
+
+volatile sig_atomic_t LatenciasDeTramas::informeSolicitado = 0;
+
+namespace {
+
+const char* const NOMBRES_ETAPA[NUM_ETAPAS_LATENCIA] = {
+    "llegada->carga", "carga->salida", "llegada->salida"
+};
+
+const char* const NOMBRES_TIPO[NUM_TIPOS_LATENCIA] = {
+    "LOAD", "MAP", "BULK", "otra"
+};
+
+const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+const int NUM_PERCENTILES = sizeof(PERCENTILES) / sizeof(PERCENTILES[0]);
+
+} // namespace
+
+TipoLatencia clasificarTrama(unsigned char tipo) {
+    switch (tipo) {
+        case 'L': case 'l': case ETIQUETA_LOAD: return LATENCIA_LOAD;
+        case 'M': case 'm': case ETIQUETA_MAP:  return LATENCIA_MAP;
+        case 'B': case 'b': case ETIQUETA_BULK: return LATENCIA_BULK;
+        default: return LATENCIA_OTRA;
+    }
+}
+
+void LatenciasDeTramas::imprimir(FILE* destino) const {
+    fprintf(destino, "Latencias por trama (us):\n");
+    fprintf(destino, "  %-16s %-5s %10s %9s %9s %9s %9s %9s\n",
+            "etapa", "tipo", "n", "p50", "p90", "p99", "p99.9", "max");
+
+    bool vacio = true;
+    for (int e = 0; e < NUM_ETAPAS_LATENCIA; ++e) {
+        for (int t = 0; t < NUM_TIPOS_LATENCIA; ++t) {
+            const HistogramaLatencia& h = histogramas[e][t];
+            if (h.obtenerCuenta() == 0) continue;
+            vacio = false;
+
+            fprintf(destino, "  %-16s %-5s %10llu", NOMBRES_ETAPA[e], NOMBRES_TIPO[t], h.obtenerCuenta());
+            for (int p = 0; p < NUM_PERCENTILES; ++p) {
+                fprintf(destino, " %9.1f", h.obtenerPercentil(PERCENTILES[p]) / 1000.0);
+            }
+            fprintf(destino, " %9.1f\n", h.obtenerMaximo() / 1000.0);
+        }
+    }
+
+    if (vacio) {
+        fprintf(destino, "  (sin muestras)\n");
+    }
+    fflush(destino);
+}
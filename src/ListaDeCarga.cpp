@@ -5,8 +5,53 @@
 
 #include "ListaDeCarga.h"
 #include <cstdio>   // Para printf
+#include <cstring>  // Para memcpy
 
-ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0) {
+PoolDeNodosCarga::PoolDeNodosCarga() : bloques(nullptr), libres(nullptr), bloquesReservados(0) {
+    // Pool vacío
+}
+
+PoolDeNodosCarga::~PoolDeNodosCarga() {
+    BloquePool* actual = bloques;
+    while (actual) {
+        BloquePool* siguiente = actual->siguiente;
+        delete actual;
+        actual = siguiente;
+    }
+    
+    bloques = nullptr;
+    libres = nullptr;
+}
+
+NodoCarga* PoolDeNodosCarga::obtener() {
+    if (!libres) {
+        // Reservar un bloque nuevo y encadenar todos sus nodos como libres
+        BloquePool* bloque = new BloquePool;
+        bloque->siguiente = bloques;
+        bloques = bloque;
+        bloquesReservados++;
+        
+        for (int i = 0; i < NODOS_POR_BLOQUE_POOL; ++i) {
+            bloque->nodos[i].siguiente = libres;
+            libres = &bloque->nodos[i];
+        }
+    }
+    
+    NodoCarga* nodo = libres;
+    libres = nodo->siguiente;
+    
+    nodo->siguiente = nullptr;
+    nodo->previo = nullptr;
+    nodo->cantidad = 0;
+    return nodo;
+}
+
+void PoolDeNodosCarga::devolver(NodoCarga* nodo) {
+    nodo->siguiente = libres;
+    libres = nodo;
+}
+
+ListaDeCarga::ListaDeCarga() : cabeza(nullptr), cola(nullptr), tamanio(0), descartados(0) {
     // Lista vacía
 }
 
@@ -14,23 +59,48 @@ ListaDeCarga::~ListaDeCarga() {
     limpiar();
 }
 
-void ListaDeCarga::insertarAlFinal(char dato) {
-    NodoCarga* nuevo = new NodoCarga(dato);
+void ListaDeCarga::agregarNodo() {
+    NodoCarga* nuevo = pool.obtener();
     
     if (!cabeza) {
         // Lista vacía
         cabeza = nuevo;
         cola = nuevo;
     } else {
-        // Insertar al final
+        // Enlazar al final
         cola->siguiente = nuevo;
         nuevo->previo = cola;
         cola = nuevo;
     }
+}
+
+void ListaDeCarga::insertarAlFinal(char dato) {
+    if (!cola || cola->cantidad == CAPACIDAD_NODO_CARGA) {
+        agregarNodo();
+    }
     
+    cola->datos[cola->cantidad++] = dato;
     tamanio++;
 }
 
+void ListaDeCarga::insertarBloque(const char* datos, int n) {
+    while (n > 0) {
+        if (!cola || cola->cantidad == CAPACIDAD_NODO_CARGA) {
+            agregarNodo();
+        }
+        
+        // Copiar lo que quepa en el nodo de la cola
+        int espacio = CAPACIDAD_NODO_CARGA - cola->cantidad;
+        int copiar = n < espacio ? n : espacio;
+        memcpy(cola->datos + cola->cantidad, datos, copiar);
+        
+        cola->cantidad += copiar;
+        tamanio += copiar;
+        datos += copiar;
+        n -= copiar;
+    }
+}
+
 void ListaDeCarga::imprimirMensaje() const {
     if (!cabeza) {
         printf("(mensaje vacío)\n");
@@ -39,7 +109,7 @@ void ListaDeCarga::imprimirMensaje() const {
     
     NodoCarga* actual = cabeza;
     while (actual) {
-        printf("%c", actual->dato);
+        fwrite(actual->datos, 1, actual->cantidad, stdout);
         actual = actual->siguiente;
     }
     printf("\n");
@@ -49,15 +119,42 @@ void ListaDeCarga::limpiar() {
     NodoCarga* actual = cabeza;
     while (actual) {
         NodoCarga* siguiente = actual->siguiente;
-        delete actual;
+        pool.devolver(actual);
         actual = siguiente;
     }
     
     cabeza = nullptr;
     cola = nullptr;
+    descartados += tamanio;
     tamanio = 0;
 }
 
+void ListaDeCarga::descartarPrincipio(int n) {
+    if (n >= tamanio) {
+        limpiar();
+        return;
+    }
+    
+    // Nodos completos de vuelta al pool
+    while (n > 0 && n >= cabeza->cantidad) {
+        NodoCarga* siguiente = cabeza->siguiente;
+        n -= cabeza->cantidad;
+        tamanio -= cabeza->cantidad;
+        descartados += cabeza->cantidad;
+        pool.devolver(cabeza);
+        cabeza = siguiente;
+        cabeza->previo = nullptr;
+    }
+    
+    // Parte del primer nodo
+    if (n > 0) {
+        memmove(cabeza->datos, cabeza->datos + n, cabeza->cantidad - n);
+        cabeza->cantidad -= n;
+        tamanio -= n;
+        descartados += n;
+    }
+}
+
 char* ListaDeCarga::obtenerMensajeComoString() const {
     // Alocar memoria para la cadena (tamaño + 1 para '\0')
     char* mensaje = new char[tamanio + 1];
@@ -65,10 +162,44 @@ char* ListaDeCarga::obtenerMensajeComoString() const {
     int indice = 0;
     NodoCarga* actual = cabeza;
     while (actual) {
-        mensaje[indice++] = actual->dato;
+        memcpy(mensaje + indice, actual->datos, actual->cantidad);
+        indice += actual->cantidad;
         actual = actual->siguiente;
     }
     
     mensaje[indice] = '\0';
     return mensaje;
 }
+
+const NodoCarga* ListaDeCarga::buscarDesdeCola(int posicion, int* desplazamiento) const {
+    // Retroceder desde la cola hasta el nodo que contiene 'posicion'
+    const NodoCarga* actual = cola;
+    int inicioNodo = tamanio - cola->cantidad;
+    while (inicioNodo > posicion) {
+        actual = actual->previo;
+        inicioNodo -= actual->cantidad;
+    }
+    
+    *desplazamiento = posicion - inicioNodo;
+    return actual;
+}
+
+int ListaDeCarga::copiarDesde(int posicion, char* destino, int maxCaracteres) const {
+    if (posicion < 0 || posicion >= tamanio || maxCaracteres <= 0) return 0;
+    
+    int desplazamiento;
+    const NodoCarga* actual = buscarDesdeCola(posicion, &desplazamiento);
+    
+    // Copiar hacia adelante
+    int copiados = 0;
+    while (actual && copiados < maxCaracteres) {
+        int disponibles = actual->cantidad - desplazamiento;
+        int copiar = disponibles < maxCaracteres - copiados ? disponibles : maxCaracteres - copiados;
+        memcpy(destino + copiados, actual->datos + desplazamiento, copiar);
+        copiados += copiar;
+        desplazamiento = 0;
+        actual = actual->siguiente;
+    }
+    
+    return copiados;
+}
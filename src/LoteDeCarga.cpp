@@ -0,0 +1,18 @@
+/**
+ * @file LoteDeCarga.cpp
+ * @brief Implementación del acumulador de tramas LOAD
+ */
+
+#include "LoteDeCarga.h"
+
+int LoteDeCarga::vaciar(ListaDeCarga* carga, const RotorDeMapeo* rotor) {
+    int n = cantidad;
+    if (n == 0) return 0;
+    
+    // Un solo corrimiento para toda la racha
+    rotor->mapearBloque(pendientes, decodificados, n);
+    carga->insertarBloque(decodificados, n);
+    
+    cantidad = 0;
+    return n;
+}
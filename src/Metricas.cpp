@@ -0,0 +1,36 @@
+/**
+ * @file Metricas.cpp
+ * @brief Implementación del registro de métricas
+ */
+
+#include "Metricas.h"
+
+std::atomic<ContadoresDeHilo*> Metricas::listaHilos(nullptr);
+std::atomic<long long> Metricas::indicadores[NUM_INDICADORES_METRICA];
+thread_local ContadoresDeHilo* Metricas::contadoresDelHilo = nullptr;
+
+ContadoresDeHilo* Metricas::registrarHilo() {
+    ContadoresDeHilo* bloque = new ContadoresDeHilo;
+    for (int i = 0; i < NUM_CONTADORES_METRICA; ++i) {
+        bloque->valores[i].store(0, std::memory_order_relaxed);
+    }
+
+    // Insertar al frente de la lista sin bloqueo; los bloques no se liberan
+    ContadoresDeHilo* cabeza = listaHilos.load(std::memory_order_relaxed);
+    do {
+        bloque->siguiente = cabeza;
+    } while (!listaHilos.compare_exchange_weak(cabeza, bloque, std::memory_order_release,
+                                               std::memory_order_relaxed));
+
+    contadoresDelHilo = bloque;
+    return bloque;
+}
+
+unsigned long long Metricas::totalDe(ContadorMetrica contador) {
+    unsigned long long total = 0;
+    for (ContadoresDeHilo* bloque = listaHilos.load(std::memory_order_acquire);
+         bloque; bloque = bloque->siguiente) {
+        total += bloque->valores[contador].load(std::memory_order_relaxed);
+    }
+    return total;
+}
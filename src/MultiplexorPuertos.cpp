@@ -0,0 +1,278 @@
+/**
+ * @file MultiplexorPuertos.cpp
+ * @brief Implementación del multiplexor de puertos con epoll
+ */
+
+#include "MultiplexorPuertos.h"
+#include <cstdio>
+#include <cstring>
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+namespace {
+
+/// Líneas que se piden al puerto en cada llamada a leerLineas(): el lote de cada ronda
+const int LINEAS_POR_LECTURA = 64;
+
+} // namespace
+
+CanalPuerto::CanalPuerto(const char* nombrePuerto, const RegistroDeTramas* registro,
+                         TipoAlfabeto alfabeto, const char* cascada)
+    : puerto(nullptr),
+      rotor(alfabeto),
+      procesador(&carga, &rotor, registro, false),
+      activo(false),
+      pendiente(false),
+      eventos(0) {
+    snprintf(nombre, sizeof(nombre), "%s", nombrePuerto);
+    if (cascada) {
+        rotor.configurarCascada(cascada);
+    }
+}
+
+CanalPuerto::~CanalPuerto() {
+    delete puerto;
+}
+
+MultiplexorPuertos::MultiplexorPuertos(const char* listaPuertos, TipoAlfabeto alfabeto,
+                                       const char* cascada)
+    : numCanales(0), descriptorEpoll(-1), desatendido(false) {
+    // Separar la lista "a,b,c" sin modificar la cadena original
+    const char* inicio = listaPuertos;
+    while (inicio && *inicio && numCanales < MAX_PUERTOS_MULTIPLEXADOS) {
+        const char* coma = strchr(inicio, ',');
+        int longitud = coma ? static_cast<int>(coma - inicio) : static_cast<int>(strlen(inicio));
+        
+        if (longitud > 0) {
+            char nombre[128];
+            snprintf(nombre, sizeof(nombre), "%.*s", longitud, inicio);
+            canales[numCanales++] = new CanalPuerto(nombre, &registro, alfabeto, cascada);
+        }
+        
+        inicio = coma ? coma + 1 : nullptr;
+    }
+}
+
+MultiplexorPuertos::~MultiplexorPuertos() {
+    for (int i = 0; i < numCanales; ++i) {
+        delete canales[i];
+    }
+    
+#ifdef __linux__
+    if (descriptorEpoll >= 0) {
+        close(descriptorEpoll);
+    }
+#endif
+}
+
+#ifdef __linux__
+
+int MultiplexorPuertos::abrir(const ConfiguracionSerial& config) {
+    descriptorEpoll = epoll_create1(0);
+    if (descriptorEpoll < 0) {
+        printf("Error: No se pudo crear la instancia de epoll (errno: %d)\n", errno);
+        return 0;
+    }
+    
+    int abiertos = 0;
+    for (int i = 0; i < numCanales; ++i) {
+        CanalPuerto* canal = canales[i];
+        canal->puerto = new SerialPort(canal->nombre, config);
+        
+        if (!canal->puerto->estaConectado() || !canal->puerto->establecerNoBloqueante(true)) {
+            printf("Advertencia: No se pudo abrir el puerto %s\n", canal->nombre);
+            continue;
+        }
+        
+        struct epoll_event evento;
+        memset(&evento, 0, sizeof(evento));
+        evento.events = EPOLLIN;
+        evento.data.ptr = canal;
+        
+        if (epoll_ctl(descriptorEpoll, EPOLL_CTL_ADD, canal->puerto->obtenerDescriptor(), &evento) < 0) {
+            printf("Advertencia: No se pudo registrar el puerto %s en epoll\n", canal->nombre);
+            continue;
+        }
+        
+        canal->activo = true;
+        abiertos++;
+    }
+    
+    return abiertos;
+}
+
+bool MultiplexorPuertos::atenderCanal(CanalPuerto* canal) {
+    VistaLinea lineas[LINEAS_POR_LECTURA];
+    
+    int n = canal->puerto->leerLineas(lineas, LINEAS_POR_LECTURA);
+    if (n < 0) {
+        return false;
+    }
+    
+    for (int i = 0; i < n; ++i) {
+        if (lineas[i].longitud > 0) {
+            canal->procesador.procesarLinea(lineas[i].datos, lineas[i].longitud);
+        }
+    }
+    
+    // Un lote lleno puede dejar líneas en el buffer; uno incompleto lo vació
+    canal->pendiente = n == LINEAS_POR_LECTURA;
+    if (!canal->pendiente) {
+        // Sin más líneas completas: decodificar la racha pendiente
+        canal->procesador.vaciarPendientes();
+    }
+    return true;
+}
+
+void MultiplexorPuertos::cerrarCanal(CanalPuerto* canal) {
+    if (!canal->activo) return;
+    
+    epoll_ctl(descriptorEpoll, EPOLL_CTL_DEL, canal->puerto->obtenerDescriptor(), nullptr);
+    canal->procesador.vaciarPendientes();
+    canal->procesador.anotarFinDeFlujo();
+    canal->puerto->cerrar();
+    canal->activo = false;
+    canal->pendiente = false;
+}
+
+void MultiplexorPuertos::ejecutar(int inactividadMs) {
+    struct epoll_event eventos[MAX_PUERTOS_MULTIPLEXADOS];
+    
+    int activos = 0;
+    for (int i = 0; i < numCanales; ++i) {
+        if (canales[i]->activo) activos++;
+    }
+    
+    // La tubería de aviso de la parada despierta epoll_wait() aunque la
+    // señal la reciba otro hilo (el del exportador o el de la bitácora)
+    int aviso = ControlDeParada::obtenerDescriptorAviso();
+    if (aviso >= 0) {
+        struct epoll_event evento;
+        evento.events = EPOLLIN;
+        evento.data.ptr = nullptr;
+        epoll_ctl(descriptorEpoll, EPOLL_CTL_ADD, aviso, &evento);
+    }
+    FILE* avisos = desatendido ? stderr : stdout;
+    
+    int pendientes = 0;
+    while (activos > 0) {
+        // Dormir hasta que algún puerto tenga datos (sin espera activa), salvo
+        // que un puerto tenga líneas en su buffer de la ronda anterior
+        int espera = pendientes > 0 ? 0 : (inactividadMs > 0 ? inactividadMs : -1);
+        int n = epoll_wait(descriptorEpoll, eventos, MAX_PUERTOS_MULTIPLEXADOS, espera);
+        
+        if (n < 0) {
+            if (errno == EINTR) continue;  // La parada se atiende abajo
+            printf("Error en epoll_wait (errno: %d)\n", errno);
+            break;
+        }
+        
+        if (n == 0 && pendientes == 0) {
+            fprintf(avisos, "\nNo se reciben más datos en ningún puerto. Finalizando...\n");
+            break;
+        }
+        
+        if (ControlDeParada::solicitada()) {
+            fprintf(avisos, "\nSeñal %d recibida. Finalizando...\n", ControlDeParada::obtenerSenal());
+            break;
+        }
+        
+        for (int i = 0; i < n; ++i) {
+            CanalPuerto* canal = static_cast<CanalPuerto*>(eventos[i].data.ptr);
+            if (canal) canal->eventos = eventos[i].events;
+        }
+        
+        // Un lote por canal con datos en el descriptor o en su buffer
+        pendientes = 0;
+        for (int i = 0; i < numCanales; ++i) {
+            CanalPuerto* canal = canales[i];
+            unsigned int listos = canal->eventos;
+            canal->eventos = 0;
+            if (!canal->activo || (listos == 0 && !canal->pendiente)) continue;
+            
+            bool correcto = atenderCanal(canal);
+            
+            // Error de lectura, o el otro extremo se cerró y ya no quedan
+            // líneas (epoll sigue avisando del cierre mientras tanto)
+            if (!correcto || ((listos & (EPOLLERR | EPOLLHUP)) && !canal->pendiente)) {
+                printf("Puerto %s cerrado.\n", canal->nombre);
+                cerrarCanal(canal);
+                activos--;
+            } else if (canal->pendiente) {
+                pendientes++;
+            }
+        }
+    }
+    
+    for (int i = 0; i < numCanales; ++i) {
+        if (canales[i]->activo) {
+            cerrarCanal(canales[i]);
+        }
+    }
+}
+
+#else
+
+int MultiplexorPuertos::abrir(const ConfiguracionSerial& config) {
+    (void)config;
+    printf("Error: El modo multipuerto solo está disponible en Linux\n");
+    return 0;
+}
+
+bool MultiplexorPuertos::atenderCanal(CanalPuerto* canal) {
+    (void)canal;
+    return false;
+}
+
+void MultiplexorPuertos::cerrarCanal(CanalPuerto* canal) {
+    canal->activo = false;
+}
+
+void MultiplexorPuertos::ejecutar(int inactividadMs) {
+    (void)inactividadMs;
+}
+
+#endif // __linux__
+
+void MultiplexorPuertos::establecerBitacora(Bitacora* destino) {
+    for (int i = 0; i < numCanales; ++i) {
+        canales[i]->procesador.establecerBitacora(destino, i + 1);
+    }
+}
+
+void MultiplexorPuertos::imprimirResumen() const {
+    long totalTramas = 0;
+    long totalInvalidas = 0;
+    long totalCaracteres = 0;
+    
+    printf("\n");
+    printf("====================================================\n");
+    printf("         DECODIFICACIÓN MULTIPUERTO COMPLETADA      \n");
+    printf("====================================================\n");
+    
+    for (int i = 0; i < numCanales; ++i) {
+        const CanalPuerto* canal = canales[i];
+        
+        printf("\nPuerto %s:\n", canal->nombre);
+        printf("  - Tramas procesadas: %d\n", canal->procesador.obtenerTramasProcesadas());
+        printf("  - Tramas inválidas: %d\n", canal->procesador.obtenerTramasInvalidas());
+        printf("  - Caracteres decodificados: %d\n", canal->carga.obtenerTamanio());
+        printf("  - Mensaje: ");
+        canal->carga.imprimirMensaje();
+        
+        totalTramas += canal->procesador.obtenerTramasProcesadas();
+        totalInvalidas += canal->procesador.obtenerTramasInvalidas();
+        totalCaracteres += canal->carga.obtenerTamanio();
+    }
+    
+    printf("\n---------------------------------------------------\n");
+    printf("Resumen agregado (%d puerto(s)):\n", numCanales);
+    printf("  - Tramas procesadas: %ld\n", totalTramas);
+    printf("  - Tramas inválidas: %ld\n", totalInvalidas);
+    printf("  - Caracteres decodificados: %ld\n", totalCaracteres);
+    printf("---------------------------------------------------\n");
+}
@@ -0,0 +1,397 @@
+/**
+ * @file Opciones.cpp
+ * @brief Interpretación de la línea de comandos del decodificador
+ */
+
+#include "Opciones.h"
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+namespace {
+
+/**
+ * @brief Compara un argumento con el nombre corto y largo de una opción
+ * @param arg Argumento recibido
+ * @param corto Nombre corto (puede ser nullptr)
+ * @param largo Nombre largo
+ * @return true si coincide con alguno
+ */
+bool esOpcion(const char* arg, const char* corto, const char* largo) {
+    return (corto && strcmp(arg, corto) == 0) || strcmp(arg, largo) == 0;
+}
+
+/**
+ * @brief Obtiene el valor que sigue a una opción
+ * @param argc Número de argumentos
+ * @param argv Argumentos del programa
+ * @param i Índice de la opción (avanza al valor si existe)
+ * @return Valor de la opción, o nullptr si falta
+ */
+const char* obtenerValor(int argc, char* argv[], int* i) {
+    if (*i + 1 >= argc) {
+        fprintf(stderr, "Error: Falta el valor de la opción %s\n", argv[*i]);
+        return nullptr;
+    }
+    *i += 1;
+    return argv[*i];
+}
+
+/**
+ * @brief Convierte un valor de opción a entero con validación
+ * @param texto Texto del valor
+ * @param valor Variable donde se guarda el resultado
+ * @return true si el texto es un entero completo
+ */
+bool convertirEntero(const char* texto, int* valor) {
+    if (!texto) return false;
+    
+    char* finNumero = nullptr;
+    long numero = strtol(texto, &finNumero, 10);
+    if (finNumero == texto || *finNumero != '\0') {
+        fprintf(stderr, "Error: Valor numérico inválido: %s\n", texto);
+        return false;
+    }
+    
+    *valor = static_cast<int>(numero);
+    return true;
+}
+
+} // namespace
+
+ResultadoOpciones parsearOpciones(int argc, char* argv[], OpcionesDecodificador* opciones) {
+    ConfiguracionSerial& serial = opciones->serial;
+    
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        
+        if (esOpcion(arg, "-h", "--ayuda")) {
+            return OPCIONES_AYUDA;
+        }
+        else if (esOpcion(arg, "-b", "--baudios")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &serial.baudios)) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--bits")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &serial.bitsDatos)) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--parada")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &serial.bitsParada)) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--vmin")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &serial.vmin)) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--vtime")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &serial.vtime)) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--paridad")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            serial.paridad = valor[0] >= 'a' && valor[0] <= 'z' ? valor[0] - 'a' + 'A' : valor[0];
+        }
+        else if (esOpcion(arg, nullptr, "--flujo")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (strcmp(valor, "ninguno") == 0)  serial.controlFlujo = 'N';
+            else if (strcmp(valor, "hw") == 0)  serial.controlFlujo = 'H';
+            else if (strcmp(valor, "sw") == 0)  serial.controlFlujo = 'S';
+            else {
+                fprintf(stderr, "Error: Control de flujo desconocido: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--crudo")) {
+            serial.modoCrudo = true;
+        }
+        else if (esOpcion(arg, "-p", "--puerto")) {
+            opciones->puerto = obtenerValor(argc, argv, &i);
+            if (!opciones->puerto) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, "-P", "--puertos")) {
+            opciones->puertos = obtenerValor(argc, argv, &i);
+            if (!opciones->puertos) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--pipeline")) {
+            opciones->pipeline = true;
+        }
+        else if (esOpcion(arg, nullptr, "--desborde")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (strcmp(valor, "bloquear") == 0)       opciones->desborde = DESBORDE_BLOQUEAR;
+            else if (strcmp(valor, "descartar") == 0) opciones->desborde = DESBORDE_DESCARTAR;
+            else {
+                fprintf(stderr, "Error: Política de desborde desconocida: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, "-d", "--decodificar")) {
+            opciones->captura = obtenerValor(argc, argv, &i);
+            if (!opciones->captura) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, "-o", "--destino")) {
+            opciones->destino = obtenerValor(argc, argv, &i);
+            if (!opciones->destino) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, "-r", "--reproducir")) {
+            opciones->reproduccion = obtenerValor(argc, argv, &i);
+            if (!opciones->reproduccion) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, "-s", "--salida")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (strcmp(valor, "detallada") == 0)        opciones->salida = SALIDA_DETALLADA;
+            else if (strcmp(valor, "silenciosa") == 0)  opciones->salida = SALIDA_SILENCIOSA;
+            else if (strcmp(valor, "incremental") == 0) opciones->salida = SALIDA_INCREMENTAL;
+            else if (strcmp(valor, "periodica") == 0)   opciones->salida = SALIDA_PERIODICA;
+            else {
+                fprintf(stderr, "Error: Modo de salida desconocido: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+            opciones->salidaIndicada = true;
+        }
+        else if (esOpcion(arg, nullptr, "--alfabeto")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (strcmp(valor, "mayusculas") == 0)        opciones->alfabeto = ALFABETO_MAYUSCULAS;
+            else if (strcmp(valor, "alfanumerico") == 0) opciones->alfabeto = ALFABETO_ALFANUMERICO;
+            else if (strcmp(valor, "imprimible") == 0)   opciones->alfabeto = ALFABETO_IMPRIMIBLE;
+            else if (strcmp(valor, "bytes") == 0)        opciones->alfabeto = ALFABETO_BYTES;
+            else {
+                fprintf(stderr, "Error: Alfabeto desconocido: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--rotores")) {
+            opciones->rotores = obtenerValor(argc, argv, &i);
+            if (!opciones->rotores) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--estado")) {
+            opciones->estado = obtenerValor(argc, argv, &i);
+            if (!opciones->estado) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--sincronizar")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (strcmp(valor, "trama") == 0)      opciones->sincronizacion = SINCRONIZAR_TRAMA;
+            else if (strcmp(valor, "lote") == 0)  opciones->sincronizacion = SINCRONIZAR_LOTE;
+            else if (strcmp(valor, "nunca") == 0) opciones->sincronizacion = SINCRONIZAR_NUNCA;
+            else {
+                fprintf(stderr, "Error: Política de sincronización desconocida: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--lote-diario")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->loteDiario)) return OPCIONES_ERROR;
+            if (opciones->loteDiario < 1) {
+                fprintf(stderr, "Error: El lote del diario debe ser de al menos 1 trama\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--punto-cada")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->tramasPorPunto)) return OPCIONES_ERROR;
+            if (opciones->tramasPorPunto < 1) {
+                fprintf(stderr, "Error: Debe haber al menos 1 trama entre puntos de control\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--mensajes")) {
+            opciones->mensajes = obtenerValor(argc, argv, &i);
+            if (!opciones->mensajes) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--ventana")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->ventana)) return OPCIONES_ERROR;
+            if (opciones->ventana < 1) {
+                fprintf(stderr, "Error: La ventana debe ser de al menos 1 carácter\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--fin")) {
+            opciones->delimitador = obtenerValor(argc, argv, &i);
+            if (!opciones->delimitador) return OPCIONES_ERROR;
+            int longitud = static_cast<int>(strlen(opciones->delimitador));
+            if (longitud < 1 || longitud > LONGITUD_MAX_DELIMITADOR) {
+                fprintf(stderr, "Error: El delimitador debe tener entre 1 y %d caracteres\n", LONGITUD_MAX_DELIMITADOR);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--bitacora")) {
+            const char* valor = obtenerValor(argc, argv, &i);
+            if (!valor) return OPCIONES_ERROR;
+            if (!nivelBitacoraDesdeTexto(valor, &opciones->bitacora)) {
+                fprintf(stderr, "Error: Nivel de bitácora desconocido: %s\n", valor);
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--archivo-bitacora")) {
+            opciones->archivoBitacora = obtenerValor(argc, argv, &i);
+            if (!opciones->archivoBitacora) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--inactividad")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->inactividad)) return OPCIONES_ERROR;
+            if (opciones->inactividad < 0) {
+                fprintf(stderr, "Error: La inactividad no puede ser negativa\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--desatendido")) {
+            opciones->desatendido = true;
+        }
+        else if (esOpcion(arg, nullptr, "--intervalo")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->intervaloProgreso)) return OPCIONES_ERROR;
+            if (opciones->intervaloProgreso < 1) {
+                fprintf(stderr, "Error: El intervalo debe ser de al menos 1 ms\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--latencias")) {
+            opciones->latencias = true;
+        }
+        else if (esOpcion(arg, nullptr, "--metricas")) {
+            opciones->metricas = obtenerValor(argc, argv, &i);
+            if (!opciones->metricas) return OPCIONES_ERROR;
+        }
+        else if (esOpcion(arg, nullptr, "--intervalo-metricas")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->intervaloMetricas)) return OPCIONES_ERROR;
+            if (opciones->intervaloMetricas < 1) {
+                fprintf(stderr, "Error: El intervalo de métricas debe ser de al menos 1 ms\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--hilos")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->hilos)) return OPCIONES_ERROR;
+            if (opciones->hilos < 0) {
+                fprintf(stderr, "Error: El número de hilos no puede ser negativo\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else if (esOpcion(arg, nullptr, "--capacidad-cola")) {
+            if (!convertirEntero(obtenerValor(argc, argv, &i), &opciones->capacidadCola)) return OPCIONES_ERROR;
+            if (opciones->capacidadCola < 2 || opciones->capacidadCola > (1 << 20)) {
+                fprintf(stderr, "Error: La capacidad de cola debe estar entre 2 y 1048576\n");
+                return OPCIONES_ERROR;
+            }
+        }
+        else {
+            fprintf(stderr, "Error: Opción desconocida: %s\n", arg);
+            return OPCIONES_ERROR;
+        }
+    }
+    
+    if (opciones->estado && (opciones->captura || opciones->puertos)) {
+        fprintf(stderr, "Error: --estado solo se admite con un puerto o con --reproducir\n");
+        return OPCIONES_ERROR;
+    }
+    
+    if (opciones->mensajes && (opciones->captura || opciones->puertos)) {
+        fprintf(stderr, "Error: --mensajes solo se admite con un puerto o con --reproducir\n");
+        return OPCIONES_ERROR;
+    }
+    
+    if (opciones->bitacora != BITACORA_APAGADA && opciones->captura) {
+        fprintf(stderr, "Error: --bitacora no se admite con --decodificar\n");
+        return OPCIONES_ERROR;
+    }
+    
+    if (opciones->puerto && (opciones->puertos || opciones->reproduccion || opciones->captura)) {
+        fprintf(stderr, "Error: --puerto no se admite con --puertos, --reproducir ni --decodificar\n");
+        return OPCIONES_ERROR;
+    }
+    
+    if (opciones->desatendido && !opciones->puerto && !opciones->puertos &&
+        !opciones->reproduccion && !opciones->captura) {
+        fprintf(stderr, "Error: --desatendido necesita --puerto, --puertos o --reproducir\n");
+        return OPCIONES_ERROR;
+    }
+    
+    const char* error = validarConfiguracionSerial(serial);
+    if (error) {
+        fprintf(stderr, "Error: Configuración serial inválida: %s\n", error);
+        return OPCIONES_ERROR;
+    }
+    
+    return OPCIONES_OK;
+}
+
+void imprimirAyuda(const char* programa) {
+    printf("Uso: %s [opciones]\n", programa);
+    printf("\n");
+    printf("Puerto serial:\n");
+    printf("  -b, --baudios N        Velocidad en baudios (9600 por defecto, hasta 4000000)\n");
+    printf("      --bits N           Bits de datos, 5 a 8 (8 por defecto)\n");
+    printf("      --paridad N|E|O    Paridad (N por defecto)\n");
+    printf("      --parada 1|2       Bits de parada (1 por defecto)\n");
+    printf("      --flujo MODO       Control de flujo: ninguno, hw (RTS/CTS) o sw (XON/XOFF)\n");
+    printf("      --vmin N           Bytes mínimos por lectura, VMIN (0 por defecto)\n");
+    printf("      --vtime N          Timeout de lectura en décimas de segundo, VTIME (1 por defecto)\n");
+    printf("      --crudo            Configurar el puerto a partir de cfmakeraw()\n");
+    printf("  -p, --puerto RUTA      Puerto serial (por defecto se pregunta al arrancar)\n");
+    printf("\n");
+    printf("Servicio:\n");
+    printf("      --desatendido      Sin banner, instrucciones ni preguntas (exige -p, -P o -r);\n");
+    printf("                         salida silenciosa salvo que se indique -s\n");
+    printf("      --inactividad MS   Terminar tras MS sin datos (5000 por defecto, 0 = nunca)\n");
+    printf("                         SIGTERM o SIGINT terminan en orden: se decodifica lo\n");
+    printf("                         pendiente, se guarda el estado y se imprimen los resultados\n");
+    printf("\n");
+    printf("Modo multipuerto (Linux):\n");
+    printf("  -P, --puertos A,B,...  Decodificar varios puertos en un solo hilo con epoll,\n");
+    printf("                         con un rotor y una lista de carga por puerto\n");
+    printf("\n");
+    printf("Salida:\n");
+    printf("  -s, --salida MODO      detallada (cada trama; por defecto con puerto),\n");
+    printf("                         silenciosa (solo el mensaje final; por defecto al reproducir),\n");
+    printf("                         incremental (solo los caracteres nuevos) o\n");
+    printf("                         periodica (una línea de progreso por intervalo)\n");
+    printf("      --intervalo MS     Intervalo del modo periódico (1000 por defecto)\n");
+    printf("      --latencias        Medir la latencia de cada trama (llegada, carga, salida) e\n");
+    printf("                         imprimir percentiles al terminar y con SIGUSR1\n");
+    printf("      --metricas ARCH    Escribir métricas en formato Prometheus (textfile de\n");
+    printf("                         node_exporter): tramas, inválidas por motivo, bytes, lecturas,\n");
+    printf("                         tasas, rotor y colas\n");
+    printf("      --intervalo-metricas MS  Intervalo entre escrituras (5000 por defecto)\n");
+    printf("      --bitacora NIVEL   Bitácora escrita por un hilo aparte, sin frenar la lectura:\n");
+    printf("                         apagada (por defecto), resumen (mensajes y totales), trama\n");
+    printf("                         (además cada trama) o depuracion (además lotes, puntos de\n");
+    printf("                         control y pausas). Con -s silenciosa da el detalle por\n");
+    printf("                         trama sin imprimir en el hilo que decodifica\n");
+    printf("      --archivo-bitacora ARCH  Anexar la bitácora a ARCH (stderr por defecto)\n");
+    printf("\n");
+    printf("Rotor:\n");
+    printf("      --alfabeto NOMBRE  mayusculas (A-Z, por defecto), alfanumerico (0-9A-Za-z),\n");
+    printf("                         imprimible (ASCII 0x20-0x7E) o bytes (los 256 valores)\n");
+    printf("      --rotores ESPEC    Cascada de rotores: cableados separados por comas, cada uno\n");
+    printf("                         una permutación del alfabeto con \":X\" opcional para la muesca\n");
+    printf("                         (ej. EKMFLGDQVZNTOWYHXUSPAIBRCJ:Q,AJDKSIRUXBLHWTMCQGZNPYFVOE:E),\n");
+    printf("                         o un número de rotores sin cableado. Las tramas S,I y R,I,N\n");
+    printf("                         seleccionan y rotan rotores concretos\n");
+    printf("\n");
+    printf("Reanudación (un puerto o --reproducir):\n");
+    printf("      --estado BASE      Guardar el rotor y el mensaje en BASE.ckpt, BASE.carga y un\n");
+    printf("                         diario de tramas (BASE.diario), y reanudar desde ellos al arrancar\n");
+    printf("      --sincronizar P    Cuándo llevar el diario al disco: trama (fdatasync por trama),\n");
+    printf("                         lote (por bloque, como mucho una vez por segundo; por defecto)\n");
+    printf("                         o nunca (solo protege de la caída del proceso)\n");
+    printf("      --lote-diario N    Tramas por bloque del diario (64 por defecto)\n");
+    printf("      --punto-cada N     Tramas entre puntos de control (100000 por defecto)\n");
+    printf("\n");
+    printf("Mensajes (un puerto o --reproducir):\n");
+    printf("      --mensajes ARCH    Separar el flujo en mensajes: cada trama FIN agrega el mensaje\n");
+    printf("                         en curso a ARCH (\"-\" = stdout), seguido de un salto de línea,\n");
+    printf("                         y reinicia el rotor. La memoria queda acotada por --ventana\n");
+    printf("      --ventana N        Caracteres del mensaje abierto retenidos en memoria; lo que\n");
+    printf("                         excede se escribe antes del FIN (1048576 por defecto)\n");
+    printf("      --fin TEXTO        Línea que cierra un mensaje (FIN por defecto; en binario, 0xA6)\n");
+    printf("\n");
+    printf("Pipeline (un puerto):\n");
+    printf("      --pipeline         Leer, decodificar y escribir en hilos separados\n");
+    printf("      --desborde MODO    Con colas llenas: bloquear (por defecto) o descartar\n");
+    printf("      --capacidad-cola N Elementos por cola del pipeline (4096 por defecto)\n");
+    printf("\n");
+    printf("Decodificación fuera de línea:\n");
+    printf("  -d, --decodificar ARCH Decodificar una captura grabada en paralelo (sin puerto)\n");
+    printf("  -o, --destino ARCH     Archivo del mensaje decodificado (stdout por defecto)\n");
+    printf("      --hilos N          Hilos de trabajo (uno por núcleo por defecto)\n");
+    printf("  -r, --reproducir ARCH  Reproducir una captura en lugar de leer el puerto\n");
+    printf("                         (secuencial; admite --pipeline)\n");
+    printf("\n");
+    printf("  -h, --ayuda            Mostrar esta ayuda\n");
+}
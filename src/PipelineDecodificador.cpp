@@ -0,0 +1,306 @@
+/**
+ * @file PipelineDecodificador.cpp
+ * @brief Implementación del pipeline de tres hilos
+ */
+
+#include "PipelineDecodificador.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "Metricas.h"
+#include "PuntoDeControl.h"
+#include "SumideroDeMensajes.h"
+#include "ControlDeParada.h"
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+PipelineDecodificador::PipelineDecodificador(FuenteDeLineas* fuenteLineas, ListaDeCarga* cargaDestino,
+                                             RotorDeMapeo* rotorFlujo, int capacidadCola,
+                                             PoliticaDesborde politicaDesborde)
+    : fuente(fuenteLineas),
+      carga(cargaDestino),
+      rotor(rotorFlujo),
+      politica(politicaDesborde),
+      latencias(nullptr),
+      puntoDeControl(nullptr),
+      sumidero(nullptr),
+      bitacora(nullptr),
+      inactividadMs(INACTIVIDAD_DEFECTO_MS),
+      desatendido(false),
+      colaLineas(capacidadCola),
+      colaSalida(capacidadCola),
+      desborde(new char[TAM_DESBORDE_PIPELINE]),
+      tamDesborde(TAM_DESBORDE_PIPELINE),
+      desbordeEscrito(0),
+      desbordeLiberado(0),
+      tramasProcesadas(0),
+      tramasInvalidas(0),
+      lineasDescartadas(0),
+      lineasLargas(0),
+      crecimientosDesborde(0),
+      caracteresDescartados(0),
+      profundidadMaximaLineas(0),
+      profundidadMaximaSalida(0) {
+}
+
+PipelineDecodificador::~PipelineDecodificador() {
+    delete[] desborde;
+}
+
+char* PipelineDecodificador::reservarDesborde(int bytes, size_t* fin) {
+    size_t n = static_cast<size_t>(bytes);
+    int intentos = 0;
+    
+    if (n > tamDesborde) {
+        // Ninguna línea del anillo sigue en uso cuando está vacío
+        while (desbordeLiberado.load(std::memory_order_acquire) != desbordeEscrito) {
+            esperarCola(intentos);
+        }
+        while (tamDesborde < n) {
+            tamDesborde *= 2;
+        }
+        delete[] desborde;
+        desborde = new char[tamDesborde];
+        crecimientosDesborde++;
+    }
+    
+    while (true) {
+        size_t posicion = desbordeEscrito % tamDesborde;
+        size_t salto = posicion + n > tamDesborde ? tamDesborde - posicion : 0;
+        size_t nuevoFin = desbordeEscrito + salto + n;
+        
+        if (nuevoFin - desbordeLiberado.load(std::memory_order_acquire) <= tamDesborde) {
+            desbordeEscrito = nuevoFin;
+            *fin = nuevoFin;
+            return desborde + (salto ? 0 : posicion);
+        }
+        if (politica != DESBORDE_BLOQUEAR) {
+            return nullptr;
+        }
+        esperarCola(intentos);
+    }
+}
+
+void PipelineDecodificador::hiloLector() {
+    VistaLinea linea;
+    PlazoDeInactividad plazo(inactividadMs);
+    
+    while (true) {
+        if (ControlDeParada::solicitada()) {
+            fprintf(desatendido ? stderr : stdout, "\nSeñal %d recibida. Finalizando...\n",
+                    ControlDeParada::obtenerSenal());
+            break;
+        }
+        
+        int bytesLeidos = fuente->leerLineaVista(linea);
+        
+        if (bytesLeidos < 0) {
+            if (!fuente->finDeFlujo()) {
+                printf("Error al leer del puerto serial\n");
+            }
+            break;
+        }
+        
+        if (bytesLeidos == 0) {
+            if (plazo.vencido()) {
+                break;
+            }
+        } else {
+            plazo.datos(linea.llegadaNs);
+        }
+        
+        // Reservar un hueco en la cola según la política de desborde
+        LineaPipeline* hueco = colaLineas.reservar();
+        int intentos = 0;
+        while (!hueco && politica == DESBORDE_BLOQUEAR) {
+            esperarCola(intentos);
+            hueco = colaLineas.reservar();
+        }
+        
+        if (!hueco) {
+            lineasDescartadas++;
+            Metricas::sumar(CONTADOR_LINEAS_DESCARTADAS);
+            continue;
+        }
+        
+        hueco->longitud = bytesLeidos;
+        hueco->llegadaNs = linea.llegadaNs;
+        if (bytesLeidos > TAM_LINEA_PIPELINE) {
+            // Línea larga: al anillo de desborde (la libera el decodificador)
+            char* copia = reservarDesborde(bytesLeidos, &hueco->finLarga);
+            if (!copia) {
+                lineasDescartadas++;
+                Metricas::sumar(CONTADOR_LINEAS_DESCARTADAS);
+                continue;
+            }
+            memcpy(copia, linea.datos, bytesLeidos);
+            hueco->larga = copia;
+            lineasLargas++;
+        } else {
+            hueco->larga = nullptr;
+            memcpy(hueco->datos, linea.datos, bytesLeidos);
+        }
+        colaLineas.publicar();
+        
+        size_t profundidad = colaLineas.profundidad();
+        Metricas::fijar(INDICADOR_COLA_LINEAS, static_cast<long long>(profundidad));
+        if (profundidad > profundidadMaximaLineas) {
+            profundidadMaximaLineas = profundidad;
+        }
+    }
+    
+    colaLineas.cerrar();
+}
+
+void PipelineDecodificador::emitirNuevos(long long* emitidos) {
+    // 'emitidos' es absoluto: el principio de la lista puede haberse descartado
+    int posicion = static_cast<int>(*emitidos - carga->obtenerDescartados());
+    
+    while (posicion < carga->obtenerTamanio()) {
+        FragmentoSalida* fragmento = colaSalida.reservar();
+        int intentos = 0;
+        while (!fragmento && politica == DESBORDE_BLOQUEAR) {
+            esperarCola(intentos);
+            fragmento = colaSalida.reservar();
+        }
+        
+        if (!fragmento) {
+            // Salida lenta: contar lo que no se escribirá (el mensaje completo
+            // sigue disponible en la lista de carga)
+            caracteresDescartados += carga->obtenerTamanio() - posicion;
+            posicion = carga->obtenerTamanio();
+            break;
+        }
+        
+        fragmento->longitud = carga->copiarDesde(posicion, fragmento->datos, TAM_FRAGMENTO_SALIDA);
+        posicion += fragmento->longitud;
+        colaSalida.publicar();
+        
+        size_t profundidad = colaSalida.profundidad();
+        Metricas::fijar(INDICADOR_COLA_SALIDA, static_cast<long long>(profundidad));
+        if (profundidad > profundidadMaximaSalida) {
+            profundidadMaximaSalida = profundidad;
+        }
+    }
+    
+    *emitidos = carga->obtenerDescartados() + posicion;
+}
+
+void PipelineDecodificador::hiloDecodificador() {
+    RegistroDeTramas registro;
+    registro.establecerAdvertencias(false);  // stdout es del hilo de salida: las inválidas solo se cuentan
+    ProcesadorDeTramas procesador(carga, rotor, &registro, false);
+    procesador.establecerLatencias(latencias);
+    procesador.establecerPuntoDeControl(puntoDeControl);
+    procesador.establecerBitacora(bitacora);
+    if (sumidero) {
+        registro.establecerDelimitador(sumidero->obtenerDelimitador());
+        procesador.establecerSumidero(sumidero);
+    }
+    long long emitidos = carga->obtenerDescartados() + carga->obtenerTamanio();
+    
+    while (true) {
+        LineaPipeline* linea = colaLineas.frente();
+        
+        if (!linea) {
+            // Cola vacía: decodificar la racha pendiente y enviarla a la salida
+            procesador.vaciarPendientes();
+            emitirNuevos(&emitidos);
+            procesador.salidaEmitida();
+            if (puntoDeControl) {
+                puntoDeControl->escribirPendientes();
+            }
+            
+            if (colaLineas.estaCerrada() && !colaLineas.frente()) {
+                break;
+            }
+            colaLineas.esperarElementos();
+            continue;
+        }
+        
+        if (linea->longitud == 0) {
+            procesador.vaciarPendientes();
+            procesador.anotarPausa();
+        } else if (linea->larga) {
+            procesador.procesarLinea(linea->larga, linea->longitud, linea->llegadaNs);
+            desbordeLiberado.store(linea->finLarga, std::memory_order_release);
+        } else {
+            procesador.procesarLinea(linea->datos, linea->longitud, linea->llegadaNs);
+        }
+        colaLineas.liberar();
+        
+        // Con la cola siempre llena no se llega al caso de cola vacía:
+        // emitir antes de que se acumulen más tramas sin medir, y antes de
+        // que la trama siguiente descarte lo que el sumidero ya recibió
+        if (procesador.salidaPendienteLlena() || procesador.hayDescartePendiente()) {
+            procesador.vaciarPendientes();
+            emitirNuevos(&emitidos);
+            procesador.salidaEmitida();
+        }
+    }
+    
+    procesador.vaciarPendientes();
+    emitirNuevos(&emitidos);
+    procesador.salidaEmitida();
+    procesador.anotarFinDeFlujo();
+    colaSalida.cerrar();
+    
+    tramasProcesadas = procesador.obtenerTramasProcesadas();
+    tramasInvalidas = procesador.obtenerTramasInvalidas();
+}
+
+void PipelineDecodificador::hiloSalida() {
+    while (true) {
+        FragmentoSalida* fragmento = colaSalida.frente();
+        
+        if (!fragmento) {
+            // Nada pendiente: entregar lo escrito antes de esperar
+            fflush(stdout);
+            if (colaSalida.estaCerrada() && !colaSalida.frente()) {
+                break;
+            }
+            colaSalida.esperarElementos();
+            continue;
+        }
+        
+        fwrite(fragmento->datos, 1, fragmento->longitud, stdout);
+        colaSalida.liberar();
+    }
+    
+    printf("\n");
+    fflush(stdout);
+}
+
+int PipelineDecodificador::ejecutar() {
+    if (!desatendido) {
+        printf("\nEsperando tramas (pipeline de 3 hilos, colas de %d elementos, desborde: %s)...\n",
+               static_cast<int>(colaLineas.capacidad()),
+               politica == DESBORDE_BLOQUEAR ? "bloquear" : "descartar");
+        printf("Mensaje decodificado: ");
+        fflush(stdout);
+    }
+    
+    std::thread salida(&PipelineDecodificador::hiloSalida, this);
+    std::thread decodificador(&PipelineDecodificador::hiloDecodificador, this);
+    std::thread lector(&PipelineDecodificador::hiloLector, this);
+    
+    lector.join();
+    decodificador.join();
+    salida.join();
+    
+    return tramasProcesadas;
+}
+
+void PipelineDecodificador::imprimirEstadisticas() const {
+    printf("  - Tramas inválidas: %d\n", tramasInvalidas);
+    printf("  - Líneas descartadas (cola llena): %ld\n", lineasDescartadas);
+    printf("  - Líneas largas (por el anillo de desborde): %ld", lineasLargas);
+    if (crecimientosDesborde > 0) {
+        printf(" (anillo agrandado a %d KiB)", static_cast<int>(tamDesborde / 1024));
+    }
+    printf("\n");
+    printf("  - Caracteres de salida descartados: %ld\n", caracteresDescartados);
+    printf("  - Ocupación máxima de colas: líneas %d/%d, salida %d/%d\n",
+           static_cast<int>(profundidadMaximaLineas), static_cast<int>(colaLineas.capacidad()),
+           static_cast<int>(profundidadMaximaSalida), static_cast<int>(colaSalida.capacidad()));
+}
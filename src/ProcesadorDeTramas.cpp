@@ -0,0 +1,214 @@
+/**
+ * @file ProcesadorDeTramas.cpp
+ * @brief Implementación del procesador de tramas
+ */
+
+#include "ProcesadorDeTramas.h"
+#include "Metricas.h"
+#include "PuntoDeControl.h"
+#include "SumideroDeMensajes.h"
+#include <cstdio>
+
+ProcesadorDeTramas::ProcesadorDeTramas(ListaDeCarga* cargaDestino, RotorDeMapeo* rotorFlujo,
+                                       const RegistroDeTramas* registroTramas, bool modoDetallado)
+    : carga(cargaDestino),
+      rotor(rotorFlujo),
+      registro(registroTramas),
+      detallado(modoDetallado),
+      tramasProcesadas(0),
+      tramasInvalidas(0),
+      latencias(nullptr),
+      llegadasLote(nullptr),
+      pendientesSalida(nullptr),
+      numPendientesSalida(0),
+      puntoDeControl(nullptr),
+      sumidero(nullptr),
+      entregados(0),
+      bitacora(nullptr),
+      nivelBitacora(BITACORA_APAGADA),
+      flujoBitacora(0) {
+}
+
+ProcesadorDeTramas::~ProcesadorDeTramas() {
+    delete[] llegadasLote;
+    delete[] pendientesSalida;
+}
+
+void ProcesadorDeTramas::establecerLatencias(LatenciasDeTramas* destino) {
+    latencias = destino;
+    if (latencias && !llegadasLote) {
+        llegadasLote = new long long[CAPACIDAD_LOTE];
+        pendientesSalida = new LatenciaPendiente[CAPACIDAD_PENDIENTES_SALIDA];
+    }
+    numPendientesSalida = 0;
+}
+
+void ProcesadorDeTramas::anotarAplicada(long long llegada, TipoLatencia tipo, long long ahora) {
+    latencias->registrar(ETAPA_DECODIFICACION, tipo, ahora - llegada);
+    
+    // Sin hueco (el llamador no emitió la salida a tiempo): cerrar aquí lo acumulado
+    if (numPendientesSalida == CAPACIDAD_PENDIENTES_SALIDA) {
+        salidaEmitida();
+    }
+    
+    LatenciaPendiente& pendiente = pendientesSalida[numPendientesSalida++];
+    pendiente.llegada = llegada;
+    pendiente.aplicada = ahora;
+    pendiente.tipo = tipo;
+}
+
+void ProcesadorDeTramas::salidaEmitida() {
+    descartarEntregados();
+    
+    if (!latencias) return;
+    
+    long long ahora = relojNs();
+    for (int i = 0; i < numPendientesSalida; ++i) {
+        const LatenciaPendiente& pendiente = pendientesSalida[i];
+        latencias->registrar(ETAPA_SALIDA, pendiente.tipo, ahora - pendiente.aplicada);
+        latencias->registrar(ETAPA_TOTAL, pendiente.tipo, ahora - pendiente.llegada);
+    }
+    numPendientesSalida = 0;
+    
+    if (LatenciasDeTramas::tomarSolicitudInforme()) {
+        latencias->imprimir(stderr);
+    }
+}
+
+void ProcesadorDeTramas::vaciarPendientes() {
+    if (lote.estaVacio()) return;
+    
+    int n = lote.vaciar(carga, rotor);
+    if (latencias) {
+        // Los caracteres del lote llegan a la lista todos a la vez
+        long long ahora = relojNs();
+        for (int i = 0; i < n; ++i) {
+            anotarAplicada(llegadasLote[i], LATENCIA_LOAD, ahora);
+        }
+    }
+    if (nivelBitacora >= BITACORA_DEPURACION) {
+        bitacora->anotar(EVENTO_LOTE, flujoBitacora, n, 0);
+    }
+    if (detallado) {
+        printf("Lote de %d carácter(es) decodificado. Mensaje parcial: ", n);
+        carga->imprimirMensaje();
+    }
+}
+
+void ProcesadorDeTramas::cerrarMensaje() {
+    sumidero->cerrarMensaje(*carga, entregados);
+    entregados = carga->obtenerTamanio();
+    if (nivelBitacora >= BITACORA_RESUMEN) {
+        bitacora->anotar(EVENTO_MENSAJE, flujoBitacora, static_cast<int>(sumidero->obtenerMensajesCerrados()), 0);
+    }
+    
+    // Cada mensaje se decodifica desde la posición inicial del rotor
+    rotor->reiniciar();
+    Metricas::fijar(INDICADOR_DESPLAZAMIENTO_ROTOR, rotor->obtenerDesplazamiento());
+}
+
+void ProcesadorDeTramas::procesarLinea(const char* linea, int longitud, long long llegadaNs) {
+    char representacion[32];  // Texto de la trama para el registro
+    
+    descartarEntregados();
+    
+    if (latencias && llegadaNs == 0) {
+        llegadaNs = relojNs();
+    }
+    
+    // Parsear la trama
+    arena.reiniciar();
+    TramaBase* trama = registro->parsear(linea, longitud, &arena);
+    
+    if (!trama) {
+        tramasInvalidas++;
+        if (nivelBitacora >= BITACORA_TRAMA) {
+            bitacora->anotar(EVENTO_INVALIDA, flujoBitacora, 0, longitud, linea, longitud, '\0', llegadaNs);
+        }
+        if (detallado) {
+            printf("Trama inválida: [%.*s]\n", longitud, linea);
+        }
+        return;
+    }
+    
+    if (lote.estaLleno()) {
+        vaciarPendientes();
+    }
+    
+    if (trama->acumularEnLote(&lote)) {
+        Metricas::sumar(CONTADOR_TRAMAS_LOAD);
+        if (latencias) {
+            llegadasLote[lote.obtenerCantidad() - 1] = llegadaNs;
+        }
+        
+        // Entre dos MAP la rotación es constante: la racha de LOAD se
+        // decodifica por bloques
+        if (nivelBitacora >= BITACORA_TRAMA) {
+            bitacora->anotar(EVENTO_CARGA, flujoBitacora, lote.obtenerCantidad(), longitud, linea, longitud,
+                             '\0', llegadaNs);
+        }
+        if (detallado) {
+            printf("Trama recibida: [%s] -> Procesando... -> Carácter en lote (%d pendiente(s))\n",
+                   trama->obtenerRepresentacion(representacion, sizeof(representacion)),
+                   lote.obtenerCantidad());
+        }
+    } 
+    else {
+        // Cualquier otra trama puede cambiar el rotor: decodificar antes
+        // lo pendiente con la rotación vigente
+        vaciarPendientes();
+        
+        if (detallado) {
+            printf("Trama recibida: [%s] -> Procesando... ",
+                   trama->obtenerRepresentacion(representacion, sizeof(representacion)));
+        }
+        trama->procesar(carga, rotor);
+        if (nivelBitacora >= BITACORA_TRAMA) {
+            bitacora->anotar(EVENTO_TRAMA, flujoBitacora, rotor->obtenerDesplazamiento(), longitud,
+                             linea, longitud, rotor->obtenerCabeza(), llegadaNs);
+        }
+        
+        bool cierra = trama->cierraMensaje();
+        if (cierra && sumidero) {
+            cerrarMensaje();
+        }
+        
+        // El delimitador puede empezar por cualquier letra: no clasificarlo por ella
+        TipoLatencia tipo = cierra ? LATENCIA_OTRA : clasificarTrama(static_cast<unsigned char>(linea[0]));
+        Metricas::sumar(tipo == LATENCIA_MAP ? CONTADOR_TRAMAS_MAP
+                        : tipo == LATENCIA_BULK ? CONTADOR_TRAMAS_BULK
+                        : tipo == LATENCIA_LOAD ? CONTADOR_TRAMAS_LOAD : CONTADOR_TRAMAS_OTRAS);
+        if (tipo == LATENCIA_MAP) {
+            Metricas::fijar(INDICADOR_DESPLAZAMIENTO_ROTOR, rotor->obtenerDesplazamiento());
+        }
+        if (latencias) {
+            anotarAplicada(llegadaNs, tipo, relojNs());
+        }
+        if (detallado) {
+            trama->imprimirResultado(carga, rotor);
+        }
+    }
+    tramasProcesadas++;
+    
+    // Destruir la trama (su memoria se reutiliza en la siguiente línea)
+    arena.destruir(trama);
+    
+    // Mensaje abierto más largo que la ventana: entregar lo decodificado
+    if (sumidero && carga->obtenerTamanio() + lote.obtenerCantidad() - entregados > sumidero->obtenerVentana()) {
+        vaciarPendientes();
+        if (nivelBitacora >= BITACORA_DEPURACION) {
+            bitacora->anotar(EVENTO_VOLCADO, flujoBitacora, carga->obtenerTamanio() - entregados, 0);
+        }
+        sumidero->volcar(*carga, entregados);
+        entregados = carga->obtenerTamanio();
+    }
+    
+    if (puntoDeControl && puntoDeControl->anotar(linea, longitud)) {
+        // El punto de control guarda la lista: sin caracteres en el lote
+        vaciarPendientes();
+        bool guardado = puntoDeControl->guardar(*carga, *rotor, entregados);
+        if (nivelBitacora >= BITACORA_DEPURACION) {
+            bitacora->anotar(EVENTO_PUNTO, flujoBitacora, guardado ? 1 : 0, tramasProcesadas);
+        }
+    }
+}
@@ -0,0 +1,403 @@
+/**
+ * @file PuntoDeControl.cpp
+ * @brief Implementación de los puntos de control
+ */
+
+#include "PuntoDeControl.h"
+#include "ListaDeCarga.h"
+#include "RotorDeMapeo.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
+#include "SumideroDeMensajes.h"
+#include "HistogramaLatencia.h"  // Para relojNs()
+#include <cstdio>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define open _open
+    #define close _close
+    #define read _read
+    #define lseek _lseeki64
+#else
+    #include <unistd.h>
+    #define O_BINARY 0
+#endif
+
+/// Versión del formato del registro
+const unsigned int VERSION_PUNTO_DE_CONTROL = 2;
+
+/// Caracteres del mensaje que se copian por escritura o lectura
+const int BLOQUE_COPIA_CARGA = 16 * 1024;
+
+static const char MAGIA_PUNTO_DE_CONTROL[8] = {'P', 'R', 'T', '7', 'P', 'C', 'T', 'L'};
+
+/**
+ * @struct RegistroPuntoDeControl
+ * @brief Contenido de BASE.ckpt (enteros en el orden de bytes de la máquina)
+ */
+struct RegistroPuntoDeControl {
+    char magia[8];
+    unsigned int version;
+    unsigned int alfabeto;
+    unsigned int numRotores;
+    unsigned int seleccionado;
+    int posiciones[MAX_ROTORES_CASCADA];
+    unsigned int huellaConfiguracion;
+    unsigned int ranura;              ///< Ranura del mensaje (BASE.carga.0 o BASE.carga.1)
+    unsigned long long generacion;
+    long long posicionMensajes;       ///< Tamaño del archivo de mensajes (-1 sin archivo)
+    unsigned long long caracteres;    ///< Longitud del mensaje
+    unsigned long long tramas;        ///< Tramas aplicadas en total
+    unsigned int suma;                ///< FNV-1a de todos los campos anteriores
+    unsigned int relleno;
+};
+
+namespace {
+
+/**
+ * @brief Concatena la base y un sufijo en una cadena nueva (liberar con delete[])
+ */
+char* componerRuta(const char* base, const char* sufijo) {
+    size_t largoBase = strlen(base);
+    size_t largoSufijo = strlen(sufijo);
+    char* ruta = new char[largoBase + largoSufijo + 1];
+    memcpy(ruta, base, largoBase);
+    memcpy(ruta + largoBase, sufijo, largoSufijo + 1);
+    return ruta;
+}
+
+/**
+ * @brief Directorio de una ruta ("." si no tiene) en una cadena nueva
+ */
+char* directorioDe(const char* ruta) {
+    const char* barra = strrchr(ruta, '/');
+    if (!barra) return componerRuta(".", "");
+
+    size_t largo = barra == ruta ? 1 : static_cast<size_t>(barra - ruta);
+    char* directorio = new char[largo + 1];
+    memcpy(directorio, ruta, largo);
+    directorio[largo] = '\0';
+    return directorio;
+}
+
+/**
+ * @brief Suma del registro, sin contar el propio campo de la suma
+ */
+unsigned int sumaDeRegistro(const RegistroPuntoDeControl& registro) {
+    return sumaFnv(&registro, offsetof(RegistroPuntoDeControl, suma));
+}
+
+} // namespace
+
+PuntoDeControl::PuntoDeControl(const char* base, TipoAlfabeto tipoAlfabeto, const char* rotores,
+                               PoliticaSincronizacion politica, int tramasLote, int tramasEntrePuntos)
+    : rutaPunto(componerRuta(base, ".ckpt")),
+      rutaTemporal(componerRuta(base, ".ckpt.tmp")),
+      rutaDiario(componerRuta(base, ".diario")),
+      directorio(directorioDe(base)),
+      diario(politica, tramasLote),
+      descriptorCarga(-1),
+      ranura(0),
+      alfabeto(tipoAlfabeto),
+      huellaConfiguracion(rotores ? sumaFnv(rotores, strlen(rotores)) : 0),
+      sumidero(nullptr),
+      generacion(0),
+      inicioMensaje(0),
+      caracteresGuardados(0),
+      tramasGuardadas(0),
+      tramasPorPunto(tramasEntrePuntos < 1 ? 1 : tramasEntrePuntos),
+      tramasDiario(0),
+      proximoPunto(tramasPorPunto) {
+    rutasCarga[0] = componerRuta(base, ".carga.0");
+    rutasCarga[1] = componerRuta(base, ".carga.1");
+}
+
+PuntoDeControl::~PuntoDeControl() {
+    if (descriptorCarga >= 0) {
+        close(descriptorCarga);
+    }
+    delete[] rutaPunto;
+    delete[] rutaTemporal;
+    delete[] rutasCarga[0];
+    delete[] rutasCarga[1];
+    delete[] rutaDiario;
+    delete[] directorio;
+}
+
+void PuntoDeControl::establecerSegmentacion(SumideroDeMensajes* destino) {
+    sumidero = destino;
+    if (!sumidero) return;
+
+    // Otro delimitador u otra ventana cortarían el diario en otros mensajes
+    const char* delimitador = sumidero->obtenerDelimitador();
+    int ventana = sumidero->obtenerVentana();
+    huellaConfiguracion = sumaFnv(delimitador, strlen(delimitador), huellaConfiguracion);
+    huellaConfiguracion = sumaFnv(&ventana, sizeof(ventana), huellaConfiguracion);
+}
+
+int PuntoDeControl::abrirRanura(int indice, bool vaciar) {
+    int descriptor = open(rutasCarga[indice], O_RDWR | O_CREAT | O_APPEND | O_BINARY | (vaciar ? O_TRUNC : 0), 0644);
+    if (descriptor < 0) {
+        fprintf(stderr, "Error: No se pudo abrir %s: %s\n", rutasCarga[indice], strerror(errno));
+    }
+    return descriptor;
+}
+
+bool PuntoDeControl::guardarCarga(int descriptor, const char* ruta, const ListaDeCarga& carga, int desde) {
+    if (desde < carga.obtenerTamanio()) {
+        // Retroceder una sola vez hasta el primer carácter nuevo (copiarDesde()
+        // lo haría en cada bloque) y recorrer los nodos hacia adelante
+        char buffer[BLOQUE_COPIA_CARGA];
+        int usados = 0;
+        int desplazamiento;
+        const NodoCarga* nodo = carga.buscarDesdeCola(desde, &desplazamiento);
+        for (; nodo; nodo = nodo->siguiente, desplazamiento = 0) {
+            int n = nodo->cantidad - desplazamiento;
+            if (usados + n > BLOQUE_COPIA_CARGA) {
+                if (!escribirCompleto(descriptor, buffer, usados)) break;
+                usados = 0;
+            }
+            memcpy(buffer + usados, nodo->datos + desplazamiento, n);
+            usados += n;
+        }
+        if (nodo || !escribirCompleto(descriptor, buffer, usados)) {
+            fprintf(stderr, "Error: No se pudo escribir %s: %s\n", ruta, strerror(errno));
+            return false;
+        }
+    }
+
+    if (!sincronizarDescriptor(descriptor)) {
+        fprintf(stderr, "Error: No se pudo sincronizar %s: %s\n", ruta, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool PuntoDeControl::escribirRegistro(const RotorDeMapeo& rotor, int ranuraMensaje, long long caracteres,
+                                      long long posicionMensajes) {
+    RegistroPuntoDeControl registro;
+    memset(&registro, 0, sizeof(registro));
+
+    memcpy(registro.magia, MAGIA_PUNTO_DE_CONTROL, 8);
+    registro.version = VERSION_PUNTO_DE_CONTROL;
+    registro.alfabeto = static_cast<unsigned int>(alfabeto);
+    registro.numRotores = static_cast<unsigned int>(rotor.obtenerNumeroRotores());
+    registro.seleccionado = static_cast<unsigned int>(rotor.obtenerRotorSeleccionado());
+    for (int r = 0; r < rotor.obtenerNumeroRotores(); ++r) {
+        registro.posiciones[r] = rotor.obtenerPosicionRotor(r);
+    }
+    registro.huellaConfiguracion = huellaConfiguracion;
+    registro.ranura = static_cast<unsigned int>(ranuraMensaje);
+    registro.generacion = generacion + 1;
+    registro.posicionMensajes = posicionMensajes;
+    registro.caracteres = static_cast<unsigned long long>(caracteres);
+    registro.tramas = static_cast<unsigned long long>(tramasGuardadas + tramasDiario);
+    registro.suma = sumaDeRegistro(registro);
+    int salida = open(rutaTemporal, O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (salida < 0) {
+        fprintf(stderr, "Error: No se pudo crear %s: %s\n", rutaTemporal, strerror(errno));
+        return false;
+    }
+    bool escrito = escribirCompleto(salida, &registro, sizeof(registro)) && sincronizarDescriptor(salida);
+    close(salida);
+    if (!escrito) {
+        fprintf(stderr, "Error: No se pudo escribir %s: %s\n", rutaTemporal, strerror(errno));
+        return false;
+    }
+
+#ifdef _WIN32
+    // rename() de Windows no reemplaza un archivo existente
+    remove(rutaPunto);
+#endif
+    if (rename(rutaTemporal, rutaPunto) != 0) {
+        fprintf(stderr, "Error: No se pudo reemplazar %s: %s\n", rutaPunto, strerror(errno));
+        return false;
+    }
+
+#ifndef _WIN32
+    // El rename() solo es definitivo cuando el directorio llega al disco
+    int descriptorDirectorio = open(directorio, O_RDONLY);
+    if (descriptorDirectorio >= 0) {
+        fsync(descriptorDirectorio);
+        close(descriptorDirectorio);
+    }
+#endif
+
+    generacion = registro.generacion;
+    tramasGuardadas = static_cast<long long>(registro.tramas);
+    tramasDiario = 0;
+    proximoPunto = tramasPorPunto;
+    return true;
+}
+
+bool PuntoDeControl::guardarEstado(const ListaDeCarga& carga, const RotorDeMapeo& rotor, int entregados) {
+    long long inicio = carga.obtenerDescartados() + entregados;
+    int ranuraNueva = ranura;
+    int descriptor = descriptorCarga;
+    int desde;
+
+    if (inicio == inicioMensaje) {
+        // El mismo mensaje, quizá más largo: anexar lo nuevo a la ranura vigente
+        desde = entregados + static_cast<int>(caracteresGuardados);
+        if (static_cast<long long>(lseek(descriptor, 0, SEEK_END)) != caracteresGuardados) {
+            // Restos de una escritura anterior fallida
+            truncarDescriptor(descriptor, caracteresGuardados);
+        }
+    } else {
+        // El principio se entregó al sumidero: lo pendiente va entero a la
+        // otra ranura; la vigente sigue valiendo hasta publicar el registro
+        ranuraNueva = 1 - ranura;
+        descriptor = abrirRanura(ranuraNueva, true);
+        desde = entregados;
+    }
+
+    // Lo entregado debe estar en el archivo de mensajes antes de darlo por entregado
+    long long posicionMensajes = sumidero ? sumidero->obtenerPosicion() : -1;
+    long long caracteres = carga.obtenerTamanio() - entregados;
+    bool guardado = descriptor >= 0 &&
+                    guardarCarga(descriptor, rutasCarga[ranuraNueva], carga, desde) &&
+                    escribirRegistro(rotor, ranuraNueva, caracteres, posicionMensajes);
+
+    if (ranuraNueva != ranura && descriptor >= 0) {
+        if (guardado) {
+            close(descriptorCarga);
+            descriptorCarga = descriptor;
+            ranura = ranuraNueva;
+        } else {
+            close(descriptor);
+        }
+    }
+    if (!guardado) return false;
+
+    inicioMensaje = inicio;
+    caracteresGuardados = caracteres;
+    return true;
+}
+
+bool PuntoDeControl::guardar(const ListaDeCarga& carga, const RotorDeMapeo& rotor, int entregados) {
+    if (!guardarEstado(carga, rotor, entregados)) {
+        // El punto de control anterior y el diario siguen valiendo: reintentar más adelante
+        proximoPunto = tramasDiario + tramasPorPunto;
+        return false;
+    }
+    return diario.reiniciar(generacion);
+}
+
+bool PuntoDeControl::recuperar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    long long inicio = relojNs();
+
+    RegistroPuntoDeControl registro;
+    bool hayRegistro = false;
+    int entrada = open(rutaPunto, O_RDONLY | O_BINARY);
+    if (entrada >= 0) {
+        long leidos = static_cast<long>(read(entrada, &registro, sizeof(registro)));
+        close(entrada);
+
+        if (leidos != static_cast<long>(sizeof(registro)) ||
+            memcmp(registro.magia, MAGIA_PUNTO_DE_CONTROL, 8) != 0 ||
+            registro.version != VERSION_PUNTO_DE_CONTROL ||
+            registro.suma != sumaDeRegistro(registro) || registro.ranura > 1) {
+            fprintf(stderr, "Error: El punto de control %s está dañado\n", rutaPunto);
+            return false;
+        }
+        if (registro.alfabeto != static_cast<unsigned int>(alfabeto) ||
+            registro.huellaConfiguracion != huellaConfiguracion ||
+            registro.numRotores != static_cast<unsigned int>(rotor->obtenerNumeroRotores())) {
+            fprintf(stderr, "Error: El punto de control %s se guardó con otro alfabeto, cascada de rotores "
+                    "o separación de mensajes\n", rutaPunto);
+            return false;
+        }
+        hayRegistro = true;
+    } else if (errno != ENOENT) {
+        fprintf(stderr, "Error: No se pudo abrir %s: %s\n", rutaPunto, strerror(errno));
+        return false;
+    }
+
+    if (hayRegistro) {
+        generacion = registro.generacion;
+        ranura = static_cast<int>(registro.ranura);
+        caracteresGuardados = static_cast<long long>(registro.caracteres);
+        tramasGuardadas = static_cast<long long>(registro.tramas);
+
+        if (!rotor->establecerEstado(registro.posiciones, static_cast<int>(registro.numRotores),
+                                     static_cast<int>(registro.seleccionado))) {
+            fprintf(stderr, "Error: El punto de control %s está dañado\n", rutaPunto);
+            return false;
+        }
+
+        // Lo escrito en el archivo de mensajes después del punto de control
+        // lo volverá a escribir el diario
+        if (sumidero && registro.posicionMensajes >= 0 && !sumidero->recortar(registro.posicionMensajes)) {
+            return false;
+        }
+    }
+
+    descriptorCarga = abrirRanura(ranura, false);
+    if (descriptorCarga < 0) {
+        return false;
+    }
+
+    // Mensaje confirmado; lo que haya detrás no llegó a un punto de control
+    long long fin = static_cast<long long>(lseek(descriptorCarga, 0, SEEK_END));
+    if (fin < caracteresGuardados) {
+        fprintf(stderr, "Error: %s tiene %lld bytes y el punto de control espera %lld\n",
+                rutasCarga[ranura], fin, caracteresGuardados);
+        return false;
+    }
+    if (fin > caracteresGuardados) {
+        truncarDescriptor(descriptorCarga, caracteresGuardados);
+    }
+
+    char buffer[BLOQUE_COPIA_CARGA];
+    lseek(descriptorCarga, 0, SEEK_SET);
+    for (long long restantes = caracteresGuardados; restantes > 0; ) {
+        int pedir = restantes < BLOQUE_COPIA_CARGA ? static_cast<int>(restantes) : BLOQUE_COPIA_CARGA;
+        long n = static_cast<long>(read(descriptorCarga, buffer, pedir));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            fprintf(stderr, "Error: No se pudo leer %s\n", rutasCarga[ranura]);
+            return false;
+        }
+        carga->insertarBloque(buffer, static_cast<int>(n));
+        restantes -= n;
+    }
+    inicioMensaje = carga->obtenerDescartados();
+
+    // Reaplicar el diario sobre el estado del punto de control (y sobre el
+    // mismo sumidero, que vuelve a recibir los mensajes que el diario cierra)
+    RegistroDeTramas registroTramas;
+    registroTramas.establecerAdvertencias(false);
+    ProcesadorDeTramas procesador(carga, rotor, &registroTramas, false);
+    if (sumidero) {
+        registroTramas.establecerDelimitador(sumidero->obtenerDelimitador());
+        procesador.establecerSumidero(sumidero);
+    }
+    long long descartados = 0;
+    long long reaplicadas = DiarioDeTramas::reproducir(rutaDiario, generacion, &procesador, &descartados);
+    procesador.salidaEmitida();  // Quita de la lista lo entregado al sumidero
+
+    // Sin tramas nuevas el diario se puede vaciar con la misma generación;
+    // con ellas, antes hay que dejarlas en un punto de control
+    tramasDiario = reaplicadas;
+    if (reaplicadas > 0 && !guardarEstado(*carga, *rotor, 0)) {
+        return false;
+    }
+    if (!diario.abrir(rutaDiario, generacion)) {
+        return false;
+    }
+
+    if (hayRegistro || reaplicadas > 0) {
+        // En stderr, como los errores: stdout puede ser el flujo de mensajes
+        fprintf(stderr, "Estado recuperado de %s: %lld trama(s) del punto de control + %lld del diario, "
+                "%d carácter(es) (%.2f ms)\n",
+                rutaPunto, tramasGuardadas - reaplicadas, reaplicadas, carga->obtenerTamanio(),
+                (relojNs() - inicio) / 1e6);
+        if (descartados > 0) {
+            fprintf(stderr, "  - %lld byte(s) incompletos al final del diario descartados\n", descartados);
+        }
+    }
+    return true;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file RegistroDeTramas.cpp
+ * @brief Implementación del registro de tipos de trama
+ */
+
+#include "RegistroDeTramas.h"
+#include "TramaLoad.h"
+#include "TramaMap.h"
+#include "TramaBulk.h"
+#include "TramaSeleccion.h"
+#include "TramaRotor.h"
+#include "TramaFin.h"
+#include "FormatoBinario.h"
+#include "Metricas.h"
+#include <cstdio>   // Para printf
+#include <climits>  // Para INT_MAX
+#include <cstring>  // Para memchr, memcmp, strncpy
+
+namespace {
+
+/**
+ * @brief Cuenta como dato inválido una trama que su fábrica rechazó
+ * @return La misma trama (nullptr si fue rechazada)
+ */
+inline TramaBase* contarDatoInvalido(TramaBase* trama) {
+    if (!trama) {
+        Metricas::sumar(CONTADOR_INVALIDA_DATO);
+    }
+    return trama;
+}
+
+/**
+ * @brief Fábrica de tramas LOAD: L,X donde X es un carácter
+ */
+TramaBase* fabricarLoad(const char* dato, int longitud, ArenaDeTramas* arena) {
+    // parsear() ya rechazó las líneas de menos de 3 bytes; la advertencia,
+    // si se pide, la da el parser, no la fábrica
+    if (longitud < 1) {
+        return nullptr;
+    }
+    return arena->crear<TramaLoad>(dato[0]);
+}
+
+/**
+ * @brief Fábrica de tramas MAP: M,N donde N es un número entero
+ */
+TramaBase* fabricarMap(const char* dato, int longitud, ArenaDeTramas* arena) {
+    return arena->crear<TramaMap>(enteroDesdeTexto(dato, longitud));
+}
+
+/**
+ * @brief Fábrica de tramas BULK: B,TEXTO con varios caracteres de carga
+ */
+TramaBase* fabricarBulk(const char* dato, int longitud, ArenaDeTramas* arena) {
+    if (longitud < 1) {
+        return nullptr;
+    }
+    return arena->crear<TramaBulk>(dato, longitud);
+}
+
+/**
+ * @brief Indica si un índice de rotor puede existir en una cascada
+ */
+inline bool esIndiceDeRotor(long long indice) {
+    return indice >= 0 && indice < MAX_ROTORES_CASCADA;
+}
+
+/**
+ * @brief Fábrica de tramas SELECT: S,I donde I es el índice del rotor
+ */
+TramaBase* fabricarSeleccion(const char* dato, int longitud, ArenaDeTramas* arena) {
+    int indice = enteroDesdeTexto(dato, longitud);
+    if (!esIndiceDeRotor(indice)) {
+        return nullptr;
+    }
+    return arena->crear<TramaSeleccion>(indice);
+}
+
+/**
+ * @brief Fábrica de tramas ROTOR: R,I,N con el índice del rotor y la rotación
+ */
+TramaBase* fabricarRotor(const char* dato, int longitud, ArenaDeTramas* arena) {
+    const char* coma = static_cast<const char*>(memchr(dato, ',', longitud));
+    if (!coma) {
+        return nullptr;
+    }
+    
+    int longitudIndice = static_cast<int>(coma - dato);
+    int indice = enteroDesdeTexto(dato, longitudIndice);
+    if (!esIndiceDeRotor(indice)) {
+        return nullptr;
+    }
+    return arena->crear<TramaRotor>(indice, enteroDesdeTexto(coma + 1, longitud - longitudIndice - 1));
+}
+
+/**
+ * @brief Fábrica de tramas LOAD binarias: 0xA1 C
+ */
+TramaBase* fabricarLoadBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    if (longitud != 1) {
+        return nullptr;
+    }
+    return arena->crear<TramaLoad>(dato[0]);
+}
+
+/**
+ * @brief Fábrica de tramas MAP binarias: 0xA2 seguido de un varint zigzag
+ */
+TramaBase* fabricarMapBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    unsigned int valor;
+    int usados = leerVarint(reinterpret_cast<const unsigned char*>(dato), longitud, &valor);
+    if (usados <= 0 || usados != longitud) {
+        return nullptr;
+    }
+    return arena->crear<TramaMap>(decodificarZigzag(valor));
+}
+
+/**
+ * @brief Fábrica de tramas BULK binarias: 0xA3, longitud varint y carga
+ */
+TramaBase* fabricarBulkBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    unsigned int n;
+    int usados = leerVarint(reinterpret_cast<const unsigned char*>(dato), longitud, &n);
+    if (usados <= 0 || n == 0 || static_cast<unsigned int>(longitud - usados) != n) {
+        return nullptr;
+    }
+    return arena->crear<TramaBulk>(dato + usados, static_cast<int>(n));
+}
+
+/**
+ * @brief Fábrica de tramas SELECT binarias: 0xA4 seguido del índice en varint
+ */
+TramaBase* fabricarSeleccionBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    unsigned int indice;
+    int usados = leerVarint(reinterpret_cast<const unsigned char*>(dato), longitud, &indice);
+    if (usados <= 0 || usados != longitud || !esIndiceDeRotor(indice)) {
+        return nullptr;
+    }
+    return arena->crear<TramaSeleccion>(static_cast<int>(indice));
+}
+
+/**
+ * @brief Fábrica de tramas ROTOR binarias: 0xA5, índice varint y rotación varint zigzag
+ */
+TramaBase* fabricarRotorBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(dato);
+    unsigned int indice;
+    unsigned int valor;
+    int usados = leerVarint(bytes, longitud, &indice);
+    if (usados <= 0 || !esIndiceDeRotor(indice)) {
+        return nullptr;
+    }
+    int segundo = leerVarint(bytes + usados, longitud - usados, &valor);
+    if (segundo <= 0 || usados + segundo != longitud) {
+        return nullptr;
+    }
+    return arena->crear<TramaRotor>(static_cast<int>(indice), decodificarZigzag(valor));
+}
+
+/**
+ * @brief Fábrica de tramas FIN binarias: 0xA6 sin datos
+ */
+TramaBase* fabricarFinBinaria(const char* dato, int longitud, ArenaDeTramas* arena) {
+    (void)dato;
+    if (longitud != 0) {
+        return nullptr;
+    }
+    return arena->crear<TramaFin>();
+}
+
+} // namespace
+
+int enteroDesdeTexto(const char* texto, int longitud) {
+    int i = 0;
+    
+    // Espacios iniciales
+    while (i < longitud && (texto[i] == ' ' || texto[i] == '\t')) {
+        i++;
+    }
+    
+    // Signo opcional
+    bool negativo = false;
+    if (i < longitud && (texto[i] == '-' || texto[i] == '+')) {
+        negativo = texto[i] == '-';
+        i++;
+    }
+    
+    // Dígitos (saturando para no desbordar)
+    long valor = 0;
+    while (i < longitud && texto[i] >= '0' && texto[i] <= '9') {
+        valor = valor * 10 + (texto[i] - '0');
+        if (valor > INT_MAX) {
+            valor = INT_MAX;
+        }
+        i++;
+    }
+    
+    return static_cast<int>(negativo ? -valor : valor);
+}
+
+RegistroDeTramas::RegistroDeTramas() : advertencias(true), longitudDelimitador(0) {
+    for (int i = 0; i < 256; ++i) {
+        fabricas[i] = nullptr;
+    }
+    establecerDelimitador(DELIMITADOR_FIN_DEFECTO);
+    
+    registrar('L', fabricarLoad);
+    registrar('l', fabricarLoad);
+    registrar('M', fabricarMap);
+    registrar('m', fabricarMap);
+    registrar('B', fabricarBulk);
+    registrar('b', fabricarBulk);
+    registrar('S', fabricarSeleccion);
+    registrar('s', fabricarSeleccion);
+    registrar('R', fabricarRotor);
+    registrar('r', fabricarRotor);
+    
+    // Variantes binarias (ver FormatoBinario.h)
+    registrar(ETIQUETA_LOAD, fabricarLoadBinaria);
+    registrar(ETIQUETA_MAP, fabricarMapBinaria);
+    registrar(ETIQUETA_BULK, fabricarBulkBinaria);
+    registrar(ETIQUETA_SELECCION, fabricarSeleccionBinaria);
+    registrar(ETIQUETA_ROTOR, fabricarRotorBinaria);
+    registrar(ETIQUETA_FIN, fabricarFinBinaria);
+}
+
+void RegistroDeTramas::registrar(unsigned char tipo, FabricaTrama fabrica) {
+    fabricas[tipo] = fabrica;
+}
+
+void RegistroDeTramas::establecerDelimitador(const char* texto) {
+    strncpy(delimitador, texto, LONGITUD_MAX_DELIMITADOR);
+    delimitador[LONGITUD_MAX_DELIMITADOR] = '\0';
+    longitudDelimitador = static_cast<int>(strlen(delimitador));
+}
+
+TramaBase* RegistroDeTramas::parsear(const char* linea, int longitud, ArenaDeTramas* arena) const {
+    if (!linea || longitud < 1) {
+        Metricas::sumar(CONTADOR_INVALIDA_CORTA);
+        return nullptr;
+    }
+    
+    unsigned char tipo = static_cast<unsigned char>(linea[0]);
+    
+    // Trama binaria: la etiqueta va seguida directamente de la carga
+    if (esTramaBinaria(tipo)) {
+        if (!fabricas[tipo]) {
+            if (advertencias) {
+                printf("Advertencia: Etiqueta binaria desconocida: 0x%02X\n", tipo);
+            }
+            Metricas::sumar(CONTADOR_INVALIDA_TIPO);
+            return nullptr;
+        }
+        return contarDatoInvalido(fabricas[tipo](linea + 1, longitud - 1, arena));
+    }
+    
+    // Delimitador de mensajes: la línea completa, sin coma
+    if (longitud == longitudDelimitador && memcmp(linea, delimitador, longitud) == 0) {
+        return arena->crear<TramaFin>();
+    }
+    
+    // El formato esperado es: "X,Y" donde X es el tipo y Y es el dato
+    if (longitud < 3) {
+        Metricas::sumar(CONTADOR_INVALIDA_CORTA);
+        return nullptr;
+    }
+    
+    // Verificar que hay una coma
+    if (linea[1] != ',') {
+        if (advertencias) {
+            printf("Advertencia: Formato inválido (falta coma): %.*s\n", longitud, linea);
+        }
+        Metricas::sumar(CONTADOR_INVALIDA_SIN_COMA);
+        return nullptr;
+    }
+    
+    // Salto directo a la fábrica del tipo
+    FabricaTrama fabrica = fabricas[tipo];
+    if (!fabrica) {
+        if (advertencias) {
+            printf("Advertencia: Tipo de trama desconocido: %c\n", linea[0]);
+        }
+        Metricas::sumar(CONTADOR_INVALIDA_TIPO);
+        return nullptr;
+    }
+    
+    return contarDatoInvalido(fabrica(linea + 2, longitud - 2, arena));
+}
@@ -5,15 +5,121 @@
 
 #include "RotorDeMapeo.h"
 #include <cstdio>   // Para printf
-#include <cctype>   // Para toupper
+#include <cctype>   // Para isprint
+#include <cstring>  // Para strlen
+#include <cstdlib>  // Para strtol
 
-RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
-    // Construir la lista circular con A-Z
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #include <immintrin.h>
+    #define PRT7_SIMD_X86 1
+#endif
+
+namespace {
+
+#ifdef PRT7_SIMD_X86
+
+/**
+ * @brief Kernel SSE2: corrimiento César de 16 bytes por iteración
+ * @return Número de bytes procesados (múltiplo de 16)
+ */
+__attribute__((target("sse2")))
+size_t mapearBloqueSSE2(const char* in, char* out, size_t n, int desplazamiento) {
+    const __m128i minA = _mm_set1_epi8('a' - 1);
+    const __m128i maxZ = _mm_set1_epi8('z' + 1);
+    const __m128i mayA = _mm_set1_epi8('A' - 1);
+    const __m128i mayZ = _mm_set1_epi8('Z' + 1);
+    const __m128i ultima = _mm_set1_epi8('Z');
+    const __m128i difCaso = _mm_set1_epi8(0x20);
+    const __m128i vuelta = _mm_set1_epi8(TAMANIO_ALFABETO);
+    const __m128i despl = _mm_set1_epi8(static_cast<char>(desplazamiento));
+    
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        
+        // Las comparaciones son con signo: los bytes >= 0x80 nunca son letras
+        __m128i esMinuscula = _mm_and_si128(_mm_cmpgt_epi8(v, minA), _mm_cmplt_epi8(v, maxZ));
+        __m128i mayuscula = _mm_sub_epi8(v, _mm_and_si128(esMinuscula, difCaso));
+        __m128i esLetra = _mm_and_si128(_mm_cmpgt_epi8(mayuscula, mayA),
+                                        _mm_cmplt_epi8(mayuscula, mayZ));
+        
+        __m128i rotada = _mm_add_epi8(mayuscula, despl);
+        rotada = _mm_sub_epi8(rotada, _mm_and_si128(_mm_cmpgt_epi8(rotada, ultima), vuelta));
+        
+        __m128i resultado = _mm_or_si128(_mm_and_si128(esLetra, rotada),
+                                         _mm_andnot_si128(esLetra, v));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), resultado);
+    }
+    return i;
+}
+
+/**
+ * @brief Kernel AVX2: corrimiento César de 32 bytes por iteración
+ * @return Número de bytes procesados (múltiplo de 32)
+ */
+__attribute__((target("avx2")))
+size_t mapearBloqueAVX2(const char* in, char* out, size_t n, int desplazamiento) {
+    const __m256i minA = _mm256_set1_epi8('a' - 1);
+    const __m256i maxZ = _mm256_set1_epi8('z' + 1);
+    const __m256i mayA = _mm256_set1_epi8('A' - 1);
+    const __m256i mayZ = _mm256_set1_epi8('Z' + 1);
+    const __m256i ultima = _mm256_set1_epi8('Z');
+    const __m256i difCaso = _mm256_set1_epi8(0x20);
+    const __m256i vuelta = _mm256_set1_epi8(TAMANIO_ALFABETO);
+    const __m256i despl = _mm256_set1_epi8(static_cast<char>(desplazamiento));
+    
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+        
+        __m256i esMinuscula = _mm256_and_si256(_mm256_cmpgt_epi8(v, minA),
+                                               _mm256_cmpgt_epi8(maxZ, v));
+        __m256i mayuscula = _mm256_sub_epi8(v, _mm256_and_si256(esMinuscula, difCaso));
+        __m256i esLetra = _mm256_and_si256(_mm256_cmpgt_epi8(mayuscula, mayA),
+                                           _mm256_cmpgt_epi8(mayZ, mayuscula));
+        
+        __m256i rotada = _mm256_add_epi8(mayuscula, despl);
+        rotada = _mm256_sub_epi8(rotada,
+                                 _mm256_and_si256(_mm256_cmpgt_epi8(rotada, ultima), vuelta));
+        
+        __m256i resultado = _mm256_blendv_epi8(v, rotada, esLetra);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), resultado);
+    }
+    return i;
+}
+
+/// Firma común de los kernels vectoriales
+typedef size_t (*KernelBloque)(const char*, char*, size_t, int);
+
+/**
+ * @brief Selecciona una sola vez el mejor kernel disponible en este procesador
+ */
+KernelBloque seleccionarKernel() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return mapearBloqueAVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return mapearBloqueSSE2;
+    }
+    return nullptr;
+}
+
+#endif // PRT7_SIMD_X86
+
+} // namespace
+
+template <class Alfabeto>
+void RotorDeMapeo::construir() {
+    tamanio = Alfabeto::TAMANIO;
+    nodos = new NodoRotor*[tamanio];
+    
+    // Construir la lista circular con los símbolos del alfabeto
     NodoRotor* primero = nullptr;
     NodoRotor* ultimo = nullptr;
     
-    for (char c = 'A'; c <= 'Z'; ++c) {
-        NodoRotor* nuevo = new NodoRotor(c);
+    for (int i = 0; i < tamanio; ++i) {
+        NodoRotor* nuevo = new NodoRotor(Alfabeto::simboloEn(i));
         
         if (!primero) {
             // Primer nodo
@@ -25,125 +131,317 @@ RotorDeMapeo::RotorDeMapeo() : cabeza(nullptr), tamanio(0) {
             nuevo->previo = ultimo;
             ultimo = nuevo;
         }
-        tamanio++;
+        nodos[i] = nuevo;
     }
     
     // Cerrar el círculo
-    if (primero && ultimo) {
-        ultimo->siguiente = primero;
-        primero->previo = ultimo;
-    }
+    ultimo->siguiente = primero;
+    primero->previo = ultimo;
     
-    // Cabeza apunta inicialmente a 'A'
+    // Cabeza apunta inicialmente al primer símbolo ('A' por defecto)
     cabeza = primero;
+    
+    // Tablas del alfabeto para componer la cascada
+    posicionDe = TablasAlfabeto<Alfabeto>::posicion;
+    mascaraDe = TablasAlfabeto<Alfabeto>::mascara;
+    simboloDe = TablasAlfabeto<Alfabeto>::simbolos;
+    
+    // Copiar el mapeo de cada desplazamiento desde las tablas del alfabeto
+    tablaMapeo = new char[tamanio * 256];
+    RotorGenerico<Alfabeto> generico;
+    for (int d = 0; d < tamanio; ++d) {
+        generico.establecerDesplazamiento(d);
+        for (int b = 0; b < 256; ++b) {
+            tablaMapeo[d * 256 + b] = generico.getMapeo(static_cast<char>(b));
+        }
+    }
+    filaActual = tablaMapeo;
+}
+
+RotorDeMapeo::RotorDeMapeo(TipoAlfabeto tipoAlfabeto)
+    : cabeza(nullptr), tamanio(0), alfabeto(tipoAlfabeto),
+      posicionDe(nullptr), mascaraDe(nullptr), simboloDe(nullptr),
+      numRotores(1), seleccionado(0), cascada(false),
+      cableados(nullptr), filaCompuesta(nullptr),
+      bytesDelAlfabeto(nullptr), numBytesDelAlfabeto(0),
+      nodos(nullptr), tablaMapeo(nullptr), filaActual(nullptr) {
+    for (int i = 0; i < MAX_ROTORES_CASCADA; ++i) {
+        posiciones[i] = 0;
+        muescas[i] = 0;
+    }
+    
+    // Única decisión según el alfabeto: a partir de aquí todo es tabla
+    switch (alfabeto) {
+        case ALFABETO_ALFANUMERICO: construir<AlfabetoAlfanumerico>(); break;
+        case ALFABETO_IMPRIMIBLE:   construir<AlfabetoImprimible>();   break;
+        case ALFABETO_BYTES:        construir<AlfabetoBytes>();        break;
+        case ALFABETO_MAYUSCULAS:
+        default:
+            alfabeto = ALFABETO_MAYUSCULAS;
+            construir<AlfabetoMayusculas>();
+            break;
+    }
+    muescas[0] = tamanio - 1;
 }
 
 RotorDeMapeo::~RotorDeMapeo() {
-    if (!cabeza) return;
+    // Los nodos están todos en el arreglo: no hace falta recorrer el círculo
+    for (int i = 0; i < tamanio; ++i) {
+        delete nodos[i];
+    }
+    delete[] nodos;
+    delete[] tablaMapeo;
+    delete[] cableados;
+    delete[] filaCompuesta;
+    delete[] bytesDelAlfabeto;
+    cabeza = nullptr;
+}
+
+void RotorDeMapeo::actualizarPosicion() {
+    cabeza = nodos[posiciones[0]];
     
-    // Romper el círculo para evitar bucle infinito
-    NodoRotor* ultimo = cabeza->previo;
-    if (ultimo) {
-        ultimo->siguiente = nullptr;
+    if (!cascada) {
+        filaActual = tablaMapeo + posiciones[0] * 256;
+        return;
     }
     
-    // Eliminar todos los nodos
-    NodoRotor* actual = cabeza;
-    while (actual) {
-        NodoRotor* siguiente = actual->siguiente;
-        delete actual;
-        actual = siguiente;
+    // Componer la cascada sobre los índices del alfabeto...
+    unsigned char compuesta[256];
+    for (int x = 0; x < tamanio; ++x) {
+        int y = x;
+        for (int r = 0; r < numRotores; ++r) {
+            y = cableados[r * 2 * tamanio + y + posiciones[r]];
+        }
+        compuesta[x] = static_cast<unsigned char>(y);
     }
     
-    cabeza = nullptr;
+    // ...y llevarla a bytes (los que no pertenecen al alfabeto no cambian nunca)
+    for (int i = 0; i < numBytesDelAlfabeto; ++i) {
+        unsigned char b = bytesDelAlfabeto[i];
+        filaCompuesta[b] = simboloDe[compuesta[posicionDe[b]]];
+    }
+    filaActual = filaCompuesta;
 }
 
-NodoRotor* RotorDeMapeo::buscarNodo(char c) const {
-    if (!cabeza) return nullptr;
+void RotorDeMapeo::rotar(int n) {
+    if (!cabeza || n == 0) return;
     
-    // Convertir a mayúscula
-    c = toupper(c);
+    if (cascada) {
+        rotarRotor(seleccionado, n);
+        return;
+    }
     
-    NodoRotor* actual = cabeza;
-    do {
-        if (actual->dato == c) {
-            return actual;
-        }
-        actual = actual->siguiente;
-    } while (actual != cabeza);
+    // Normalizar la rotación (módulo del tamaño)
+    n = n % tamanio;
+    if (n < 0) n += tamanio;
     
-    return nullptr;
+    // Mover la cabeza n posiciones sin recorrer la lista
+    posiciones[0] = (posiciones[0] + n) % tamanio;
+    cabeza = nodos[posiciones[0]];
+    filaActual = tablaMapeo + posiciones[0] * 256;
 }
 
-int RotorDeMapeo::calcularDistancia(NodoRotor* desde, NodoRotor* hasta) const {
-    if (!desde || !hasta) return 0;
+void RotorDeMapeo::rotarRotor(int indice, int n) {
+    if (!cabeza || indice < 0 || indice >= numRotores) return;
     
-    int distancia = 0;
-    NodoRotor* actual = desde;
+    bool movido = false;
+    long long pasos = n;
+    for (int r = indice; r < numRotores && pasos != 0; ++r) {
+        // Distancia recorrida desde el último paso por la muesca: cada
+        // vuelta completa (hacia adelante o atrás) arrastra al siguiente
+        int relativa = posiciones[r] - muescas[r] - 1;
+        if (relativa < 0) relativa += tamanio;
+        long long total = relativa + pasos;
+        long long arrastre = total >= 0 ? total / tamanio : -((tamanio - 1 - total) / tamanio);
+        
+        int nueva = static_cast<int>(total - arrastre * tamanio) + muescas[r] + 1;
+        if (nueva >= tamanio) nueva -= tamanio;
+        movido = movido || nueva != posiciones[r];
+        posiciones[r] = nueva;
+        pasos = arrastre;
+    }
     
-    while (actual != hasta && distancia < tamanio) {
-        actual = actual->siguiente;
-        distancia++;
+    // La permutación compuesta solo se recalcula si algo cambió de verdad
+    if (movido) {
+        actualizarPosicion();
+    }
+}
+
+bool RotorDeMapeo::seleccionarRotor(int indice) {
+    if (indice < 0 || indice >= numRotores) return false;
+    seleccionado = indice;
+    return true;
+}
+
+bool RotorDeMapeo::establecerEstado(const int* posicionesRotores, int rotores, int rotorSeleccionado) {
+    if (!cabeza || rotores != numRotores || rotorSeleccionado < 0 || rotorSeleccionado >= numRotores) {
+        return false;
+    }
+    for (int r = 0; r < rotores; ++r) {
+        if (posicionesRotores[r] < 0 || posicionesRotores[r] >= tamanio) return false;
     }
     
-    return distancia;
+    for (int r = 0; r < rotores; ++r) {
+        posiciones[r] = posicionesRotores[r];
+    }
+    seleccionado = rotorSeleccionado;
+    actualizarPosicion();
+    return true;
 }
 
-void RotorDeMapeo::rotar(int n) {
-    if (!cabeza || n == 0) return;
+void RotorDeMapeo::reiniciar() {
+    if (!cabeza) return;
     
-    // Normalizar la rotación (módulo del tamaño)
-    n = n % tamanio;
-    if (n < 0) n += tamanio;
+    for (int r = 0; r < numRotores; ++r) {
+        posiciones[r] = 0;
+    }
+    seleccionado = 0;
+    actualizarPosicion();
+}
+
+int RotorDeMapeo::leerRotor(const char* texto, int indice) {
+    unsigned char* cableado = cableados + indice * 2 * tamanio;
+    bool usado[256] = {false};
+    
+    for (int i = 0; i < tamanio; ++i) {
+        unsigned char b = static_cast<unsigned char>(texto[i]);
+        if (b == '\0') {
+            fprintf(stderr, "Error: El cableado del rotor %d debe tener %d símbolos\n", indice, tamanio);
+            return 0;
+        }
+        if (!mascaraDe[b] || usado[posicionDe[b]]) {
+            fprintf(stderr, "Error: El cableado del rotor %d no es una permutación del alfabeto\n", indice);
+            return 0;
+        }
+        usado[posicionDe[b]] = true;
+        cableado[i] = posicionDe[b];
+        cableado[i + tamanio] = posicionDe[b];
+    }
+    
+    int consumidos = tamanio;
+    muescas[indice] = tamanio - 1;
+    if (texto[consumidos] == ':') {
+        unsigned char muesca = static_cast<unsigned char>(texto[consumidos + 1]);
+        if (muesca == '\0' || !mascaraDe[muesca]) {
+            fprintf(stderr, "Error: Muesca inválida en el rotor %d\n", indice);
+            return 0;
+        }
+        muescas[indice] = posicionDe[muesca];
+        consumidos += 2;
+    }
     
-    // Mover la cabeza n posiciones
-    for (int i = 0; i < n; ++i) {
-        cabeza = cabeza->siguiente;
+    if (texto[consumidos] != ',' && texto[consumidos] != '\0') {
+        fprintf(stderr, "Error: El cableado del rotor %d debe tener %d símbolos\n", indice, tamanio);
+        return 0;
     }
+    return consumidos;
 }
 
-char RotorDeMapeo::getMapeo(char in) {
-    // Casos especiales: espacio y otros caracteres no alfabéticos
-    if (in == ' ' || in == '\n' || in == '\r' || in == '\t') {
-        return in;  // Los espacios y caracteres especiales no se mapean
+bool RotorDeMapeo::configurarCascada(const char* especificacion) {
+    if (!especificacion || !*especificacion || !cabeza) {
+        fprintf(stderr, "Error: Especificación de rotores vacía\n");
+        return false;
     }
     
-    // Convertir a mayúscula
-    in = toupper(in);
+    // Se trabaja sobre copias para no tocar el rotor si la especificación falla
+    int muescasPrevias[MAX_ROTORES_CASCADA];
+    for (int i = 0; i < MAX_ROTORES_CASCADA; ++i) {
+        muescasPrevias[i] = muescas[i];
+    }
+    unsigned char* previos = cableados;
+    cableados = new unsigned char[MAX_ROTORES_CASCADA * 2 * tamanio];
     
-    // Si no está en A-Z, retornar tal cual
-    if (in < 'A' || in > 'Z') {
-        return in;
+    int rotores = 0;
+    size_t largo = strlen(especificacion);
+    bool soloDigitos = largo < static_cast<size_t>(tamanio);
+    for (size_t i = 0; i < largo && soloDigitos; ++i) {
+        soloDigitos = especificacion[i] >= '0' && especificacion[i] <= '9';
     }
     
-    // Algoritmo correcto de mapeo:
-    // La rotación del rotor desplaza el alfabeto
-    // Si cabeza está en 'C' (rotación +2), entonces:
-    //   A -> C (desplazamiento de +2)
-    //   B -> D (desplazamiento de +2)
-    //   etc.
+    bool valida = true;
+    if (soloDigitos) {
+        // N rotores de corrimiento puro
+        rotores = static_cast<int>(strtol(especificacion, nullptr, 10));
+        if (rotores < 1 || rotores > MAX_ROTORES_CASCADA) {
+            fprintf(stderr, "Error: La cascada admite de 1 a %d rotores\n", MAX_ROTORES_CASCADA);
+            valida = false;
+        }
+        for (int r = 0; valida && r < rotores; ++r) {
+            for (int i = 0; i < 2 * tamanio; ++i) {
+                cableados[r * 2 * tamanio + i] = static_cast<unsigned char>(i % tamanio);
+            }
+            muescas[r] = tamanio - 1;
+        }
+    } else {
+        const char* actual = especificacion;
+        while (valida) {
+            if (rotores == MAX_ROTORES_CASCADA) {
+                fprintf(stderr, "Error: La cascada admite de 1 a %d rotores\n", MAX_ROTORES_CASCADA);
+                valida = false;
+                break;
+            }
+            int consumidos = leerRotor(actual, rotores);
+            if (consumidos == 0) {
+                valida = false;
+                break;
+            }
+            rotores++;
+            actual += consumidos;
+            if (*actual == '\0') break;
+            actual++;  // ','
+        }
+    }
     
-    // Calcular el desplazamiento: distancia desde 'A' hasta 'cabeza'
-    NodoRotor* nodoA = buscarNodo('A');
-    if (!nodoA) {
-        return in;
+    if (!valida) {
+        delete[] cableados;
+        cableados = previos;
+        for (int i = 0; i < MAX_ROTORES_CASCADA; ++i) {
+            muescas[i] = muescasPrevias[i];
+        }
+        return false;
     }
+    delete[] previos;
     
-    int desplazamiento = calcularDistancia(nodoA, cabeza);
+    // Un solo rotor sin cableado es el corrimiento de siempre
+    bool identidad = rotores == 1;
+    for (int i = 0; identidad && i < tamanio; ++i) {
+        identidad = cableados[i] == i;
+    }
     
-    // Encontrar el nodo del carácter de entrada
-    NodoRotor* nodoEntrada = buscarNodo(in);
-    if (!nodoEntrada) {
-        return in;
+    numRotores = rotores;
+    seleccionado = 0;
+    cascada = !identidad;
+    for (int r = 0; r < MAX_ROTORES_CASCADA; ++r) {
+        posiciones[r] = 0;
+    }
+    if (cascada && !filaCompuesta) {
+        filaCompuesta = new char[256];
+        bytesDelAlfabeto = new unsigned char[256];
+        for (int b = 0; b < 256; ++b) {
+            filaCompuesta[b] = static_cast<char>(b);
+            if (mascaraDe[b]) {
+                bytesDelAlfabeto[numBytesDelAlfabeto++] = static_cast<unsigned char>(b);
+            }
+        }
     }
+    actualizarPosicion();
+    return true;
+}
+
+void RotorDeMapeo::mapearBloque(const char* in, char* out, size_t n) const {
+    size_t i = 0;
     
-    // Aplicar el desplazamiento: avanzar 'desplazamiento' posiciones
-    NodoRotor* resultado = nodoEntrada;
-    for (int i = 0; i < desplazamiento; ++i) {
-        resultado = resultado->siguiente;
+#ifdef PRT7_SIMD_X86
+    static const KernelBloque kernel = seleccionarKernel();
+    if (kernel && alfabeto == ALFABETO_MAYUSCULAS && !cascada) {
+        i = kernel(in, out, n, posiciones[0]);
     }
+#endif
     
-    return resultado->dato;
+    // Respaldo escalar (y cola del bloque que no llena un vector)
+    for (; i < n; ++i) {
+        out[i] = filaActual[static_cast<unsigned char>(in[i])];
+    }
 }
 
 void RotorDeMapeo::imprimirEstado() const {
@@ -157,11 +455,26 @@ void RotorDeMapeo::imprimirEstado() const {
     NodoRotor* actual = cabeza;
     int contador = 0;
     do {
-        printf("%c ", actual->dato);
+        if (isprint(static_cast<unsigned char>(actual->dato))) {
+            printf("%c ", actual->dato);
+        } else {
+            printf("\\x%02X ", static_cast<unsigned char>(actual->dato));
+        }
         actual = actual->siguiente;
         contador++;
         if (contador >= tamanio) break;
     } while (actual != cabeza);
     
+    if (cascada) {
+        printf("| rotores:");
+        imprimirPosiciones();
+    }
+    
     printf("\n");
 }
+
+void RotorDeMapeo::imprimirPosiciones() const {
+    for (int r = 0; r < numRotores; ++r) {
+        printf(" %d%s", posiciones[r], r == seleccionado ? "*" : "");
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file SalidaDeMensaje.cpp
+ * @brief Implementación de los modos de salida
+ */
+
+#include "SalidaDeMensaje.h"
+
+namespace {
+
+/// Tramas entre consultas del reloj en modo periódico
+const int SONDEO_RELOJ = 64;
+
+/// Caracteres que se copian de la lista por cada llamada a copiarDesde()
+const int TAM_TRAMO_SALIDA = 1024;
+
+} // namespace
+
+SalidaDeMensaje::SalidaDeMensaje(const ListaDeCarga* cargaMensaje, ModoSalida modoSalida,
+                                 int intervaloMs)
+    : carga(cargaMensaje),
+      modo(modoSalida),
+      escritor(stdout),
+      emitidos(cargaMensaje->obtenerDescartados() + cargaMensaje->obtenerTamanio()),
+      tramasSinSondeo(0),
+      intervalo(std::chrono::milliseconds(intervaloMs)),
+      inicio(std::chrono::steady_clock::now()),
+      proximoReporte(inicio + intervalo) {
+    if (modo == SALIDA_INCREMENTAL) {
+        escritor.escribirFormato("Mensaje decodificado: ");
+        escritor.vaciar();
+    }
+}
+
+void SalidaDeMensaje::emitirNuevos() {
+    char tramo[TAM_TRAMO_SALIDA];
+    
+    // 'emitidos' es absoluto: el principio de la lista puede haberse descartado
+    int posicion = static_cast<int>(emitidos - carga->obtenerDescartados());
+    while (posicion < carga->obtenerTamanio()) {
+        int n = carga->copiarDesde(posicion, tramo, TAM_TRAMO_SALIDA);
+        escritor.escribir(tramo, n);
+        posicion += n;
+    }
+    emitidos = carga->obtenerDescartados() + posicion;
+}
+
+void SalidaDeMensaje::reportarProgreso(int tramas, bool forzar) {
+    std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+    if (!forzar && ahora < proximoReporte) return;
+    
+    double segundos = std::chrono::duration<double>(ahora - inicio).count();
+    escritor.escribirFormato("[progreso] %d trama(s), %d carácter(es), %.0f tramas/s\n",
+                             tramas, carga->obtenerTamanio(),
+                             segundos > 0.0 ? tramas / segundos : 0.0);
+    escritor.vaciar();
+    
+    while (proximoReporte <= ahora) {
+        proximoReporte += intervalo;
+    }
+}
+
+void SalidaDeMensaje::tramaProcesada(int tramas) {
+    if (modo == SALIDA_INCREMENTAL) {
+        if (emitidos < carga->obtenerDescartados() + carga->obtenerTamanio()) {
+            emitirNuevos();
+        }
+    } else if (modo == SALIDA_PERIODICA) {
+        if (++tramasSinSondeo >= SONDEO_RELOJ) {
+            tramasSinSondeo = 0;
+            reportarProgreso(tramas, false);
+        }
+    }
+}
+
+void SalidaDeMensaje::pausa(int tramas) {
+    if (modo == SALIDA_INCREMENTAL) {
+        emitirNuevos();
+        escritor.vaciar();
+    } else if (modo == SALIDA_PERIODICA) {
+        reportarProgreso(tramas, false);
+    }
+}
+
+void SalidaDeMensaje::finalizar(int tramas) {
+    if (modo == SALIDA_INCREMENTAL) {
+        emitirNuevos();
+        escritor.escribir("\n", 1);
+    } else if (modo == SALIDA_PERIODICA) {
+        reportarProgreso(tramas, true);
+    }
+    escritor.vaciar();
+}
@@ -4,6 +4,9 @@
  */
 
 #include "SerialPort.h"
+#include "FormatoBinario.h"
+#include "HistogramaLatencia.h"
+#include "Metricas.h"
 #include <cstdio>
 #include <cstring>
 
@@ -11,9 +14,130 @@
     #include <fcntl.h>
     #include <unistd.h>
     #include <errno.h>
+    #include <poll.h>
 #endif
 
-SerialPort::SerialPort(const char* nombrePuerto) : conectado(false) {
+namespace {
+
+/**
+ * @struct VelocidadSerial
+ * @brief Asociación entre baudios y la constante del sistema
+ */
+struct VelocidadSerial {
+    int baudios;        ///< Velocidad numérica
+#ifdef _WIN32
+    DWORD constante;    ///< Valor para DCB::BaudRate
+#else
+    speed_t constante;  ///< Constante Bxxxx de termios
+#endif
+};
+
+#ifdef _WIN32
+    #define PRT7_VELOCIDAD(n) { n, n }
+#else
+    #define PRT7_VELOCIDAD(n) { n, B##n }
+#endif
+
+/// Velocidades estándar soportadas por la plataforma
+const VelocidadSerial VELOCIDADES[] = {
+    PRT7_VELOCIDAD(1200), PRT7_VELOCIDAD(2400), PRT7_VELOCIDAD(4800),
+    PRT7_VELOCIDAD(9600), PRT7_VELOCIDAD(19200), PRT7_VELOCIDAD(38400),
+    PRT7_VELOCIDAD(57600), PRT7_VELOCIDAD(115200),
+#if defined(_WIN32) || defined(B230400)
+    PRT7_VELOCIDAD(230400),
+#endif
+#if defined(_WIN32) || defined(B460800)
+    PRT7_VELOCIDAD(460800),
+#endif
+#if defined(_WIN32) || defined(B500000)
+    PRT7_VELOCIDAD(500000),
+#endif
+#if defined(_WIN32) || defined(B576000)
+    PRT7_VELOCIDAD(576000),
+#endif
+#if defined(_WIN32) || defined(B921600)
+    PRT7_VELOCIDAD(921600),
+#endif
+#if defined(_WIN32) || defined(B1000000)
+    PRT7_VELOCIDAD(1000000),
+#endif
+#if defined(_WIN32) || defined(B1152000)
+    PRT7_VELOCIDAD(1152000),
+#endif
+#if defined(_WIN32) || defined(B1500000)
+    PRT7_VELOCIDAD(1500000),
+#endif
+#if defined(_WIN32) || defined(B2000000)
+    PRT7_VELOCIDAD(2000000),
+#endif
+#if defined(_WIN32) || defined(B2500000)
+    PRT7_VELOCIDAD(2500000),
+#endif
+#if defined(_WIN32) || defined(B3000000)
+    PRT7_VELOCIDAD(3000000),
+#endif
+#if defined(_WIN32) || defined(B3500000)
+    PRT7_VELOCIDAD(3500000),
+#endif
+#if defined(_WIN32) || defined(B4000000)
+    PRT7_VELOCIDAD(4000000),
+#endif
+};
+
+#undef PRT7_VELOCIDAD
+
+const int NUM_VELOCIDADES = sizeof(VELOCIDADES) / sizeof(VELOCIDADES[0]);
+
+/**
+ * @brief Busca la velocidad estándar correspondiente a un número de baudios
+ * @param baudios Velocidad pedida
+ * @return Puntero a la entrada de la tabla, o nullptr si no es estándar
+ */
+const VelocidadSerial* buscarVelocidad(int baudios) {
+    for (int i = 0; i < NUM_VELOCIDADES; ++i) {
+        if (VELOCIDADES[i].baudios == baudios) {
+            return &VELOCIDADES[i];
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+const char* validarConfiguracionSerial(const ConfiguracionSerial& config) {
+    if (!buscarVelocidad(config.baudios)) {
+        return "velocidad no soportada (use una velocidad estándar hasta 4000000)";
+    }
+    if (config.bitsDatos < 5 || config.bitsDatos > 8) {
+        return "bits de datos fuera de rango (5 a 8)";
+    }
+    if (config.paridad != 'N' && config.paridad != 'E' && config.paridad != 'O') {
+        return "paridad inválida (N, E u O)";
+    }
+    if (config.bitsParada != 1 && config.bitsParada != 2) {
+        return "bits de parada inválidos (1 o 2)";
+    }
+    if (config.controlFlujo != 'N' && config.controlFlujo != 'H' && config.controlFlujo != 'S') {
+        return "control de flujo inválido (ninguno, hw o sw)";
+    }
+    if (config.vmin < 0 || config.vmin > 255 || config.vtime < 0 || config.vtime > 255) {
+        return "VMIN y VTIME deben estar entre 0 y 255";
+    }
+    return nullptr;
+}
+
+SerialPort::SerialPort(const char* nombrePuerto, const ConfiguracionSerial& config)
+    : conectado(false),
+      configuracion(config),
+      bufferLectura(new char[TAM_BUFFER_LECTURA]),
+      inicio(0),
+      fin(0),
+      inicioBusqueda(0),
+      noBloqueante(false),
+      ultimaLlegadaNs(0),
+      esperaMaximaMs(0),
+      pausaAvisada(false),
+      descriptorCancelacion(-1) {
 #ifdef _WIN32
     // Windows
     hSerial = CreateFileA(nombrePuerto,
@@ -55,6 +179,7 @@ SerialPort::SerialPort(const char* nombrePuerto) : conectado(false) {
 
 SerialPort::~SerialPort() {
     cerrar();
+    delete[] bufferLectura;
 }
 
 bool SerialPort::configurarPuerto() {
@@ -68,21 +193,35 @@ bool SerialPort::configurarPuerto() {
         return false;
     }
     
-    // Configurar parámetros: 9600 baud, 8N1
-    dcbSerialParams.BaudRate = CBR_9600;
-    dcbSerialParams.ByteSize = 8;
-    dcbSerialParams.StopBits = ONESTOPBIT;
-    dcbSerialParams.Parity = NOPARITY;
+    const char* error = validarConfiguracionSerial(configuracion);
+    if (error) {
+        printf("Error: Configuración serial inválida: %s\n", error);
+        return false;
+    }
+    
+    // Configurar parámetros de línea (por defecto 9600 baud, 8N1)
+    dcbSerialParams.BaudRate = buscarVelocidad(configuracion.baudios)->constante;
+    dcbSerialParams.ByteSize = static_cast<BYTE>(configuracion.bitsDatos);
+    dcbSerialParams.StopBits = configuracion.bitsParada == 2 ? TWOSTOPBITS : ONESTOPBIT;
+    dcbSerialParams.Parity = configuracion.paridad == 'E' ? EVENPARITY :
+                             configuracion.paridad == 'O' ? ODDPARITY : NOPARITY;
+    
+    // Control de flujo
+    dcbSerialParams.fOutxCtsFlow = configuracion.controlFlujo == 'H';
+    dcbSerialParams.fRtsControl = configuracion.controlFlujo == 'H' ?
+                                  RTS_CONTROL_HANDSHAKE : RTS_CONTROL_ENABLE;
+    dcbSerialParams.fOutX = configuracion.controlFlujo == 'S';
+    dcbSerialParams.fInX = configuracion.controlFlujo == 'S';
     
     if (!SetCommState(hSerial, &dcbSerialParams)) {
         printf("Error: No se pudo configurar el puerto\n");
         return false;
     }
     
-    // Configurar timeouts
+    // Configurar timeouts (VTIME se expresa en décimas de segundo)
     COMMTIMEOUTS timeouts = {0};
     timeouts.ReadIntervalTimeout = 50;
-    timeouts.ReadTotalTimeoutConstant = 50;
+    timeouts.ReadTotalTimeoutConstant = configuracion.vtime > 0 ? configuracion.vtime * 100 : 50;
     timeouts.ReadTotalTimeoutMultiplier = 10;
     timeouts.WriteTotalTimeoutConstant = 50;
     timeouts.WriteTotalTimeoutMultiplier = 10;
@@ -97,21 +236,62 @@ bool SerialPort::configurarPuerto() {
     // Configuración para Linux/Unix
     struct termios newtio;
     
+    const char* error = validarConfiguracionSerial(configuracion);
+    if (error) {
+        printf("Error: Configuración serial inválida: %s\n", error);
+        return false;
+    }
+    
     // Guardar configuración antigua
     tcgetattr(fd, &oldtio);
     
-    // Limpiar estructura
-    memset(&newtio, 0, sizeof(newtio));
+    if (configuracion.modoCrudo) {
+        // Partir de la configuración cruda del sistema
+        newtio = oldtio;
+        cfmakeraw(&newtio);
+        newtio.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+    } else {
+        // Limpiar estructura
+        memset(&newtio, 0, sizeof(newtio));
+        newtio.c_oflag = 0;
+        newtio.c_lflag = 0;
+    }
+    
+    // Configurar parámetros de línea (por defecto 9600 baud, 8N1)
+    static const tcflag_t TAMANIOS[] = { CS5, CS6, CS7, CS8 };
+    newtio.c_cflag |= TAMANIOS[configuracion.bitsDatos - 5] | CLOCAL | CREAD;
+    
+    if (configuracion.paridad == 'N') {
+        newtio.c_iflag |= IGNPAR;
+    } else {
+        newtio.c_cflag |= PARENB;
+        if (configuracion.paridad == 'O') {
+            newtio.c_cflag |= PARODD;
+        }
+        newtio.c_iflag |= INPCK;
+    }
+    
+    if (configuracion.bitsParada == 2) {
+        newtio.c_cflag |= CSTOPB;
+    }
+    
+    // Control de flujo
+#ifdef CRTSCTS
+    if (configuracion.controlFlujo == 'H') {
+        newtio.c_cflag |= CRTSCTS;
+    }
+#endif
+    if (configuracion.controlFlujo == 'S') {
+        newtio.c_iflag |= IXON | IXOFF;
+    }
     
-    // Configurar parámetros: 9600 baud, 8N1
-    newtio.c_cflag = B9600 | CS8 | CLOCAL | CREAD;
-    newtio.c_iflag = IGNPAR;
-    newtio.c_oflag = 0;
-    newtio.c_lflag = 0;
+    speed_t velocidad = buscarVelocidad(configuracion.baudios)->constante;
+    cfsetispeed(&newtio, velocidad);
+    cfsetospeed(&newtio, velocidad);
     
-    // Timeouts
-    newtio.c_cc[VTIME] = 1;  // Timeout de 0.1 segundos
-    newtio.c_cc[VMIN] = 0;   // No bloquear lectura
+    // Política de lectura (por defecto timeout de 0.1 segundos sin bloquear)
+    newtio.c_cc[VTIME] = static_cast<cc_t>(configuracion.vtime);
+    newtio.c_cc[VMIN] = static_cast<cc_t>(configuracion.vmin);
     
     // Limpiar buffer
     tcflush(fd, TCIFLUSH);
@@ -126,30 +306,240 @@ bool SerialPort::configurarPuerto() {
 #endif
 }
 
-int SerialPort::leerLinea(char* buffer, int longitudMax) {
-    if (!conectado || longitudMax <= 0) return -1;
+int SerialPort::rellenarBuffer() {
+    if (!conectado) return -1;
     
-    int indice = 0;
-    char c;
+    // Buffer consumido por completo: volver a leer desde el inicio
+    if (inicio == fin) {
+        inicio = 0;
+        fin = 0;
+        inicioBusqueda = 0;
+    }
+    
+    // Compactar los bytes pendientes si no queda espacio al final
+    if (fin == TAM_BUFFER_LECTURA && inicio > 0) {
+        int pendientes = fin - inicio;
+        memmove(bufferLectura, bufferLectura + inicio, pendientes);
+        inicioBusqueda -= inicio;
+        inicio = 0;
+        fin = pendientes;
+    }
+    
+    int espacio = TAM_BUFFER_LECTURA - fin;
+    if (espacio <= 0) return 0;
+    
+#ifdef _WIN32
+    DWORD bytesLeidos;
+    if (!ReadFile(hSerial, bufferLectura + fin, espacio, &bytesLeidos, nullptr)) {
+        return -1;
+    }
+    int resultado = static_cast<int>(bytesLeidos);
+#else
+    if (!noBloqueante && !esperarDatos()) {
+        return 0;
+    }
+    
+    int resultado = read(fd, bufferLectura + fin, espacio);
+    
+    if (resultado < 0) {
+        // Una señal interrumpe la lectura como un timeout: el llamador
+        // recupera el control y puede atender una petición de parada
+        return (errno == EAGAIN || errno == EINTR) ? 0 : -1;
+    }
+#endif
+    
+    Metricas::sumar(CONTADOR_LLAMADAS_LECTURA);
+    if (resultado > 0) {
+        ultimaLlegadaNs = relojNs();
+        pausaAvisada = false;
+        Metricas::sumar(CONTADOR_BYTES_LEIDOS, resultado);
+    } else {
+        Metricas::sumar(CONTADOR_LECTURAS_VACIAS);
+    }
     
-    while (indice < longitudMax - 1) {
-        if (!leerCaracter(c)) {
-            // Timeout o error
-            if (indice > 0) break;  // Si ya leímos algo, terminar la línea
-            continue;  // Si no, seguir esperando
+    fin += resultado;
+    return resultado;
+}
+
+#ifndef _WIN32
+bool SerialPort::esperarDatos() {
+    // Línea a medias o primer silencio: la espera de VTIME de siempre
+    int esperaMs = configuracion.vtime * 100;
+    if (configuracion.vmin > 0) {
+        esperaMs = -1;  // read() esperaría sin límite: solo la cancelación lo corta
+    } else if (fin == inicio && pausaAvisada) {
+        if (esperaMaximaMs <= 0) {
+            esperaMs = -1;
+        } else {
+            esperaMs = esperaMaximaMs;
+            if (ultimaLlegadaNs != 0) {
+                long long transcurridoMs = (relojNs() - ultimaLlegadaNs) / 1000000LL;
+                esperaMs = transcurridoMs >= esperaMaximaMs ? 0
+                         : esperaMaximaMs - static_cast<int>(transcurridoMs);
+            }
+        }
+    }
+    
+    struct pollfd vigilados[2];
+    vigilados[0].fd = fd;
+    vigilados[0].events = POLLIN;
+    vigilados[0].revents = 0;
+    vigilados[1].fd = descriptorCancelacion;
+    vigilados[1].events = POLLIN;
+    vigilados[1].revents = 0;
+    
+    int n = poll(vigilados, descriptorCancelacion >= 0 ? 2 : 1, esperaMs);
+    if (n <= 0) {
+        return false;  // Plazo vencido o señal (EINTR): como un timeout
+    }
+    if (vigilados[1].revents != 0) {
+        return false;  // Cancelación pedida
+    }
+    return true;  // Datos, o un error que read() va a informar
+}
+#endif
+
+bool SerialPort::extraerLineaCompleta(VistaLinea& linea) {
+    // Trama binaria: se delimita por su longitud, no por '\n'
+    if (inicio < fin && esTramaBinaria(static_cast<unsigned char>(bufferLectura[inicio]))) {
+        int longitud = static_cast<int>(longitudTramaBinaria(bufferLectura + inicio, fin - inicio));
+        if (longitud == 0) {
+            return false;  // Trama incompleta: esperar más bytes
         }
         
-        // Terminar en nueva línea
-        if (c == '\n') {
-            break;
+        linea.datos = bufferLectura + inicio;
+        linea.longitud = longitud;
+        linea.llegadaNs = ultimaLlegadaNs;
+        inicio += longitud;
+        inicioBusqueda = inicio;
+        return true;
+    }
+    
+    const char* salto = static_cast<const char*>(
+        memchr(bufferLectura + inicioBusqueda, '\n', fin - inicioBusqueda));
+    
+    if (!salto) {
+        // No hay '\n' todavía: la próxima búsqueda empieza donde quedó esta
+        inicioBusqueda = fin;
+        return false;
+    }
+    
+    int finLinea = static_cast<int>(salto - bufferLectura);
+    linea.datos = bufferLectura + inicio;
+    linea.longitud = finLinea - inicio;
+    linea.llegadaNs = ultimaLlegadaNs;
+    
+    // Eliminar el retorno de carro previo al salto de línea
+    if (linea.longitud > 0 && linea.datos[linea.longitud - 1] == '\r') {
+        linea.longitud--;
+    }
+    
+    inicio = finLinea + 1;
+    inicioBusqueda = inicio;
+    return true;
+}
+
+void SerialPort::extraerPendiente(VistaLinea& linea) {
+    linea.datos = bufferLectura + inicio;
+    linea.longitud = fin - inicio;
+    linea.llegadaNs = ultimaLlegadaNs;
+    
+    while (linea.longitud > 0 && linea.datos[linea.longitud - 1] == '\r') {
+        linea.longitud--;
+    }
+    
+    inicio = fin;
+    inicioBusqueda = fin;
+}
+
+int SerialPort::leerLineaVista(VistaLinea& linea) {
+    if (!conectado) return -1;
+    
+    while (true) {
+        if (extraerLineaCompleta(linea)) {
+            return linea.longitud;
         }
         
-        // Ignorar retornos de carro
-        if (c == '\r') {
+        // Línea más larga que el buffer: entregarla tal como está
+        if (inicio == 0 && fin == TAM_BUFFER_LECTURA) {
+            extraerPendiente(linea);
+            return linea.longitud;
+        }
+        
+        int leidos = rellenarBuffer();
+        if (leidos < 0) {
+            return -1;
+        }
+        
+        if (leidos > 0) {
             continue;
         }
         
-        buffer[indice++] = c;
+        if (fin > inicio && !noBloqueante) {
+            // Timeout con una línea a medias: terminar la línea
+            extraerPendiente(linea);
+            return linea.longitud;
+        }
+        
+        // Nada llegó a tiempo: devolver el control al llamador (que
+        // vacía su salida y atiende las peticiones de parada)
+        pausaAvisada = true;
+        linea.datos = bufferLectura + inicio;
+        linea.longitud = 0;
+        linea.llegadaNs = 0;
+        return 0;
+    }
+}
+
+int SerialPort::leerLineas(VistaLinea* lineas, int maxLineas) {
+    if (!conectado || maxLineas <= 0) return -1;
+    
+    int cantidad = 0;
+    while (cantidad < maxLineas && extraerLineaCompleta(lineas[cantidad])) {
+        cantidad++;
+    }
+    if (cantidad > 0) {
+        return cantidad;
+    }
+    
+    // Nada completo en el buffer: una sola lectura del puerto
+    int leidos = rellenarBuffer();
+    if (leidos < 0) {
+        return -1;
+    }
+    
+    while (cantidad < maxLineas && extraerLineaCompleta(lineas[cantidad])) {
+        cantidad++;
+    }
+    
+    if (cantidad == 0 && fin > inicio &&
+        ((leidos == 0 && !noBloqueante) || (inicio == 0 && fin == TAM_BUFFER_LECTURA))) {
+        // Timeout con una línea a medias, o línea más larga que el buffer
+        extraerPendiente(lineas[0]);
+        cantidad = 1;
+    }
+    
+    return cantidad;
+}
+
+int SerialPort::leerLinea(char* buffer, int longitudMax) {
+    if (!conectado || longitudMax <= 0) return -1;
+    
+    VistaLinea linea;
+    int longitud = leerLineaVista(linea);
+    if (longitud < 0) return -1;
+    
+    // Copiar sin los retornos de carro; lo que no quepa se devuelve al buffer
+    int indice = 0;
+    int i = 0;
+    for (; i < longitud && indice < longitudMax - 1; ++i) {
+        if (linea.datos[i] != '\r') {
+            buffer[indice++] = linea.datos[i];
+        }
+    }
+    if (i < longitud) {
+        inicio = static_cast<int>(linea.datos - bufferLectura) + i;
+        inicioBusqueda = inicio;
     }
     
     buffer[indice] = '\0';
@@ -159,16 +549,45 @@ int SerialPort::leerLinea(char* buffer, int longitudMax) {
 bool SerialPort::leerCaracter(char& c) {
     if (!conectado) return false;
     
+    if (inicio == fin && rellenarBuffer() <= 0) {
+        return false;
+    }
+    
+    c = bufferLectura[inicio++];
+    if (inicioBusqueda < inicio) {
+        inicioBusqueda = inicio;
+    }
+    return true;
+}
+
+bool SerialPort::establecerNoBloqueante(bool activar) {
+    if (!conectado) return false;
+    
 #ifdef _WIN32
-    DWORD bytesLeidos;
-    if (!ReadFile(hSerial, &c, 1, &bytesLeidos, nullptr)) {
+    // En Windows el equivalente es un timeout de lectura inmediato
+    COMMTIMEOUTS timeouts = {0};
+    if (!GetCommTimeouts(hSerial, &timeouts)) {
+        return false;
+    }
+    timeouts.ReadIntervalTimeout = activar ? MAXDWORD : 50;
+    timeouts.ReadTotalTimeoutConstant = activar ? 0 : 50;
+    timeouts.ReadTotalTimeoutMultiplier = activar ? 0 : 10;
+    if (!SetCommTimeouts(hSerial, &timeouts)) {
         return false;
     }
-    return bytesLeidos == 1;
 #else
-    int resultado = read(fd, &c, 1);
-    return resultado == 1;
+    int banderas = fcntl(fd, F_GETFL, 0);
+    if (banderas < 0) {
+        return false;
+    }
+    banderas = activar ? (banderas | O_NONBLOCK) : (banderas & ~O_NONBLOCK);
+    if (fcntl(fd, F_SETFL, banderas) < 0) {
+        return false;
+    }
 #endif
+    
+    noBloqueante = activar;
+    return true;
 }
 
 void SerialPort::cerrar() {
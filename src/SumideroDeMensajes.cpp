@@ -0,0 +1,115 @@
+/**
+ * @file SumideroDeMensajes.cpp
+ * @brief Implementación del sumidero de mensajes
+ */
+
+#include "SumideroDeMensajes.h"
+#include <cstring>
+#include <cerrno>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define fileno _fileno
+#else
+    #include <unistd.h>
+#endif
+
+SumideroDeMensajes::SumideroDeMensajes(const char* delimitadorFin, int ventanaCaracteres)
+    : destino(nullptr),
+      propio(false),
+      escritor(nullptr),
+      ventana(ventanaCaracteres > 0 ? ventanaCaracteres : 1),
+      mensajesCerrados(0),
+      caracteresEscritos(0) {
+    strncpy(delimitador, delimitadorFin, LONGITUD_MAX_DELIMITADOR);
+    delimitador[LONGITUD_MAX_DELIMITADOR] = '\0';
+}
+
+SumideroDeMensajes::~SumideroDeMensajes() {
+    delete escritor;  // Escribe lo pendiente
+    if (propio) {
+        fclose(destino);
+    }
+}
+
+bool SumideroDeMensajes::abrir(const char* ruta) {
+    if (strcmp(ruta, "-") == 0) {
+        destino = stdout;
+        propio = false;
+    } else {
+        // Se agrega al final: los mensajes de una ejecución anterior se conservan
+        destino = fopen(ruta, "ab");
+        if (!destino) {
+            fprintf(stderr, "Error: No se pudo abrir %s: %s\n", ruta, strerror(errno));
+            return false;
+        }
+        propio = true;
+    }
+    
+    escritor = new EscritorBuffer(destino);
+    return true;
+}
+
+void SumideroDeMensajes::volcar(const ListaDeCarga& carga, int desde) {
+    if (desde >= carga.obtenerTamanio()) return;
+    
+    caracteresEscritos += carga.obtenerTamanio() - desde;
+    if (!escritor) return;
+    
+    // Recorrer los nodos directamente: sin copias intermedias
+    int desplazamiento;
+    const NodoCarga* nodo = carga.buscarDesdeCola(desde, &desplazamiento);
+    for (; nodo; nodo = nodo->siguiente) {
+        escritor->escribir(nodo->datos + desplazamiento, nodo->cantidad - desplazamiento);
+        desplazamiento = 0;
+    }
+}
+
+void SumideroDeMensajes::cerrarMensaje(const ListaDeCarga& carga, int desde) {
+    volcar(carga, desde);
+    mensajesCerrados++;
+    
+    if (escritor) {
+        escritor->escribir("\n", 1);
+        escritor->vaciar();
+    }
+}
+
+void SumideroDeMensajes::vaciar() {
+    if (escritor) {
+        escritor->vaciar();
+    }
+}
+
+long long SumideroDeMensajes::obtenerPosicion() {
+    vaciar();
+    if (!propio) return -1;
+    
+    fseek(destino, 0, SEEK_END);
+    return static_cast<long long>(ftell(destino));
+}
+
+bool SumideroDeMensajes::recortar(long long posicion) {
+    if (!propio) return true;  // stdout no se puede recortar: lo repetido se vuelve a escribir
+    
+    vaciar();
+    fseek(destino, 0, SEEK_END);
+    long long tamanio = static_cast<long long>(ftell(destino));
+    if (tamanio < posicion) {
+        fprintf(stderr, "Error: El archivo de mensajes tiene %lld bytes y el punto de control espera %lld\n",
+                tamanio, posicion);
+        return false;
+    }
+    if (tamanio == posicion) return true;
+    
+    // El archivo se abrió en modo "ab": lo siguiente se escribe al nuevo final
+#ifdef _WIN32
+    bool recortado = _chsize_s(fileno(destino), posicion) == 0;
+#else
+    bool recortado = ftruncate(fileno(destino), static_cast<off_t>(posicion)) == 0;
+#endif
+    if (!recortado) {
+        fprintf(stderr, "Error: No se pudo recortar el archivo de mensajes: %s\n", strerror(errno));
+    }
+    return recortado;
+}
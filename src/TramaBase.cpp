@@ -4,6 +4,8 @@
  */
 
 #include "TramaBase.h"
+#include "RotorDeMapeo.h"
 
-// No hay implementación necesaria ya que TramaBase es completamente abstracta
-// Este archivo se incluye para mantener la estructura consistente del proyecto
+void TramaBase::ajustarRotor(RotorDeMapeo* rotor) const {
+    rotor->rotar(obtenerRotacion());
+}
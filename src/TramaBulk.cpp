@@ -0,0 +1,52 @@
+/**
+ * @file TramaBulk.cpp
+ * @brief Implementación de la clase TramaBulk
+ */
+
+#include "TramaBulk.h"
+#include <cstdio>  // Para snprintf
+
+namespace {
+
+/// Caracteres que se decodifican por cada llamada a mapearBloque()
+const int TAM_TRAMO_BULK = 256;
+
+} // namespace
+
+TramaBulk::TramaBulk(const char* texto, int n) : datos(texto), longitud(n) {
+    // El texto pertenece a la línea recibida; no se copia
+}
+
+TramaBulk::~TramaBulk() {
+    // No hay recursos dinámicos que liberar
+}
+
+void TramaBulk::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    char decodificados[TAM_TRAMO_BULK];
+    
+    // Decodificar por tramos con la rotación actual
+    for (int i = 0; i < longitud; i += TAM_TRAMO_BULK) {
+        int n = longitud - i < TAM_TRAMO_BULK ? longitud - i : TAM_TRAMO_BULK;
+        rotor->mapearBloque(datos + i, decodificados, n);
+        carga->insertarBloque(decodificados, n);
+    }
+}
+
+int TramaBulk::decodificarEn(const RotorDeMapeo* rotor, char* destino) const {
+    if (destino) {
+        rotor->mapearBloque(datos, destino, longitud);
+    }
+    return longitud;
+}
+
+const char* TramaBulk::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "B,%.*s", longitud, datos);
+    return buffer;
+}
+
+void TramaBulk::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)rotor; // Evitar warning de parámetro no utilizado
+    
+    printf("-> %d carácter(es) procesados. Mensaje parcial: ", longitud);
+    carga->imprimirMensaje();
+}
@@ -0,0 +1,32 @@
+/**
+ * @file TramaFin.cpp
+ * @brief Implementación de la clase TramaFin
+ */
+
+#include "TramaFin.h"
+#include <cstdio>  // Para snprintf
+
+TramaFin::TramaFin() {
+    // La trama no tiene datos propios
+}
+
+TramaFin::~TramaFin() {
+    // No hay recursos dinámicos que liberar
+}
+
+void TramaFin::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    (void)rotor;
+}
+
+const char* TramaFin::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "FIN");
+    return buffer;
+}
+
+void TramaFin::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    (void)rotor;
+    
+    printf("-> FIN DE MENSAJE\n");
+}
@@ -4,11 +4,11 @@
  */
 
 #include "TramaLoad.h"
-#include <cstdio>  // Para sprintf
+#include "LoteDeCarga.h"
+#include <cstdio>  // Para snprintf
 
 TramaLoad::TramaLoad(char c) : caracter(c) {
-    // Inicializar representación
-    representacion[0] = '\0';
+    // La representación en texto se formatea solo cuando se solicita
 }
 
 TramaLoad::~TramaLoad() {
@@ -23,10 +23,25 @@ void TramaLoad::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     carga->insertarAlFinal(decodificado);
 }
 
-const char* TramaLoad::obtenerRepresentacion() const {
-    // Usar const_cast para modificar el buffer mutable
-    // Esto es seguro porque no cambia el estado lógico del objeto
-    char* buffer = const_cast<char*>(representacion);
-    sprintf(buffer, "L,%c", caracter);
+const char* TramaLoad::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "L,%c", caracter);
     return buffer;
 }
+
+int TramaLoad::decodificarEn(const RotorDeMapeo* rotor, char* destino) const {
+    if (destino) {
+        *destino = rotor->getMapeo(caracter);
+    }
+    return 1;
+}
+
+bool TramaLoad::acumularEnLote(LoteDeCarga* lote) const {
+    return lote->agregar(caracter);
+}
+
+void TramaLoad::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)rotor; // Evitar warning de parámetro no utilizado
+    
+    printf("-> Carácter procesado. Mensaje parcial: ");
+    carga->imprimirMensaje();
+}
@@ -4,11 +4,10 @@
  */
 
 #include "TramaMap.h"
-#include <cstdio>  // Para sprintf
+#include <cstdio>  // Para snprintf
 
 TramaMap::TramaMap(int n) : rotacion(n) {
-    // Inicializar representación
-    representacion[0] = '\0';
+    // La representación en texto se formatea solo cuando se solicita
 }
 
 TramaMap::~TramaMap() {
@@ -23,9 +22,20 @@ void TramaMap::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
     rotor->rotar(rotacion);
 }
 
-const char* TramaMap::obtenerRepresentacion() const {
-    // Usar const_cast para modificar el buffer mutable
-    char* buffer = const_cast<char*>(representacion);
-    sprintf(buffer, "M,%d", rotacion);
+const char* TramaMap::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "M,%d", rotacion);
     return buffer;
 }
+
+void TramaMap::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    
+    if (rotor->esCascada()) {
+        printf("-> ROTANDO ROTOR %d %+d (posiciones:", rotor->obtenerRotorSeleccionado(), rotacion);
+        rotor->imprimirPosiciones();
+        printf(")\n");
+        return;
+    }
+    
+    printf("-> ROTANDO ROTOR %+d (cabeza ahora en '%c')\n", rotacion, rotor->obtenerCabeza());
+}
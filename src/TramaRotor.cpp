@@ -0,0 +1,38 @@
+/**
+ * @file TramaRotor.cpp
+ * @brief Implementación de la clase TramaRotor
+ */
+
+#include "TramaRotor.h"
+#include <cstdio>  // Para snprintf
+
+TramaRotor::TramaRotor(int i, int n) : indice(i), rotacion(n) {
+    // La representación en texto se formatea solo cuando se solicita
+}
+
+TramaRotor::~TramaRotor() {
+    // No hay recursos dinámicos que liberar
+}
+
+void TramaRotor::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    
+    ajustarRotor(rotor);
+}
+
+void TramaRotor::ajustarRotor(RotorDeMapeo* rotor) const {
+    rotor->rotarRotor(indice, rotacion);
+}
+
+const char* TramaRotor::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "R,%d,%d", indice, rotacion);
+    return buffer;
+}
+
+void TramaRotor::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    
+    printf("-> ROTANDO ROTOR %d %+d (posiciones:", indice, rotacion);
+    rotor->imprimirPosiciones();
+    printf(")\n");
+}
@@ -0,0 +1,42 @@
+/**
+ * @file TramaSeleccion.cpp
+ * @brief Implementación de la clase TramaSeleccion
+ */
+
+#include "TramaSeleccion.h"
+#include <cstdio>  // Para snprintf
+
+TramaSeleccion::TramaSeleccion(int i) : indice(i) {
+    // La representación en texto se formatea solo cuando se solicita
+}
+
+TramaSeleccion::~TramaSeleccion() {
+    // No hay recursos dinámicos que liberar
+}
+
+void TramaSeleccion::procesar(ListaDeCarga* carga, RotorDeMapeo* rotor) {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    
+    ajustarRotor(rotor);
+}
+
+void TramaSeleccion::ajustarRotor(RotorDeMapeo* rotor) const {
+    // Un índice que no existe en la cascada deja la selección como está
+    rotor->seleccionarRotor(indice);
+}
+
+const char* TramaSeleccion::obtenerRepresentacion(char* buffer, int tamBuffer) const {
+    snprintf(buffer, tamBuffer, "S,%d", indice);
+    return buffer;
+}
+
+void TramaSeleccion::imprimirResultado(const ListaDeCarga* carga, const RotorDeMapeo* rotor) const {
+    (void)carga; // Evitar warning de parámetro no utilizado
+    
+    if (rotor->obtenerRotorSeleccionado() == indice) {
+        printf("-> ROTOR %d SELECCIONADO\n", indice);
+    } else {
+        printf("-> ROTOR %d INEXISTENTE (la cascada tiene %d); sigue seleccionado el %d\n",
+               indice, rotor->obtenerNumeroRotores(), rotor->obtenerRotorSeleccionado());
+    }
+}
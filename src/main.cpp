@@ -10,53 +10,31 @@
 
 #include <cstdio>
 #include <cstring>
-#include <cstdlib>
-#include "TramaBase.h"
-#include "TramaLoad.h"
-#include "TramaMap.h"
+#include <csignal>
+#include <chrono>
 #include "ListaDeCarga.h"
 #include "RotorDeMapeo.h"
+#include "RegistroDeTramas.h"
+#include "ProcesadorDeTramas.h"
 #include "SerialPort.h"
+#include "FuenteReplay.h"
+#include "SalidaDeMensaje.h"
+#include "Opciones.h"
+#include "MultiplexorPuertos.h"
+#include "PipelineDecodificador.h"
+#include "DecodificadorParalelo.h"
+#include "LatenciasDeTramas.h"
+#include "ExportadorMetricas.h"
+#include "PuntoDeControl.h"
+#include "SumideroDeMensajes.h"
+#include "Bitacora.h"
+#include "ControlDeParada.h"
 
 /**
- * @brief Parsea una línea recibida y crea la trama correspondiente
- * @param linea Línea de texto recibida del puerto serial (ej. "L,A" o "M,5")
- * @return Puntero a TramaBase (TramaLoad o TramaMap), o nullptr si el formato es inválido
+ * @brief Manejador de SIGUSR1: pide un informe de latencias sin detener la decodificación
  */
-TramaBase* parsearTrama(const char* linea) {
-    if (!linea || strlen(linea) < 3) {
-        return nullptr;
-    }
-    
-    // El formato esperado es: "X,Y" donde X es el tipo (L o M) y Y es el dato
-    char tipo = linea[0];
-    
-    // Verificar que hay una coma
-    if (linea[1] != ',') {
-        printf("Advertencia: Formato inválido (falta coma): %s\n", linea);
-        return nullptr;
-    }
-    
-    // Obtener el dato después de la coma
-    const char* dato = linea + 2;
-    
-    if (tipo == 'L' || tipo == 'l') {
-        // Trama LOAD: L,X donde X es un carácter
-        if (strlen(dato) < 1) {
-            printf("Advertencia: Trama LOAD sin carácter\n");
-            return nullptr;
-        }
-        return new TramaLoad(dato[0]);
-    } 
-    else if (tipo == 'M' || tipo == 'm') {
-        // Trama MAP: M,N donde N es un número entero
-        int rotacion = atoi(dato);
-        return new TramaMap(rotacion);
-    }
-    else {
-        printf("Advertencia: Tipo de trama desconocido: %c\n", tipo);
-        return nullptr;
-    }
+void manejarInformeLatencias(int) {
+    LatenciasDeTramas::solicitarInforme();
 }
 
 /**
@@ -104,114 +82,348 @@ void solicitarPuerto(char* buffer, int tamBuffer) {
 }
 
 /**
- * @brief Procesa el flujo de tramas desde el puerto serial
- * @param puerto Puntero al objeto SerialPort
+ * @brief Arranca el exportador de métricas si se pidió con --metricas
+ * @param opciones Opciones de la línea de comandos
+ * @return Exportador en marcha (el llamador lo libera), o nullptr
+ */
+ExportadorMetricas* iniciarMetricas(const OpcionesDecodificador& opciones) {
+    if (!opciones.metricas) return nullptr;
+    
+    ExportadorMetricas* exportador = new ExportadorMetricas(opciones.metricas, opciones.intervaloMetricas);
+    if (!exportador->iniciar()) {
+        delete exportador;
+        return nullptr;
+    }
+    return exportador;
+}
+
+/**
+ * @brief Arranca la bitácora si se pidió con --bitacora
+ * @param opciones Opciones de la línea de comandos
+ * @param bitacora Variable donde se devuelve la bitácora en marcha (el
+ *        llamador la libera), o nullptr si está apagada
+ * @return false si no se pudo abrir el archivo de la bitácora
+ */
+bool iniciarBitacora(const OpcionesDecodificador& opciones, Bitacora** bitacora) {
+    *bitacora = nullptr;
+    if (opciones.bitacora == BITACORA_APAGADA) return true;
+    
+    Bitacora* nueva = new Bitacora(opciones.bitacora);
+    if (!nueva->iniciar(opciones.archivoBitacora)) {
+        delete nueva;
+        return false;
+    }
+    *bitacora = nueva;
+    return true;
+}
+
+/**
+ * @brief Procesa el flujo de tramas desde el puerto serial o una captura
+ * @param fuente Origen de las líneas (SerialPort o FuenteReplay)
  * @param carga Puntero a la lista de carga
  * @param rotor Puntero al rotor de mapeo
+ * @param salida Modo de salida mientras llegan las tramas
+ * @param latencias Histogramas de latencia (nullptr = no medir)
+ * @param punto Diario y puntos de control (nullptr = sin guardar)
+ * @param sumidero Destino de los mensajes cerrados por FIN (nullptr = un solo mensaje)
+ * @param bitacora Bitácora de tramas y eventos (nullptr = sin bitácora)
+ * @param inactividadMs Milisegundos sin tramas tras los que se termina (0 = sin límite)
+ * @param desatendido Avisar la parada en stderr, fuera del flujo del mensaje
  * @return Número de tramas procesadas
  */
-int procesarFlujo(SerialPort* puerto, ListaDeCarga* carga, RotorDeMapeo* rotor) {
-    const int BUFFER_SIZE = 256;
-    char buffer[BUFFER_SIZE];
-    int tramasProcesadas = 0;
-    int lineasVacias = 0;
-    const int MAX_LINEAS_VACIAS = 10;  // Timeout después de 10 líneas vacías consecutivas
+int procesarFlujo(FuenteDeLineas* fuente, ListaDeCarga* carga, RotorDeMapeo* rotor,
+                  SalidaDeMensaje* salida, LatenciasDeTramas* latencias, PuntoDeControl* punto,
+                  SumideroDeMensajes* sumidero, Bitacora* bitacora, int inactividadMs,
+                  bool desatendido) {
+    VistaLinea linea;                  // Línea actual (vista dentro del buffer del puerto)
+    FILE* avisos = desatendido ? stderr : stdout;
+    PlazoDeInactividad plazo(inactividadMs);
+    RegistroDeTramas registro;         // Fábricas de tramas por byte de tipo
+    bool detallado = salida->esDetallada();
+    registro.establecerAdvertencias(detallado);
+    ProcesadorDeTramas procesador(carga, rotor, &registro, detallado);
+    procesador.establecerLatencias(latencias);
+    procesador.establecerPuntoDeControl(punto);
+    procesador.establecerBitacora(bitacora);
+    if (sumidero) {
+        registro.establecerDelimitador(sumidero->obtenerDelimitador());
+        procesador.establecerSumidero(sumidero);
+    }
     
-    printf("\nEsperando tramas del Arduino...\n");
-    printf("(Presione Ctrl+C para detener si es necesario)\n\n");
+    if (detallado) {
+        printf("\nEsperando tramas del Arduino...\n");
+        printf("(Presione Ctrl+C para detener si es necesario)\n\n");
+    }
     
     while (true) {
-        int bytesLeidos = puerto->leerLinea(buffer, BUFFER_SIZE);
+        if (ControlDeParada::solicitada()) {
+            fprintf(avisos, "\nSeñal %d recibida. Finalizando...\n", ControlDeParada::obtenerSenal());
+            break;
+        }
+        
+        int bytesLeidos = fuente->leerLineaVista(linea);
         
         if (bytesLeidos < 0) {
-            printf("Error al leer del puerto serial\n");
+            if (!fuente->finDeFlujo()) {
+                printf("Error al leer del puerto serial\n");
+            }
             break;
         }
         
         if (bytesLeidos == 0) {
-            lineasVacias++;
-            if (lineasVacias >= MAX_LINEAS_VACIAS) {
-                printf("\nNo se reciben más datos. Finalizando...\n");
+            procesador.vaciarPendientes();
+            salida->pausa(procesador.obtenerTramasProcesadas());
+            procesador.salidaEmitida();
+            if (punto) {
+                punto->escribirPendientes();
+            }
+            if (sumidero) {
+                sumidero->vaciar();
+            }
+            procesador.anotarPausa();
+            if (plazo.vencido()) {
+                fprintf(avisos, "\nNo se reciben más datos. Finalizando...\n");
                 break;
             }
             continue;
         }
         
-        lineasVacias = 0;  // Resetear contador de líneas vacías
+        plazo.datos(linea.llegadaNs);
         
-        // Parsear la trama
-        TramaBase* trama = parsearTrama(buffer);
+        procesador.procesarLinea(linea.datos, linea.longitud, linea.llegadaNs);
+        salida->tramaProcesada(procesador.obtenerTramasProcesadas());
+        procesador.salidaEmitida();
+    }
+    
+    // Decodificar lo que haya quedado pendiente al terminar el flujo
+    procesador.vaciarPendientes();
+    salida->finalizar(procesador.obtenerTramasProcesadas());
+    procesador.salidaEmitida();
+    procesador.anotarFinDeFlujo();
+    
+    return procesador.obtenerTramasProcesadas();
+}
+
+/**
+ * @brief Función principal del programa
+ * @param argc Número de argumentos
+ * @param argv Argumentos (ver imprimirAyuda())
+ */
+int main(int argc, char* argv[]) {
+    OpcionesDecodificador opciones;
+    ResultadoOpciones resultado = parsearOpciones(argc, argv, &opciones);
+    if (resultado != OPCIONES_OK) {
+        imprimirAyuda(argv[0]);
+        return resultado == OPCIONES_AYUDA ? 0 : 1;
+    }
+    
+    // Validar la cascada una sola vez, antes de crear los rotores
+    if (opciones.rotores) {
+        RotorDeMapeo prueba(opciones.alfabeto);
+        if (!prueba.configurarCascada(opciones.rotores)) {
+            return 1;
+        }
+    }
+    
+    if (opciones.captura) {
+        // Modo fuera de línea: el mensaje puede ir a stdout, así que el
+        // resumen se imprime en stderr y se omite el banner
+        ArchivoMapeado captura;
+        if (!captura.abrir(opciones.captura)) {
+            return 1;
+        }
         
-        if (!trama) {
-            printf("Trama inválida: [%s]\n", buffer);
-            continue;
+        DecodificadorParalelo decodificador(opciones.hilos, opciones.alfabeto, opciones.rotores);
+        bool completo = decodificador.decodificar(captura, opciones.destino);
+        decodificador.imprimirResumen(stderr);
+        return completo ? 0 : 1;
+    }
+    
+    if (!opciones.desatendido) {
+        imprimirBanner();
+    }
+    
+    if (opciones.puertos) {
+        // Modo multipuerto: un rotor y una lista de carga por puerto
+        MultiplexorPuertos multiplexor(opciones.puertos, opciones.alfabeto, opciones.rotores);
+        
+        int abiertos = multiplexor.abrir(opciones.serial);
+        if (abiertos == 0) {
+            printf("\nError: No se pudo abrir ningún puerto de la lista %s\n", opciones.puertos);
+            return 1;
         }
         
-        // Mostrar información de la trama
-        printf("Trama recibida: [%s] -> Procesando... ", trama->obtenerRepresentacion());
+        Bitacora* bitacora;
+        if (!iniciarBitacora(opciones, &bitacora)) {
+            return 1;
+        }
+        multiplexor.establecerBitacora(bitacora);
+        multiplexor.establecerDesatendido(opciones.desatendido);
         
-        // Procesar la trama
-        trama->procesar(carga, rotor);
-        tramasProcesadas++;
+        if (!opciones.desatendido) {
+            printf("%d puerto(s) abiertos. Esperando tramas...\n", abiertos);
+        }
+        ExportadorMetricas* exportador = iniciarMetricas(opciones);
+        ControlDeParada::instalar();
+        multiplexor.ejecutar(opciones.inactividad);
+        delete exportador;  // Última escritura con los totales
+        delete bitacora;    // Escribe lo pendiente antes del resumen
+        multiplexor.imprimirResumen();
+        return 0;
+    }
+    
+    // Origen de las tramas: captura grabada o puerto serial
+    FuenteReplay replay;
+    SerialPort* puerto = nullptr;
+    FuenteDeLineas* fuente;
+    
+    if (opciones.reproduccion) {
+        if (!replay.abrir(opciones.reproduccion)) {
+            return 1;
+        }
+        if (!opciones.desatendido) {
+            printf("Reproduciendo captura: %s (%llu bytes)\n", opciones.reproduccion,
+                   static_cast<unsigned long long>(replay.obtenerTamanio()));
+        }
+        fuente = &replay;
+    } else {
+        // Puerto de la línea de comandos, o preguntado al usuario
+        char nombrePuerto[100];
+        if (opciones.puerto) {
+            snprintf(nombrePuerto, sizeof(nombrePuerto), "%s", opciones.puerto);
+        } else {
+            imprimirInstrucciones();
+            solicitarPuerto(nombrePuerto, sizeof(nombrePuerto));
+        }
+        
+        if (!opciones.desatendido) {
+            printf("\nIniciando Decodificador PRT-7...\n");
+            printf("Conectando a puerto: %s (%d baud, %d%c%d)\n", nombrePuerto,
+                   opciones.serial.baudios, opciones.serial.bitsDatos,
+                   opciones.serial.paridad, opciones.serial.bitsParada);
+        }
         
-        // Mostrar información adicional según el tipo
-        TramaLoad* tramaLoad = dynamic_cast<TramaLoad*>(trama);
-        TramaMap* tramaMap = dynamic_cast<TramaMap*>(trama);
+        // Abrir puerto serial
+        puerto = new SerialPort(nombrePuerto, opciones.serial);
         
-        if (tramaLoad) {
-            printf("-> Carácter procesado. Mensaje parcial: ");
-            carga->imprimirMensaje();
-        } 
-        else if (tramaMap) {
-            int rot = tramaMap->obtenerRotacion();
-            printf("-> ROTANDO ROTOR %+d (cabeza ahora en '%c')\n", rot, rotor->obtenerCabeza());
+        if (!puerto->estaConectado()) {
+            printf("\nError: No se pudo conectar al puerto %s\n", nombrePuerto);
+            printf("Verifique que:\n");
+            printf("  - El Arduino está conectado\n");
+            printf("  - El puerto es correcto\n");
+            printf("  - Tiene permisos para acceder al puerto\n");
+            delete puerto;
+            return 1;
         }
         
-        // Liberar memoria de la trama
-        delete trama;
+        if (!opciones.desatendido) {
+            printf("Conexión establecida exitosamente.\n");
+        }
+        fuente = puerto;
     }
     
-    return tramasProcesadas;
-}
-
-/**
- * @brief Función principal del programa
- */
-int main() {
-    imprimirBanner();
-    imprimirInstrucciones();
-    
-    // Solicitar puerto serial
-    char nombrePuerto[100];
-    solicitarPuerto(nombrePuerto, sizeof(nombrePuerto));
-    
-    printf("\nIniciando Decodificador PRT-7...\n");
-    printf("Conectando a puerto: %s\n", nombrePuerto);
-    
-    // Abrir puerto serial
-    SerialPort puerto(nombrePuerto);
-    
-    if (!puerto.estaConectado()) {
-        printf("\nError: No se pudo conectar al puerto %s\n", nombrePuerto);
-        printf("Verifique que:\n");
-        printf("  - El Arduino está conectado\n");
-        printf("  - El puerto es correcto\n");
-        printf("  - Tiene permisos para acceder al puerto\n");
-        return 1;
+    // Inicializar estructuras de datos
+    ListaDeCarga carga;
+    RotorDeMapeo rotor(opciones.alfabeto);
+    if (opciones.rotores) {
+        rotor.configurarCascada(opciones.rotores);
     }
     
-    printf("Conexión establecida exitosamente.\n");
+    if (!opciones.desatendido) {
+        printf("\nEstructuras inicializadas:\n");
+        printf("  - Lista de Carga: vacía\n");
+        printf("  - Rotor de Mapeo: posición inicial (A-Z, cabeza en 'A')\n");
+        if (rotor.esCascada()) {
+            printf("  - Cascada de %d rotor(es), todos en la posición 0\n", rotor.obtenerNumeroRotores());
+        }
+    }
     
-    // Inicializar estructuras de datos
-    ListaDeCarga carga;
-    RotorDeMapeo rotor;
+    // Mensajes separados por tramas FIN
+    SumideroDeMensajes* sumidero = nullptr;
+    if (opciones.mensajes) {
+        sumidero = new SumideroDeMensajes(opciones.delimitador, opciones.ventana);
+        if (!sumidero->abrir(opciones.mensajes)) {
+            delete sumidero;
+            delete puerto;
+            return 1;
+        }
+        if (!opciones.desatendido) {
+            printf("  - Mensajes terminados en \"%s\" a %s (ventana de %d caracteres)\n",
+                   opciones.delimitador, opciones.mensajes, opciones.ventana);
+        }
+    }
     
-    printf("\nEstructuras inicializadas:\n");
-    printf("  - Lista de Carga: vacía\n");
-    printf("  - Rotor de Mapeo: posición inicial (A-Z, cabeza en 'A')\n");
+    // Reanudar desde el último punto de control y el diario
+    PuntoDeControl* punto = nullptr;
+    if (opciones.estado) {
+        punto = new PuntoDeControl(opciones.estado, opciones.alfabeto, opciones.rotores,
+                                   opciones.sincronizacion, opciones.loteDiario, opciones.tramasPorPunto);
+        punto->establecerSegmentacion(sumidero);
+        if (!punto->recuperar(&carga, &rotor)) {
+            delete punto;
+            delete sumidero;
+            delete puerto;
+            return 1;
+        }
+    }
     
-    // Procesar el flujo de tramas
-    int tramasProcesadas = procesarFlujo(&puerto, &carga, &rotor);
+    // Histogramas de latencia (grandes: en el heap)
+    LatenciasDeTramas* latencias = nullptr;
+    if (opciones.latencias) {
+        latencias = new LatenciasDeTramas();
+#ifdef SIGUSR1
+        signal(SIGUSR1, manejarInformeLatencias);
+#endif
+    }
+    
+    // Bitácora: después de recuperar, para no anotar las tramas del diario
+    Bitacora* bitacora;
+    if (!iniciarBitacora(opciones, &bitacora)) {
+        delete latencias;
+        delete punto;
+        delete sumidero;
+        delete puerto;
+        return 1;
+    }
+    
+    ExportadorMetricas* exportador = iniciarMetricas(opciones);
+    
+    // Desde aquí SIGTERM y SIGINT terminan en orden (antes, la acción por defecto)
+    ControlDeParada::instalar();
+    if (puerto) {
+        // Dormir en poll() sin límite de VTIME; la parada despierta la espera
+        puerto->establecerEsperaMaxima(opciones.inactividad);
+        puerto->establecerCancelacion(ControlDeParada::obtenerDescriptorAviso());
+    }
+    
+    // Procesar el flujo de tramas (en el hilo principal o en el pipeline)
+    std::chrono::steady_clock::time_point inicio = std::chrono::steady_clock::now();
+    PipelineDecodificador* pipeline = nullptr;
+    int tramasProcesadas;
+    if (opciones.pipeline) {
+        pipeline = new PipelineDecodificador(fuente, &carga, &rotor,
+                                             opciones.capacidadCola, opciones.desborde);
+        pipeline->establecerLatencias(latencias);
+        pipeline->establecerPuntoDeControl(punto);
+        pipeline->establecerSumidero(sumidero);
+        pipeline->establecerBitacora(bitacora);
+        pipeline->establecerInactividad(opciones.inactividad);
+        pipeline->establecerDesatendido(opciones.desatendido);
+        tramasProcesadas = pipeline->ejecutar();
+    } else {
+        // Por defecto el puerto imprime cada trama; la reproducción y el modo desatendido, nada
+        ModoSalida modo = opciones.salidaIndicada ? opciones.salida
+                        : (puerto && !opciones.desatendido ? SALIDA_DETALLADA : SALIDA_SILENCIOSA);
+        SalidaDeMensaje salida(&carga, modo, opciones.intervaloProgreso);
+        tramasProcesadas = procesarFlujo(fuente, &carga, &rotor, &salida, latencias, punto, sumidero,
+                                         bitacora, opciones.inactividad, opciones.desatendido);
+    }
+    if (punto) {
+        punto->guardar(carga, rotor);
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    delete exportador;  // Última escritura con los totales
+    delete bitacora;    // Escribe lo pendiente antes de los resultados
     
     // Mostrar resultados
     printf("\n");
@@ -221,10 +433,37 @@ int main() {
     printf("\n");
     printf("Estadísticas:\n");
     printf("  - Tramas procesadas: %d\n", tramasProcesadas);
-    printf("  - Caracteres decodificados: %d\n", carga.obtenerTamanio());
+    printf("  - Caracteres decodificados: %lld\n", carga.obtenerDescartados() + carga.obtenerTamanio());
+    if (sumidero) {
+        printf("  - Mensajes cerrados en %s: %lld (%lld caracteres escritos)\n",
+               opciones.mensajes, sumidero->obtenerMensajesCerrados(), sumidero->obtenerCaracteresEscritos());
+        delete sumidero;
+    }
+    if (punto) {
+        printf("  - Tramas en el punto de control %s: %lld\n", opciones.estado, punto->obtenerTramasGuardadas());
+        delete punto;
+    }
+    if (pipeline) {
+        pipeline->imprimirEstadisticas();
+        delete pipeline;
+    }
+    if (!puerto && segundos > 0.0) {
+        printf("  - Tiempo de reproducción: %.3f s (%.2f GB/s)\n", segundos,
+               replay.obtenerTamanio() / segundos / 1e9);
+    }
+    if (latencias) {
+        printf("\n");
+        latencias->imprimir(stdout);
+        delete latencias;
+    }
     printf("\n");
     printf("---------------------------------------------------\n");
-    printf("MENSAJE OCULTO ENSAMBLADO:\n");
+    if (opciones.mensajes) {
+        // Lo ya escrito en el archivo de mensajes no sigue en la lista
+        printf("MENSAJE OCULTO ABIERTO (SIN FIN, NO ESCRITO AÚN):\n");
+    } else {
+        printf("MENSAJE OCULTO ENSAMBLADO:\n");
+    }
     printf("---------------------------------------------------\n");
     
     if (carga.estaVacia()) {
@@ -237,8 +476,11 @@ int main() {
     printf("\n");
     
     // Cerrar puerto
-    puerto.cerrar();
-    printf("Puerto serial cerrado.\n");
+    if (puerto) {
+        puerto->cerrar();
+        delete puerto;
+        printf("Puerto serial cerrado.\n");
+    }
     printf("Sistema apagado correctamente.\n");
     printf("\n");
     